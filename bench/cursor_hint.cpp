@@ -0,0 +1,144 @@
+/*
+ * Copyright 2019-2025 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file cursor_hint.cpp
+ * @brief point operations on clustered keys with and without a cursor hint.
+ * @details Each batch accesses @a cluster consecutive keys from a random position, which
+ * is the access pattern of a clustered ingest.
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// yakushima
+#include "kvs.h"
+
+// yakushima/bench/include
+#include "random.h"
+
+#include "gflags/gflags.h"
+#include "glog/logging.h"
+
+using namespace yakushima;
+
+DEFINE_uint64(duration, 3, "Duration of each measurement in seconds."); // NOLINT
+DEFINE_uint64(record, 1000000, "# key-values in the storage.");         // NOLINT
+DEFINE_uint64(cluster, 64, "# consecutive keys of a batch.");           // NOLINT
+DEFINE_uint64(key_length, 8, "Key length, at least 8.");               // NOLINT
+
+static void check_flags() {
+    std::cout << "parameter settings\n"
+              << "duration :\t\t" << FLAGS_duration << "\n"
+              << "record :\t\t" << FLAGS_record << "\n"
+              << "cluster :\t\t" << FLAGS_cluster << "\n"
+              << "key_length :\t\t" << FLAGS_key_length << "\n"
+              << std::endl; // NOLINT(*-avoid-endl)
+
+    if (FLAGS_duration == 0) {
+        LOG(FATAL) << "Duration of benchmark in seconds must be larger than 0.";
+    }
+    if (FLAGS_record == 0 || FLAGS_cluster == 0 ||
+        FLAGS_cluster > FLAGS_record) {
+        LOG(FATAL) << "cluster must be in [1, record].";
+    }
+    if (FLAGS_key_length < sizeof(std::uint64_t)) {
+        LOG(FATAL) << "key_length must be at least 8.";
+    }
+}
+
+/**
+ * @brief The number is at the tail, so that long keys share the upper layers.
+ */
+static std::string make_key(std::uint64_t i) {
+    std::string key(FLAGS_key_length, 'k');
+    for (std::size_t j = 0; j < sizeof(i); ++j) {
+        key[FLAGS_key_length - 1 - j] = static_cast<char>((i >> (j * 8)) & 0xff); // NOLINT
+    }
+    return key;
+}
+
+template<class Op>
+static double measure(Op&& op) {
+    Xoroshiro128Plus rnd{};
+    std::size_t ops{0};
+    auto start = std::chrono::steady_clock::now();
+    auto end = start + std::chrono::seconds(FLAGS_duration);
+    while (std::chrono::steady_clock::now() < end) {
+        std::uint64_t first = rnd.next() % (FLAGS_record - FLAGS_cluster + 1);
+        for (std::uint64_t i = first; i < first + FLAGS_cluster; ++i) {
+            op(make_key(i));
+        }
+        ops += FLAGS_cluster;
+    }
+    std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+    return static_cast<double>(ops) / elapsed.count();
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "start cursor hint bench." << std::endl; // NOLINT(*-avoid-endl)
+    gflags::SetUsageMessage(static_cast<const std::string&>(
+            "micro-benchmark for cursor hint"));
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+    check_flags();
+
+    init();
+    std::string storage_name{"cursor_hint"};
+    create_storage(storage_name);
+    Token token{};
+    while (enter(token) != status::OK) { _mm_pause(); }
+    std::uint64_t value{0};
+    {
+        cursor_hint hint{};
+        for (std::uint64_t i = 0; i < FLAGS_record; ++i) {
+            put(token, hint, storage_name, make_key(i), &value);
+        }
+    }
+
+    std::pair<std::uint64_t*, std::size_t> out{};
+    double get_root = measure([&](const std::string& key) {
+        if (get<std::uint64_t>(storage_name, key, out) != status::OK) {
+            LOG(FATAL) << "fatal error";
+        }
+    });
+    cursor_hint hint{};
+    double get_hint = measure([&](const std::string& key) {
+        if (get<std::uint64_t>(token, hint, storage_name, key, out) !=
+            status::OK) {
+            LOG(FATAL) << "fatal error";
+        }
+    });
+    double put_root = measure([&](const std::string& key) {
+        put(token, storage_name, key, &value);
+    });
+    double put_hint = measure([&](const std::string& key) {
+        put(token, hint, storage_name, key, &value);
+    });
+    leave(token);
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "op\troot[ops/s]\thint[ops/s]\tspeedup\n"
+              << "get\t" << get_root << "\t" << get_hint << "\t"
+              << get_hint / get_root << "\n"
+              << "put\t" << put_root << "\t" << put_hint << "\t"
+              << put_hint / put_root << "\n";
+
+    fin();
+    return 0;
+}
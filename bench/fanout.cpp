@@ -0,0 +1,139 @@
+/*
+ * Copyright 2019-2025 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file fanout.cpp
+ * @brief throughput and memory of the node widths which this program is built with.
+ * @details bench/CMakeLists.txt builds it once for each width pair of
+ * YAKUSHIMA_BENCH_FANOUTS, so that the outputs can be compared.
+ */
+
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// yakushima
+#include "kvs.h"
+
+// yakushima/bench/include
+#include "random.h"
+
+#include "gflags/gflags.h"
+#include "glog/logging.h"
+
+using namespace yakushima;
+
+DEFINE_uint64(duration, 3, "Duration of get benchmark in seconds."); // NOLINT
+DEFINE_uint64(record, 1000000, "# key-values in the storage.");      // NOLINT
+
+static void check_flags() {
+    std::cout << "parameter settings\n"
+              << "duration :\t\t" << FLAGS_duration << "\n"
+              << "record :\t\t" << FLAGS_record << "\n"
+              << "border width :\t\t" << key_slice_length << "\n"
+              << "interior width :\t" << interior_key_slice_length << "\n"
+              << std::endl; // NOLINT(*-avoid-endl)
+
+    if (FLAGS_duration == 0) {
+        LOG(FATAL) << "Duration of benchmark in seconds must be larger than 0.";
+    }
+    if (FLAGS_record == 0) {
+        LOG(FATAL) << "It can't execute get bench against 0 size table.";
+    }
+}
+
+static std::string make_key(std::uint64_t i) {
+    // native byte order spreads sequential numbers over the key space.
+    std::string key(sizeof(i), '\0');
+    memcpy(key.data(), &i, sizeof(i));
+    return key;
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "start fanout bench." << std::endl; // NOLINT(*-avoid-endl)
+    gflags::SetUsageMessage(static_cast<const std::string&>(
+            "micro-benchmark for node widths"));
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+    check_flags();
+
+    init();
+    std::string storage_name{"fanout"};
+    create_storage(storage_name);
+    Token token{};
+    while (enter(token) != status::OK) { _mm_pause(); }
+
+    // put
+    std::uint64_t value{0};
+    auto start = std::chrono::steady_clock::now();
+    for (std::uint64_t i = 0; i < FLAGS_record; ++i) {
+        put(token, storage_name, make_key(i), &value, sizeof(value));
+    }
+    std::chrono::duration<double> put_time =
+            std::chrono::steady_clock::now() - start;
+
+    // get
+    Xoroshiro128Plus rnd{};
+    std::size_t gets{0};
+    std::size_t found{0};
+    start = std::chrono::steady_clock::now();
+    auto end = start + std::chrono::seconds(FLAGS_duration);
+    while (std::chrono::steady_clock::now() < end) {
+        for (std::size_t i = 0; i < 1024; ++i) { // NOLINT
+            std::pair<std::uint64_t*, std::size_t> out{};
+            if (get<std::uint64_t>(storage_name,
+                                   make_key(rnd.next() % FLAGS_record),
+                                   out) == status::OK) {
+                ++found;
+            }
+        }
+        gets += 1024; // NOLINT
+    }
+    std::chrono::duration<double> get_time =
+            std::chrono::steady_clock::now() - start;
+    leave(token);
+
+    // memory
+    std::size_t nodes{0};
+    std::size_t used{0};
+    std::size_t reserved{0};
+    auto mem_stat = mem_usage(storage_name);
+    for (auto&& [level_nodes, level_used, level_reserved] : mem_stat) {
+        nodes += level_nodes;
+        used += level_used;
+        reserved += level_reserved;
+    }
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "put throughput[ops/s]: "
+              << static_cast<double>(FLAGS_record) / put_time.count() << "\n"
+              << "get throughput[ops/s]: "
+              << static_cast<double>(gets) / get_time.count() << "\n"
+              << "get hit ratio: "
+              << static_cast<double>(found) / static_cast<double>(gets) << "\n"
+              << "tree height: " << mem_stat.size() << "\n"
+              << "nodes: " << nodes << "\n"
+              << "reserved[bytes/key]: "
+              << static_cast<double>(reserved) / static_cast<double>(FLAGS_record)
+              << "\n"
+              << "used[bytes/key]: "
+              << static_cast<double>(used) / static_cast<double>(FLAGS_record)
+              << std::endl; // NOLINT(*-avoid-endl)
+
+    fin();
+    return 0;
+}
@@ -0,0 +1,189 @@
+/*
+ * Copyright 2019-2025 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file interior_search.cpp
+ * @brief micro-benchmark of child selection in interior nodes.
+ * @details It builds complete trees of interior nodes for each height and descends them
+ * with random keys, comparing interior_node::get_child_of with the linear scan which it
+ * used before.
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+// yakushima/include
+#include "border_node.h"
+#include "interior_node.h"
+
+// yakushima/bench/include
+#include "random.h"
+
+#include "gflags/gflags.h"
+#include "glog/logging.h"
+
+using namespace yakushima;
+
+DEFINE_uint64(duration, 1, "Duration of each measurement in seconds."); // NOLINT
+DEFINE_uint64(max_height, 4, "Max number of interior levels.");           // NOLINT
+
+static void check_flags() {
+    std::cout << "parameter settings\n"
+              << "duration :\t\t" << FLAGS_duration << "\n"
+              << "max_height :\t\t" << FLAGS_max_height << "\n"
+              << std::endl; // NOLINT(*-avoid-endl)
+
+    if (FLAGS_duration == 0) {
+        std::cerr << "Duration of benchmark in seconds must be larger than 0."
+                  << std::endl; // NOLINT(*-avoid-endl)
+        exit(1);
+    }
+    if (FLAGS_max_height == 0 || FLAGS_max_height > 5) {
+        std::cerr << "max_height must be in [1, 5]." << std::endl; // NOLINT(*-avoid-endl)
+        exit(1);
+    }
+}
+
+/**
+ * @brief the linear scan which interior_node::get_child_of used before.
+ */
+static base_node* linear_get_child_of(interior_node* n,
+                                      const key_slice_type key_slice,
+                                      const key_length_type key_length,
+                                      node_version64_body& v) {
+    base_node* ret_child{};
+    for (;;) {
+        auto n_key = n->get_n_keys();
+        ret_child = nullptr;
+        for (auto i = 0; i < n_key; ++i) {
+            key_slice_type target_key_slice = n->get_key_slice_at(i);
+            if (key_slice < target_key_slice ||
+                (key_slice == target_key_slice &&
+                 key_length < n->get_key_length_at(i))) {
+                ret_child = n->get_child_at(i);
+                break;
+            }
+        }
+        if (ret_child == nullptr) {
+            ret_child = n->get_child_at(n_key);
+            if (ret_child == nullptr) { break; }
+        }
+        node_version64_body child_v = ret_child->get_stable_version();
+        node_version64_body check_v = n->get_stable_version();
+        if (v == check_v && !child_v.get_deleted()) {
+            v = child_v;
+            break;
+        }
+        if (v.get_vsplit() != check_v.get_vsplit() || check_v.get_deleted()) {
+            ret_child = nullptr;
+            break;
+        }
+        v = check_v;
+    }
+    return ret_child;
+}
+
+class complete_tree {
+public:
+    explicit complete_tree(std::size_t height) {
+        root_ = build(height, 0, ~0UL);
+    }
+
+    [[nodiscard]] base_node* get_root() const { return root_; }
+
+private:
+    /**
+     * @brief It builds a subtree which covers [lo, hi].
+     */
+    base_node* build(std::size_t height, key_slice_type lo, key_slice_type hi) {
+        if (height == 0) {
+            borders_.emplace_back(std::make_unique<border_node>());
+            borders_.back()->init_border();
+            return borders_.back().get();
+        }
+        interiors_.emplace_back(std::make_unique<interior_node>());
+        interior_node* n = interiors_.back().get();
+        n->init_interior();
+        key_slice_type width = (hi - lo) / interior_node::child_length;
+        for (std::size_t i = 0; i < interior_node::child_length; ++i) {
+            key_slice_type c_lo = lo + width * i;
+            key_slice_type c_hi =
+                    i + 1 == interior_node::child_length ? hi : c_lo + width - 1;
+            if (i != 0) { n->set_key(i - 1, c_lo, sizeof(key_slice_type)); }
+            base_node* child = build(height - 1, c_lo, c_hi);
+            child->set_parent(n);
+            n->set_child_at(i, child);
+        }
+        n->set_n_keys(interior_key_slice_length);
+        return n;
+    }
+
+    base_node* root_{};
+    std::vector<std::unique_ptr<border_node>> borders_{};
+    std::vector<std::unique_ptr<interior_node>> interiors_{};
+};
+
+template<class ChildOf>
+static double measure(const complete_tree& tree, std::size_t height,
+                      ChildOf&& child_of) {
+    Xoroshiro128Plus rnd{};
+    std::size_t ops{0};
+    std::uintptr_t sink{0};
+    auto start = std::chrono::steady_clock::now();
+    auto end = start + std::chrono::seconds(FLAGS_duration);
+    while (std::chrono::steady_clock::now() < end) {
+        for (std::size_t i = 0; i < 1024; ++i) { // NOLINT
+            key_slice_type key = rnd.next();
+            base_node* n = tree.get_root();
+            node_version64_body v = n->get_stable_version();
+            for (std::size_t h = 0; h < height; ++h) {
+                n = child_of(static_cast<interior_node*>(n), key,
+                             sizeof(key_slice_type), v);
+            }
+            sink += reinterpret_cast<std::uintptr_t>(n); // NOLINT
+        }
+        ops += 1024; // NOLINT
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(
+            std::chrono::steady_clock::now() - start);
+    if (sink == 0) { std::cout << ""; }
+    return elapsed.count() / static_cast<double>(ops);
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "start interior search bench." << std::endl; // NOLINT(*-avoid-endl)
+    gflags::SetUsageMessage(static_cast<const std::string&>(
+            "micro-benchmark for interior node search"));
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+    check_flags();
+
+    std::cout << "height\tlinear[ns/lookup]\tget_child_of[ns/lookup]\tspeedup\n";
+    for (std::size_t height = 1; height <= FLAGS_max_height; ++height) {
+        complete_tree tree{height};
+        double current = measure(
+                tree, height,
+                [](interior_node* n, key_slice_type ks, key_length_type kl,
+                   node_version64_body& v) { return n->get_child_of(ks, kl, v); });
+        double linear = measure(tree, height, linear_get_child_of);
+        std::cout << height << "\t" << std::fixed << std::setprecision(2)
+                  << linear << "\t\t\t" << current << "\t\t\t"
+                  << linear / current << "\n";
+    }
+    return 0;
+}
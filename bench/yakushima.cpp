@@ -59,8 +59,20 @@ DEFINE_uint32(value_size, 8, "value size");                      // NOLINT
 
 // unique for instruction
 DEFINE_uint64(range_of_scan, 1000, "# elements of range."); // NOLINT
+DEFINE_uint64(get_batch, 0,                                  // NOLINT
+              "# keys of a get_many call. 0 uses get.");     // NOLINT
+DEFINE_bool(bulk_load, false,                                // NOLINT
+            "Build the initial tree by bulk_load.");         // NOLINT
+DEFINE_bool(huge_page_arena, false,                          // NOLINT
+            "Allocate nodes and small values from huge pages."); // NOLINT
+DEFINE_string(numa, "none",                                  // NOLINT
+              "none, local or interleave placement of the huge page arena."); // NOLINT
 
 std::string bench_storage{"1"}; // NOLINT
+/**
+ * @brief The workers operate with the handle, so that they don't search the storage.
+ */
+storage_handle bench_handle{}; // NOLINT
 
 static void check_flags() {
     std::cout << "parameter settings\n"
@@ -70,7 +82,12 @@ static void check_flags() {
               << "instruction :\t\t" << FLAGS_instruction << "\n"
               << "thread :\t\t" << FLAGS_thread << "\n"
               << "range_of_scan :\t\t" << FLAGS_range_of_scan << "\n"
-              << "value_size :\t\t" << FLAGS_value_size << std::endl;
+              << "get_batch :\t\t" << FLAGS_get_batch << "\n"
+              << "bulk_load :\t\t" << FLAGS_bulk_load << "\n"
+              << "huge_page_arena :\t" << FLAGS_huge_page_arena << "\n"
+              << "numa :\t\t\t" << FLAGS_numa << "\n"
+              << "value_size :\t\t" << FLAGS_value_size << "\n"
+              << "prefetch :\t\t" << YAKUSHIMA_PREFETCH << std::endl;
 
     // about thread
     if (FLAGS_thread == 0) {
@@ -93,6 +110,12 @@ static void check_flags() {
                    "The default is get.";
     }
 
+    // about numa
+    if (FLAGS_numa != "none" && FLAGS_numa != "local" &&
+        FLAGS_numa != "interleave") {
+        LOG(FATAL) << "The numa option must be none, local or interleave.";
+    }
+
     // about skew
     if (FLAGS_get_skew < 0 || FLAGS_get_skew > 1) {
         LOG(FATAL) << "access skew must be in the range 0 to 0.999...";
@@ -133,13 +156,40 @@ void parallel_build_tree() {
                 std::string key{
                         static_cast<char*>(p),
                         sizeof(std::uint64_t)}; // sizeof(std::size_t) points to loop variable.
-                put(token, bench_storage, key, value.data(), value.size());
+                put(token, bench_handle, key, value.data(), value.size());
             }
             leave(token);
         }
     };
 
-    if (FLAGS_initial_record < 1000) {
+    if (FLAGS_bulk_load) {
+        // the keys are sorted as strings, not as numbers.
+        std::vector<std::uint64_t> keys(FLAGS_initial_record);
+        for (std::uint64_t i = 0; i < FLAGS_initial_record; ++i) { keys[i] = i; }
+        auto as_key = [](const std::uint64_t& i) {
+            return std::string_view{reinterpret_cast<const char*>(&i), // NOLINT
+                                    sizeof(std::uint64_t)};
+        };
+        std::sort(keys.begin(), keys.end(),
+                  [&as_key](const std::uint64_t& a, const std::uint64_t& b) {
+                      return as_key(a) < as_key(b);
+                  });
+        std::string value(FLAGS_value_size, '0');
+        std::vector<std::tuple<std::string_view, char*, std::size_t>> entries{};
+        entries.reserve(keys.size());
+        for (auto&& i : keys) {
+            entries.emplace_back(as_key(i), value.data(), value.size());
+        }
+        std::cout << "parallel_build_tree : bulk_load : concurrency : "
+                  << std::thread::hardware_concurrency() << std::endl;
+        Token token{};
+        while (enter(token) != status::OK) { _mm_pause(); }
+        if (bulk_load(token, bench_handle, entries, 1.0,
+                      std::thread::hardware_concurrency()) != status::OK) {
+            LOG(FATAL) << "bulk_load failed.";
+        }
+        leave(token);
+    } else if (FLAGS_initial_record < 1000) {
         // small tree is built by single thread.
         std::cout << "parallel_build_tree : concurrency : 1" << std::endl;
         S::parallel_build_worker(0, FLAGS_initial_record);
@@ -172,6 +222,7 @@ void parallel_build_tree() {
 
 struct alignas(CACHE_LINE_SIZE) workarea {
     std::size_t res = 0;
+    retry_stats retries{};
     bool exhaust = false;
     std::chrono::system_clock::time_point w_stop;
 };
@@ -196,12 +247,30 @@ void get_worker(const size_t thid, char& ready, const bool& start,
 #ifdef PERFORMANCE_TOOLS
     performance_tools::get_watch().set_point(0, thid);
 #endif
+    std::vector<std::string> keys(FLAGS_get_batch);
+    std::vector<std::string_view> key_views(FLAGS_get_batch);
+    std::vector<std::pair<char*, std::size_t>> rets{};
+    std::vector<status> rcs{};
     while (!loadAcquireN(quit)) {
+        if (FLAGS_get_batch != 0) {
+            for (std::size_t i = 0; i < FLAGS_get_batch; ++i) {
+                std::uint64_t keynm = zipf() % FLAGS_initial_record;
+                keys[i].assign(reinterpret_cast<char*>(&keynm), // NOLINT
+                               sizeof(std::uint64_t));
+                key_views[i] = keys[i];
+            }
+            get_many<char>(bench_handle, key_views, rets, rcs);
+            for (auto rc : rcs) {
+                if (rc != status::OK) { LOG(ERROR) << "fatal error"; }
+            }
+            local_res += FLAGS_get_batch;
+            continue;
+        }
         std::uint64_t keynm = zipf() % FLAGS_initial_record;
         void* p = (&keynm);
         std::string key{static_cast<char*>(p), sizeof(std::uint64_t)};
         std::pair<char*, std::size_t> ret{};
-        if (get<char>(bench_storage, key, ret) != status::OK) {
+        if (get<char>(bench_handle, key, ret) != status::OK) {
             LOG(ERROR) << "fatal error";
         }
         ++local_res;
@@ -211,6 +280,7 @@ void get_worker(const size_t thid, char& ready, const bool& start,
 #endif
     leave(token);
     work.res = local_res;
+    work.retries = get_retry_stats();
 }
 
 void scan_worker(const size_t thid, char& ready, const bool& start,
@@ -236,7 +306,7 @@ void scan_worker(const size_t thid, char& ready, const bool& start,
     while (!loadAcquireN(quit)) {
         std::vector<std::tuple<std::string, char*, std::size_t>> tuple_list{};
         std::vector<std::pair<node_version64_body, node_version64*>> nv;
-        if (scan(bench_storage, "", scan_endpoint::INF, "", scan_endpoint::INF,
+        if (scan(bench_handle, "", scan_endpoint::INF, "", scan_endpoint::INF,
                  tuple_list, &nv, FLAGS_range_of_scan) != status::OK) {
             LOG(ERROR) << "fatal error";
         }
@@ -250,6 +320,7 @@ void scan_worker(const size_t thid, char& ready, const bool& start,
 #endif
     leave(token);
     work.res = local_res;
+    work.retries = get_retry_stats();
 }
 
 void remove_worker(const size_t thid, char& ready, const bool& start,
@@ -276,7 +347,7 @@ void remove_worker(const size_t thid, char& ready, const bool& start,
         std::string key{reinterpret_cast<char*>(&i), // NOLINT
                         sizeof(std::uint64_t)};      // NOLINT
         try {
-            auto rc = remove(token, bench_storage, key);
+            auto rc = remove(token, bench_handle, key);
             if (rc != status::OK) { LOG(FATAL) << "unexpected error."; }
         } catch (std::bad_alloc&) {
             LOG(FATAL) << "bad_alloc. Please set less duration.";
@@ -297,6 +368,7 @@ void remove_worker(const size_t thid, char& ready, const bool& start,
 
     leave(token);
     work.res = local_res;
+    work.retries = get_retry_stats();
 }
 void put_worker(const size_t thid, char& ready, const bool& start,
                 const bool& quit, workarea& work) {
@@ -322,7 +394,7 @@ void put_worker(const size_t thid, char& ready, const bool& start,
         std::string key{reinterpret_cast<char*>(&i), // NOLINT
                         sizeof(std::uint64_t)};      // NOLINT
         try {
-            put(token, bench_storage, key, value.data(), value.size());
+            put(token, bench_handle, key, value.data(), value.size());
         } catch (std::bad_alloc&) {
             LOG(FATAL) << "bad_alloc. Please set less duration.";
         }
@@ -338,6 +410,7 @@ void put_worker(const size_t thid, char& ready, const bool& start,
 
     leave(token);
     work.res = local_res;
+    work.retries = get_retry_stats();
 }
 
 static void invoke_leader() try {
@@ -346,8 +419,16 @@ static void invoke_leader() try {
     alignas(CACHE_LINE_SIZE) std::vector<workarea> work(FLAGS_thread);
 
     LOG(INFO) << "[start] init masstree database.";
-    init();
+    numa_policy placement{numa_policy::NONE};
+    if (FLAGS_numa == "local") {
+        placement = numa_policy::LOCAL;
+    } else if (FLAGS_numa == "interleave") {
+        placement = numa_policy::INTERLEAVE;
+    }
+    // the placement is of the huge page arena.
+    init(FLAGS_huge_page_arena || placement != numa_policy::NONE, placement);
     create_storage(bench_storage);
+    find_storage(bench_storage, bench_handle);
     LOG(INFO) << "[end] init masstree database.";
 
     std::cout << "[report] This experiments use ";
@@ -414,11 +495,21 @@ static void invoke_leader() try {
         }
     }
     std::cout << "throughput[ops/s]: " << fin_res / FLAGS_duration << std::endl;
+    retry_stats retries{};
+    for (auto&& w : work) {
+        retries.from_root += w.retries.from_root;
+        retries.from_layer_root += w.retries.from_layer_root;
+        retries.move_right += w.retries.move_right;
+    }
+    std::cout << "retry_from_root: " << retries.from_root
+              << " retry_from_layer_root: " << retries.from_layer_root
+              << " move_right: " << retries.move_right << std::endl;
     displayRusageRUMaxrss();
     LOG(INFO) << "[start] fin masstree.";
     std::chrono::system_clock::time_point c_start;
     std::chrono::system_clock::time_point c_end;
     c_start = std::chrono::system_clock::now();
+    bench_handle.reset();
     fin();
     c_end = std::chrono::system_clock::now();
     LOG(INFO) << "[end] fin masstree.";
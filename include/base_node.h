@@ -5,6 +5,7 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <cstring>
 #include <functional>
 #include <iomanip>
@@ -28,26 +29,18 @@ public:
         key_tuple(key_slice_type slice, key_length_type length)
             : key_slice_(slice), key_length_(length) {}
 
-        explicit key_tuple(std::string_view key_sv) {
+        explicit key_tuple(std::string_view key_sv)
+            : key_slice_(make_key_slice(key_sv)) {
             if (key_sv.size() > sizeof(key_slice_type)) {
                 key_length_ = sizeof(key_slice_type) + 1;
-                memcpy(&key_slice_, key_sv.data(), sizeof(key_slice_type));
             } else {
-                key_slice_ = 0U;
                 key_length_ = key_sv.size();
-                memcpy(&key_slice_, key_sv.data(), key_sv.size());
             }
         }
 
         bool operator<(const key_tuple& r) const {
-            if (r.key_length_ == 0) { return false; }
-            if (key_length_ == 0) { return true; }
-            int ret = memcmp(&key_slice_, &r.key_slice_,
-                             key_length_ < r.key_length_ ? key_length_
-                                                         : r.key_length_);
-            if (ret < 0) { return true; }
-            if (ret == 0) { return key_length_ < r.key_length_; }
-            return false;
+            return key_slice_ < r.key_slice_ ||
+                   (key_slice_ == r.key_slice_ && key_length_ < r.key_length_);
         }
         bool operator>(const key_tuple& r) const { return r < *this; }
         bool operator>=(const key_tuple& r) const { return !(*this < r); }
@@ -80,22 +73,25 @@ public:
         key_length_type key_length_{0};
     };
 
-    virtual ~base_node() = default; // NOLINT
-
     void atomic_set_version_root(const bool tf) {
         version_.atomic_set_root(tf);
     }
 
     /**
-     * A virtual function is defined because It wants to distinguish the children class of
-     * the contents by using polymorphism. So this function is pure virtual function.
+     * Nodes have no vtable. These functions dispatch to border_node or interior_node by
+     * the border bit of the version, which is fixed by init_border / init_interior.
+     * They are defined in border_node.h, where both classes are complete.
+     */
+
+    /**
+     * @brief release all heap objects and clean up.
      */
-    virtual status destroy() = 0;
+    status destroy();
 
     /**
      * @details display function for analysis and debug.
      */
-    virtual void display() = 0;
+    void display();
 
     /**
      * @brief Collect the memory usage of this partial tree.
@@ -103,41 +99,19 @@ public:
      * @param level the level of this node in the tree.
      * @param mem_stat the stack of memory usage for each level.
      */
-    virtual void mem_usage(std::size_t level,
-                           memory_usage_stack& mem_stat) const = 0;
+    void mem_usage(std::size_t level, memory_usage_stack& mem_stat) const;
+
+    /**
+     * @brief It deletes @a n as the object of its own class.
+     * @details Deleting through base_node* is not allowed since there is no virtual
+     * destructor.
+     */
+    static void delete_node(base_node* n);
 
     void display_base() {
         std::cout << "base_node::display_base\n";
         version_.display();
         std::cout << "parent_ : " << get_parent() << "\n";
-        for (std::size_t i = 0; i < key_slice_length; ++i) {
-            std::cout << "key_slice_[" << i
-                      << "] : " << std::to_string(get_key_slice_at(i))
-                      << "\n"
-                      << "key_length_[" << i
-                      << "] : " << std::to_string(get_key_length_at(i))
-                      << "\n";
-        }
-    }
-
-    [[nodiscard]] const std::array<key_length_type, key_slice_length>&
-    get_key_length_ref() const {
-        return key_length_;
-    }
-
-    [[nodiscard]] key_length_type
-    get_key_length_at(const std::size_t index) const {
-        return key_length_.at(index);
-    }
-
-    [[nodiscard]] const std::array<key_slice_type, key_slice_length>&
-    get_key_slice_ref() const {
-        return key_slice_;
-    }
-
-    [[nodiscard]] key_slice_type
-    get_key_slice_at(const std::size_t index) const {
-        return key_slice_.at(index);
     }
 
     [[maybe_unused]] [[nodiscard]] bool get_lock() const {
@@ -180,20 +154,6 @@ public:
     void init_base() {
         version_.init();
         set_parent(nullptr);
-        key_slice_.fill(0);
-        key_length_.fill(0);
-    }
-
-    /**
-     * @details init at @a pos as position.
-     * @param[in] pos This is a position (index) to be initialized.
-     */
-    void init_base(const std::size_t pos) { set_key(pos, 0, 0); }
-
-    [[maybe_unused]] void init_base_member_range(const std::size_t start) {
-        for (std::size_t i = start; i < key_slice_length; ++i) {
-            set_key(i, 0, 0);
-        }
     }
 
     /**
@@ -232,31 +192,6 @@ public:
         }
     }
 
-    [[maybe_unused]] void move_key_to_base_range(base_node* const right,
-                                                 const std::size_t start) {
-        for (auto i = start; i < key_slice_length; ++i) {
-            right->set_key(i - start, get_key_slice_at(i),
-                           get_key_length_at(i));
-            set_key(i, 0, 0);
-        }
-    }
-
-    void set_key(const std::size_t index, const key_slice_type key_slice,
-                 const key_length_type key_length) {
-        set_key_slice_at(index, key_slice);
-        set_key_length_at(index, key_length);
-    }
-
-    void set_key_length_at(const std::size_t index,
-                           const key_length_type length) {
-        storeReleaseN(key_length_.at(index), length);
-    }
-
-    void set_key_slice_at(const std::size_t index,
-                          const key_slice_type key_slice) {
-        storeReleaseN(key_slice_.at(index), key_slice);
-    }
-
     /**
      * @pre take lock of parent
      */
@@ -286,25 +221,26 @@ public:
         version_.atomic_set_splitting(tf);
     }
 
-    void shift_left_base_member(const std::size_t start_pos,
-                                const std::size_t shift_size) {
-        memmove(&key_slice_.at(start_pos - shift_size),
-                &key_slice_.at(start_pos),
-                sizeof(key_slice_type) * (key_slice_length - start_pos));
-        memmove(&key_length_.at(start_pos - shift_size),
-                &key_length_.at(start_pos),
-                sizeof(key_length_type) * (key_slice_length - start_pos));
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+    /**
+     * @brief offsets for the layout verification. See node_layout_test.cpp.
+     */
+    [[nodiscard]] static constexpr std::size_t version_offset() {
+        return offsetof(base_node, version_);
     }
 
-    void shift_right_base_member(const std::size_t start,
-                                 const std::size_t shift_size) {
-        memmove(&key_slice_.at(start + shift_size), &key_slice_.at(start),
-                sizeof(key_slice_type) *
-                        (key_slice_length - start - shift_size));
-        memmove(&key_length_.at(start + shift_size), &key_length_.at(start),
-                sizeof(key_length_type) *
-                        (key_slice_length - start - shift_size));
+    [[nodiscard]] static constexpr std::size_t parent_offset() {
+        return offsetof(base_node, parent_);
     }
+#pragma GCC diagnostic pop
+
+    /**
+     * @brief It prefetches the lines of this node which a search reads.
+     * @details Traversal reads them next, so it is called as soon as the pointer to
+     * this node is known. It is defined in border_node.h.
+     */
+    void prefetch_header() const;
 
     /**
      * @brief It unlocks this node.
@@ -318,10 +254,14 @@ public:
     }
 
 private:
+    /**
+     * The keys follow in node_keys, whose width depends on the node kind.
+     */
+
     /**
      * @attention This variable is read/written concurrently.
      */
-    std::array<key_slice_type, key_slice_length> key_slice_{};
+    node_version64 version_{};
     /**
      * @attention This member is protected by its parent's lock.
      * In the original paper, Fig 2 tells that parent's type is interior_node*,
@@ -330,27 +270,13 @@ private:
      * This variable is read/written concurrently.
      */
     base_node* parent_{nullptr};
-    /**
-     * @attention This variable is read/written concurrently.
-     */
-    node_version64 version_{};
-    /**
-     * @attention This variable is read/written concurrently.
-     * @details This is used for distinguishing the identity of link or value and same
-     * slices. For example, key 1 : \0, key 2 : \0\0, ... , key 8 : \0\0\0\0\0\0\0\0. These
-     * keys have same key_slices (0) but different key_length. If the length is more than 8,
-     * the lv points out to next layer.
-     */
-    std::array<key_length_type, key_slice_length> key_length_{};
 };
 
 inline std::ostream& operator<<(std::ostream& out, const base_node::key_tuple t) {
     std::stringstream ss{};
-    ss << std::hex << std::setfill('0') << std::uppercase;
-    const auto* p = reinterpret_cast<const unsigned char*>(&t.get_key_slice()); // NOLINT
-    for (std::size_t i = 0; i < 8; i++) {
-        ss << std::setw(2) << static_cast<unsigned int>(p[i]); // NOLINT
-    }
+    // slices are big-endian, so this prints the bytes in key order.
+    ss << std::hex << std::setfill('0') << std::uppercase << std::setw(16)
+       << t.get_key_slice();
     return out << "{" << ss.str() << "," << static_cast<int>(t.get_key_length()) << "}";
 }
 
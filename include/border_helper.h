@@ -39,7 +39,8 @@ static void
 border_split(tree_instance* ti, border_node* border, std::string_view key_view,
              value* new_value,
              void** created_value_ptr, // NOLINT
-             inserted_node_info* inserted_node_info_ptr, std::size_t rank);
+             inserted_node_info* inserted_node_info_ptr, std::size_t rank,
+             value_pool* pool);
 
 /**
  * Start impl.
@@ -100,13 +101,14 @@ static void create_interior_parent_of_border(border_node* const left,
  * @param[out] created_value_ptr
  * @param[out] inserted_node_version_ptr
  * @param[in] rank
+ * @param[in] pool The pool of the session which allocates the key suffix.
  */
 
 static void insert_lv(tree_instance* ti, border_node* const border,
                       std::string_view key_view, value* new_value,
                       void** const created_value_ptr,
                       inserted_node_info* inserted_node_info_ptr,
-                      std::size_t rank) {
+                      std::size_t rank, value_pool* const pool) {
     border->set_version_inserting_deleting(true);
     std::size_t cnk = border->get_permutation_cnk();
     if (cnk == 0) {
@@ -125,7 +127,7 @@ static void insert_lv(tree_instance* ti, border_node* const border,
          */
         border_split(
                 ti, border, key_view, new_value, created_value_ptr,
-                inserted_node_info_ptr, rank);
+                inserted_node_info_ptr, rank, pool);
     } else {
         /**
          * Insert into this nodes.
@@ -134,16 +136,68 @@ static void insert_lv(tree_instance* ti, border_node* const border,
             inserted_node_info_ptr->modified_nvp = border->get_version_ptr();
         }
         border->insert_lv_at(border->get_permutation().get_empty_slot(),
-                             key_view, new_value, created_value_ptr, rank);
+                             key_view, new_value, created_value_ptr, rank, pool);
         border->version_unlock();
     }
 }
 
+/**
+ * @details It creates the root of a new layer which has two keys. It is used when a key
+ * shares the key slice with a key which has the key suffix, so the keys are the rests
+ * after the key slice. If they share the next key slice too, it creates layers until
+ * they differ.
+ * @pre @a key_a and @a key_b are different.
+ * @param[in] key_a
+ * @param[in] value_a
+ * @param[in] key_b
+ * @param[in] value_b
+ * @param[out] created_value_ptr The pointer to created value of @a key_b in yakushima.
+ * @param[in] pool The pool of the session which allocates the key suffixes.
+ * @return The root of the new layer, which is not linked yet.
+ */
+static border_node* create_layer_of_two(std::string_view key_a, value* value_a,
+                                        std::string_view key_b, value* value_b,
+                                        void** const created_value_ptr,
+                                        value_pool* const pool) {
+    border_node* new_border = new border_node(); // NOLINT
+    key_slice_type key_slice = make_key_slice(key_b);
+    if (key_a.size() > sizeof(key_slice_type) &&
+        key_b.size() > sizeof(key_slice_type) &&
+        make_key_slice(key_a) == key_slice) {
+        key_a.remove_prefix(sizeof(key_slice_type));
+        key_b.remove_prefix(sizeof(key_slice_type));
+        border_node* child = create_layer_of_two(key_a, value_a, key_b, value_b,
+                                                 created_value_ptr, pool);
+        new_border->init_border();
+        new_border->get_version_ptr()->atomic_inc_vinsert();
+        std::size_t index = new_border->get_permutation().get_empty_slot();
+        new_border->set_key_slice_at(index, key_slice);
+        new_border->set_key_length_at(index, sizeof(key_slice_type) + 1);
+        new_border->set_lv_next_layer(index, child);
+        new_border->get_permutation().insert_rank(0, index);
+        child->set_parent(new_border);
+        return new_border;
+    }
+    new_border->init_border(key_a, value_a, static_cast<void**>(nullptr), true,
+                            pool);
+    key_length_type key_length =
+            key_b.size() > sizeof(key_slice_type)
+                    ? sizeof(key_slice_type) + 1
+                    : static_cast<key_length_type>(key_b.size());
+    new_border->insert_lv_at(new_border->get_permutation().get_empty_slot(),
+                             key_b, value_b, created_value_ptr,
+                             new_border->compute_rank_if_insert(key_slice,
+                                                                key_length),
+                             pool);
+    return new_border;
+}
+
 static void border_split(tree_instance* ti, border_node* const border,
                          std::string_view key_view, value* new_value,
                          void** const created_value_ptr,
                          inserted_node_info* inserted_node_info_ptr,
-                         [[maybe_unused]] std::size_t rank) {
+                         [[maybe_unused]] std::size_t rank,
+                         value_pool* const pool) {
     border->set_version_splitting(true);
     border_node* new_border = new border_node(); // NOLINT
     new_border->init_border();
@@ -199,43 +253,35 @@ static void border_split(tree_instance* ti, border_node* const border,
 
     /**
      * The insert process we wanted to do before we split.
-     * key_slice must be initialized to 0.
      */
-    key_slice_type key_slice{0};
+    key_slice_type key_slice = make_key_slice(key_view);
     key_length_type key_length{0}; // NOLINT
     if (key_view.size() > sizeof(key_slice_type)) {
-        memcpy(&key_slice, key_view.data(), sizeof(key_slice_type));
         key_length = sizeof(key_slice_type) + 1;
     } else {
-        if (!key_view.empty()) {
-            memcpy(&key_slice, key_view.data(), key_view.size());
-        }
         key_length = static_cast<key_length_type>(key_view.size());
     }
-    int ret_memcmp{
-            memcmp(&key_slice, &new_border->get_key_slice_ref().at(0),
-                   std::min<key_length_type>({key_length,
-                                              new_border->get_key_length_at(0),
-                                              sizeof(key_slice_type)}))};
-    if (key_length == 0 || // definitely
-        ret_memcmp < 0 ||  // smaller than front of new border node
-        (ret_memcmp == 0 && key_length < new_border->get_key_length_at(0)) ||
+    key_slice_type front_slice = new_border->get_key_slice_at(0);
+    if (key_length == 0 ||          // definitely
+        key_slice < front_slice ||  // smaller than front of new border node
+        (key_slice == front_slice &&
+         key_length < new_border->get_key_length_at(0)) ||
         // same string to the front of new border node and smaller string.
-        (ret_memcmp == 0 && rank < remaining_size)
+        (key_slice == front_slice && rank < remaining_size)
         // null string can't compare but rank is smaller then that.
     ) {
         /**
          * insert to lower border node.
          */
         border->insert_lv_at(border->get_permutation().get_empty_slot(),
-                             key_view, new_value, created_value_ptr, rank);
+                             key_view, new_value, created_value_ptr, rank, pool);
     } else {
         /**
          * insert to higher border node.
          */
         new_border->insert_lv_at(new_border->get_permutation().get_empty_slot(),
                                  key_view, new_value, created_value_ptr,
-                                 rank - remaining_size);
+                                 rank - remaining_size, pool);
     }
 
     base_node* p = border->lock_parent(ti);
@@ -274,7 +320,7 @@ static void border_split(tree_instance* ti, border_node* const border,
          * attention : The parent border node had this border node as one of the next_layer
          * before the split. The pointer is exchanged for a new parent interior node.
          */
-        auto* pb = dynamic_cast<border_node*>(p);
+        auto* pb = static_cast<border_node*>(p);
         interior_node* pi{};
         create_interior_parent_of_border(
                 border, new_border, &pi);
@@ -293,12 +339,12 @@ static void border_split(tree_instance* ti, border_node* const border,
 #ifndef NDEBUG
     if (p->get_version_deleted()) { LOG(ERROR) << log_location_prefix; }
 #endif
-    auto* pi = dynamic_cast<interior_node*>(p);
+    auto* pi = static_cast<interior_node*>(p);
     border->set_version_root(false); // guard by parent lock
     new_border->set_version_root(false); // guard by parent lock
     border->version_unlock();
     new_border->version_unlock();
-    if (pi->get_n_keys() == key_slice_length) {
+    if (pi->get_n_keys() == interior_key_slice_length) {
         /**
          * interior full case, it splits and inserts.
          */
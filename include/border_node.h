@@ -12,7 +12,10 @@
 #include "atomic_wrapper.h"
 #include "garbage_collection.h"
 #include "interior_node.h"
+#include "key_search.h"
 #include "link_or_value.h"
+#include "node_keys.h"
+#include "node_pool.h"
 #include "permutation.h"
 #include "thread_info.h"
 
@@ -23,9 +26,20 @@ namespace yakushima {
 using std::cout;
 using std::endl;
 
-class alignas(CACHE_LINE_SIZE) border_node final : public base_node { // NOLINT
+class alignas(CACHE_LINE_SIZE) border_node final // NOLINT
+    : public base_node,
+      public node_keys<key_slice_length> {
 public:
-    ~border_node() override {} // NOLINT
+    /**
+     * @brief The nodes are allocated from node_pool.
+     */
+    static void* operator new([[maybe_unused]] std::size_t size) {
+        return node_pool<border_node>::allocate();
+    }
+
+    static void operator delete(void* const p) {
+        node_pool<border_node>::deallocate(p);
+    }
 
     /**
      * @pre This function is called by delete_of function.
@@ -39,13 +53,22 @@ public:
                    const bool target_is_value) {
         auto* ti = reinterpret_cast<thread_info*>(token); // NOLINT
         if (target_is_value) {
+            if (key_suffix* ks = lv_.at(pos).get_key_suffix(); ks != nullptr) {
+                auto [ks_ptr, ks_len, ks_align] = key_suffix::get_gc_info(ks);
+                ti->get_gc_info().push_value_container(
+                        {ti->get_begin_epoch(), ks_ptr, ks_len, ks_align});
+                lv_.at(pos).set_key_suffix(nullptr);
+            }
             value* vp = lv_.at(pos).get_value();
             if (value::is_value_ptr(vp)) {
                 // it is value ptr (not inline value)
-                value::remove_delete_flag(vp);
-                auto [v_ptr, v_len, v_align] = value::get_gc_info(vp);
-                ti->get_gc_info().push_value_container(
-                        {ti->get_begin_epoch(), v_ptr, v_len, v_align});
+                // a value in the area of the slot is kept until the area expires.
+                if (!value::is_in_node(vp)) {
+                    value::remove_delete_flag(vp);
+                    auto [v_ptr, v_len, v_align] = value::get_gc_info(vp);
+                    ti->get_gc_info().push_value_container(
+                            {ti->get_begin_epoch(), v_ptr, v_len, v_align});
+                }
                 /**
                  * clear for preventing heap use after free by reference of
                  * need_delete
@@ -82,7 +105,7 @@ public:
     /**
      * @brief release all heap objects and clean up.
      */
-    status destroy() override {
+    status destroy() {
         std::size_t cnk = get_permutation_cnk();
         std::vector<std::thread> th_vc;
         for (std::size_t i = 0; i < cnk; ++i) {
@@ -135,8 +158,7 @@ public:
             std::size_t index = permutation_.get_index_of_rank(i);
             if ((key_slice_length == 0 && get_key_length_at(index) == 0) ||
                 (key_slice_length == get_key_length_at(index) &&
-                 memcmp(&key_slice, &get_key_slice_ref().at(index),
-                        sizeof(key_slice_type)) == 0)) {
+                 key_slice == get_key_slice_at(index))) {
                 delete_at(token, i, index, target_is_value);
                 if (cnk == 1) { // attention : this cnk is before delete_at;
                     set_version_deleted(true);
@@ -166,6 +188,12 @@ public:
                      */
                     base_node* pn = lock_parent(ti);
                     if (pn == nullptr) {
+                        /**
+                         * Only the root of the top layer has no parent. The root of a
+                         * lower layer has the border node of the upper layer as its
+                         * parent, which unlinks the empty layer from its slot below, and
+                         * the layer is retired through the gc.
+                         */
                         //ti->store_root_ptr(nullptr);
                         // remain empty deleted root node.
                         ti->root_unlock();
@@ -180,10 +208,10 @@ public:
                     set_version_root(false); // guard by parent lock
                     version_unlock();
                     if (pn->get_version_border()) {
-                        dynamic_cast<border_node*>(pn)->delete_of(token, ti,
+                        static_cast<border_node*>(pn)->delete_of(token, ti,
                                                                   this);
                     } else {
-                        dynamic_cast<interior_node*>(pn)
+                        static_cast<interior_node*>(pn)
                                 ->delete_of(token, ti, this);
                     }
                     auto* tinfo =
@@ -204,11 +232,66 @@ public:
                    << ", is root: " << get_version_root();
     }
 
+    /**
+     * @pre
+     * This border node was already locked by caller.
+     * The value corresponding to @a key_slice and @a key_slice_length exists in this
+     * node, and it is not the last key-value of this node.
+     * @details It deletes the value like delete_of, but it keeps the lock, so that the
+     * caller can continue to modify this node.
+     * @param[in] token
+     * @param[in] key_slice The key slice of key-value.
+     * @param[in] key_slice_length The @a key_slice length.
+     */
+    void delete_value_keeping_lock(Token token, const key_slice_type key_slice,
+                                   const key_length_type key_slice_length) {
+        std::size_t cnk = get_permutation_cnk();
+        for (std::size_t i = 0; i < cnk; ++i) {
+            std::size_t index = permutation_.get_index_of_rank(i);
+            if ((key_slice_length == 0 && get_key_length_at(index) == 0) ||
+                (key_slice_length == get_key_length_at(index) &&
+                 key_slice == get_key_slice_at(index))) {
+                delete_at(token, i, index, true);
+                return;
+            }
+        }
+        // unreachable points.
+        LOG(ERROR) << log_location_prefix;
+    }
+
+    /**
+     * @pre This border node was already locked by caller, and @a lv is a slot of it.
+     * @details It replaces the value of @a lv with @a new_value. Readers may still read the
+     * old value, so it is retired through the gc of @a token. It keeps the lock, so that
+     * the caller can continue to modify this node.
+     * @param[in] token
+     * @param[in] lv
+     * @param[in] new_value
+     * @param[out] created_value_ptr Same to link_or_value::set_value.
+     */
+    void replace_value_keeping_lock(Token token, link_or_value* const lv,
+                                    value* const new_value,
+                                    void** const created_value_ptr) {
+        if (value::is_in_node(lv->get_value())) {
+            // readers of the area of the slot see the change of the version.
+            set_version_inserting_deleting(true);
+        }
+        value* old_v = nullptr;
+        lv->set_value(new_value, created_value_ptr, &old_v);
+        if (old_v != nullptr) {
+            auto* ti = reinterpret_cast<thread_info*>(token); // NOLINT
+            auto [o_ptr, o_len, o_align] = value::get_gc_info(old_v);
+            ti->get_gc_info().push_value_container(
+                    {ti->get_begin_epoch(), o_ptr, o_len, o_align});
+        }
+    }
+
     /**
      * @details display function for analysis and debug.
      */
-    void display() override {
+    void display() {
         display_base();
+        display_keys();
         cout << "border_node::display\n";
         permutation_.display();
         for (std::size_t i = 0; i < get_permutation_cnk(); ++i) {
@@ -224,7 +307,7 @@ public:
      * @param mem_stat the stack of memory usage for each level.
      */
     void mem_usage(std::size_t level,
-                   memory_usage_stack& mem_stat) const override {
+                   memory_usage_stack& mem_stat) const {
         if (mem_stat.size() <= level) { mem_stat.emplace_back(0, 0, 0); }
         auto& [node_num, used, reserved] = mem_stat.at(level);
 
@@ -307,9 +390,7 @@ public:
                 return 0;
             }
             // not zero key
-            auto ret = memcmp(&key_slice, &target_key_slice,
-                              sizeof(key_slice_type));
-            if (ret == 0) {
+            if (key_slice == target_key_slice) {
                 if ((key_length > sizeof(key_slice_type) &&
                      target_key_len > sizeof(key_slice_type)) ||
                     key_length == target_key_len) {
@@ -317,9 +398,8 @@ public:
                     return 0;
                 }
                 if (key_length < target_key_len) { return i; }
-            } else if (ret < 0) {
+            } else if (key_slice < target_key_slice) {
                 return i;
-                break;
             }
         }
 
@@ -346,36 +426,11 @@ public:
              * It loads cnk atomically by get_cnk func.
              */
             permutation perm{permutation_.get_body()};
-            std::size_t cnk = perm.get_cnk();
             link_or_value* ret_lv{nullptr};
-            for (std::size_t i = 0; i < cnk; ++i) {
-                bool suc{false};
-                std::size_t index = perm.get_index_of_rank(i);
-                key_slice_type target_key_slice = get_key_slice_at(index);
-                key_length_type target_key_len = get_key_length_at(index);
-                if (key_length == 0 && target_key_len == 0) {
-                    suc = true;
-                } else {
-                    auto ret = memcmp(&key_slice, &target_key_slice,
-                                      sizeof(key_slice_type));
-                    if (ret == 0) {
-                        if ((key_length > sizeof(key_slice_type) &&
-                             target_key_len > sizeof(key_slice_type)) ||
-                            key_length == target_key_len) {
-                            suc = true;
-                        } else if (key_length < target_key_len) {
-                            break;
-                        }
-                    } else if (ret < 0) {
-                        break;
-                    }
-                }
-
-                if (suc) {
-                    ret_lv = get_lv_at(index);
-                    lv_pos = index;
-                    break;
-                }
+            std::size_t index = find_lv_index(perm, key_slice, key_length);
+            if (index != key_slice_length) {
+                ret_lv = get_lv_at(index);
+                lv_pos = index;
             }
             node_version64_body v_check = get_stable_version();
             if (v == v_check) {
@@ -393,40 +448,86 @@ public:
          * It loads cnk atomically by get_cnk func.
          */
         permutation perm{permutation_.get_body()};
-        std::size_t cnk = perm.get_cnk();
-        link_or_value* ret_lv{nullptr};
-        for (std::size_t i = 0; i < cnk; ++i) {
-            bool suc{false};
-            std::size_t index = perm.get_index_of_rank(i);
-            key_slice_type target_key_slice = get_key_slice_at(index);
-            key_length_type target_key_len = get_key_length_at(index);
-            if (key_length == 0 && target_key_len == 0) {
-                suc = true;
-            } else {
-                auto ret = memcmp(&key_slice, &target_key_slice,
-                                  sizeof(key_slice_type));
-                if (ret == 0) {
-                    if ((key_length > sizeof(key_slice_type) &&
-                         target_key_len > sizeof(key_slice_type)) ||
-                        key_length == target_key_len) {
-                        suc = true;
-                    } else if (key_length < target_key_len) {
-                        break;
-                    }
-                } else if (ret < 0) {
-                    break;
-                }
-            }
+        std::size_t index = find_lv_index(perm, key_slice, key_length);
+        if (index == key_slice_length) { return nullptr; }
+        return get_lv_at(index);
+    }
 
-            if (suc) { ret_lv = get_lv_at(index); }
-        }
-        return ret_lv;
+    /**
+     * @brief It checks conservatively whether the key belongs to this node.
+     * @details Border nodes don't hold their fences, so the live keys stand for them.
+     * A key between the lowest and the highest live key belongs to this node, as does
+     * a key below the highest one in the leftmost node and a key above the lowest one
+     * in the rightmost node. The range of a node shrinks only by a split, so the
+     * caller must check that vsplit and vinsert_delete didn't change around this.
+     * @param[in] key_slice
+     * @param[in] key_length
+     * @return true if the key belongs to this node.
+     * @return false if it may not belong to this node.
+     */
+    [[nodiscard]] bool covers(const key_slice_type key_slice,
+                              const key_length_type key_length) {
+        permutation perm{permutation_.get_body()};
+        const std::size_t cnk = perm.get_cnk();
+        if (cnk == 0) { return false; }
+        return (get_prev() == nullptr ||
+                compare_key_at(perm.get_index_of_rank(0), key_slice,
+                               key_length) <= 0) &&
+               (get_next() == nullptr ||
+                compare_key_at(perm.get_index_of_rank(cnk - 1), key_slice,
+                               key_length) >= 0);
+    }
+
+    /**
+     * @brief It checks whether the key is at or beyond the lowest live key, that is,
+     * whether the key belongs to this node or to the right of it.
+     * @details The caller must check the version around this.
+     * @param[in] key_slice
+     * @param[in] key_length
+     * @return false if there is no live key.
+     */
+    [[nodiscard]] bool lowest_key_not_greater(const key_slice_type key_slice,
+                                              const key_length_type key_length) {
+        permutation perm{permutation_.get_body()};
+        if (perm.get_cnk() == 0) { return false; }
+        return compare_key_at(perm.get_index_of_rank(0), key_slice, key_length) <=
+               0;
     }
 
     border_node* get_next() { return loadAcquireN(next_); }
 
     permutation& get_permutation() { return permutation_; }
 
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+    /**
+     * @brief offsets for the layout verification. See node_layout_test.cpp.
+     */
+    [[nodiscard]] static constexpr std::size_t key_length_offset() {
+        return offsetof(border_node, key_length_);
+    }
+
+    [[nodiscard]] static constexpr std::size_t key_slice_offset() {
+        return offsetof(border_node, key_slice_);
+    }
+
+    [[nodiscard]] static constexpr std::size_t permutation_offset() {
+        return offsetof(border_node, permutation_);
+    }
+
+    [[nodiscard]] static constexpr std::size_t lv_offset() {
+        return offsetof(border_node, lv_);
+    }
+
+    [[nodiscard]] static constexpr std::size_t prev_offset() {
+        return offsetof(border_node, prev_);
+    }
+
+    [[nodiscard]] static constexpr std::size_t next_offset() {
+        return offsetof(border_node, next_);
+    }
+#pragma GCC diagnostic pop
+
     [[nodiscard]] std::uint8_t get_permutation_cnk() const {
         return permutation_.get_cnk();
     }
@@ -440,6 +541,7 @@ public:
 
     void init_border() {
         init_base();
+        init_keys();
         init_border_member_range(0);
         set_version_root(true);
         set_version_border(true);
@@ -453,7 +555,7 @@ public:
      * @param[in] pos This is a position (index) to be initialized.
      */
     void init_border(const std::size_t pos) {
-        init_base(pos);
+        init_key_at(pos);
         lv_.at(pos).init_lv();
     }
 
@@ -468,16 +570,18 @@ public:
      * @param[in] new_value
      * @param[out] created_value_ptr The pointer to created value in yakushima.
      * @param[in] root is the root node of the layer.
+     * @param[in] pool The pool of the session which allocates the key suffix.
      */
     template<class ValueType>
     void init_border(std::string_view key_view, value* new_value,
-                     ValueType** const created_value_ptr, const bool root) {
+                     ValueType** const created_value_ptr, const bool root,
+                     value_pool* const pool) {
         init_border();
         set_version_root(root);
         get_version_ptr()->atomic_inc_vinsert();
         insert_lv_at(get_permutation().get_empty_slot(), key_view, new_value,
                      reinterpret_cast<void**>(created_value_ptr), // NOLINT
-                     0);
+                     0, pool);
     }
 
     void init_border_member_range(const std::size_t start) {
@@ -493,40 +597,30 @@ public:
      * @param[in] arg_value_length
      * @param[in] value_align
      * @param[in] rank
+     * @param[in] pool The pool of the session which allocates the key suffix. If this
+     * is nullptr, it is allocated from the heap.
      */
     void insert_lv_at(const std::size_t index, std::string_view key_view,
                       value* new_value, void** const created_value_ptr,
-                      const std::size_t rank) {
-        /**
-         * attention: key_slice must be initialized to 0.
-         * If key_view.size() is smaller than sizeof(key_slice_type),
-         * it is not possible to update the whole key_slice object with memcpy.
-         * It is possible that undefined values may remain from initialization.
-         */
-        key_slice_type key_slice(0);
+                      const std::size_t rank, value_pool* const pool) {
+        key_slice_type key_slice = make_key_slice(key_view);
         if (key_view.size() > sizeof(key_slice_type)) {
-            /**
-             * Create multiple border nodes.
-             */
-            memcpy(&key_slice, key_view.data(), sizeof(key_slice_type));
             set_key_slice_at(index, key_slice);
             /**
              * You only need to know that it is 8 bytes or more. If it is
              * stored obediently, key_length_type must be a large size type.
              */
             set_key_length_at(index, sizeof(key_slice_type) + 1);
-            border_node* next_layer_border = new border_node(); // NOLINT
-            key_view.remove_prefix(sizeof(key_slice_type));
             /**
-             * attention: next_layer_border is the root of next layer.
+             * The rest of the key is kept as the key suffix. The next layer is created
+             * when another key shares the key slice (see create_layer_of_two).
              */
-            next_layer_border->init_border(key_view, new_value,
-                                           created_value_ptr, true);
-            next_layer_border->set_parent(this);
-            set_lv_next_layer(index, next_layer_border);
+            key_view.remove_prefix(sizeof(key_slice_type));
+            lv_.at(index).set_key_suffix(
+                    key_suffix::create_key_suffix(key_view, pool));
+            set_lv_value(index, new_value, created_value_ptr);
         } else {
             // set key
-            memcpy(&key_slice, key_view.data(), key_view.size());
             set_key_slice_at(index, key_slice);
             set_key_length_at(index,
                               static_cast<key_length_type>(key_view.size()));
@@ -580,6 +674,52 @@ public:
     }
 
 private:
+    /**
+     * @return negative, zero or positive if the key at @a index is less than, equal to
+     * or greater than the given key, where equal slices are ordered by length.
+     */
+    [[nodiscard]] int compare_key_at(const std::size_t index,
+                                     const key_slice_type key_slice,
+                                     const key_length_type key_length) const {
+        key_slice_type target = get_key_slice_at(index);
+        if (target != key_slice) { return target < key_slice ? -1 : 1; }
+        key_length_type target_length = get_key_length_at(index);
+        if (target_length != key_length) {
+            return target_length < key_length ? -1 : 1;
+        }
+        return 0;
+    }
+
+    /**
+     * @details It compares @a key_slice with all slots at once (see key_search.h) and
+     * resolves the candidates through the live slots of @a perm and the key length.
+     * Several live slots can share a slice (e.g. key \0 and key \0\0), so each candidate
+     * is checked in turn.
+     * @param[in] perm snapshot of the permutation.
+     * @param[in] key_slice
+     * @param[in] key_length
+     * @return the index of the matched slot, or key_slice_length if not found.
+     */
+    [[nodiscard]] std::size_t
+    find_lv_index(const permutation& perm, const key_slice_type key_slice,
+                  const key_length_type key_length) const {
+        std::uint32_t candidates = match_key_slice(get_key_slice_ref(), key_slice) &
+                                   perm.get_live_index_mask();
+        while (candidates != 0) {
+            auto index = static_cast<std::size_t>(__builtin_ctzll(candidates));
+            key_length_type target_key_len = get_key_length_at(index);
+            if ((key_length > sizeof(key_slice_type) &&
+                 target_key_len > sizeof(key_slice_type)) ||
+                key_length == target_key_len) {
+                // the caller reads the lv next.
+                prefetch_range(&lv_.at(index), &lv_.at(index) + 1);
+                return index;
+            }
+            candidates &= candidates - 1;
+        }
+        return key_slice_length;
+    }
+
     // first member of base_node is aligned along with cache line size.
     /**
      * @attention This variable is read/written concurrently.
@@ -598,4 +738,58 @@ private:
      */
     border_node* next_{nullptr};
 };
+
+// a search reads the version, the keys and the permutation, packed at the head.
+static_assert(border_node::key_length_offset() == sizeof(base_node));
+static_assert(border_node::key_slice_offset() <
+              border_node::key_length_offset() + key_slice_length +
+                      alignof(key_slice_type));
+static_assert(border_node::permutation_offset() ==
+              border_node::key_slice_offset() +
+                      sizeof(key_slice_type) * key_slice_length);
+
+inline void base_node::prefetch_header() const {
+    // the kind of this node is not known before the version is read.
+    constexpr std::size_t search_size =
+            std::min(border_node::permutation_offset() + sizeof(permutation),
+                     interior_node::n_keys_offset() +
+                             sizeof(interior_node::n_keys_type));
+    prefetch_range(this, reinterpret_cast<const char*>(this) + // NOLINT
+                                 search_size);
+}
+
+inline status base_node::destroy() {
+    if (get_version_border()) {
+        return static_cast<border_node*>(this)->destroy(); // NOLINT
+    }
+    return static_cast<interior_node*>(this)->destroy(); // NOLINT
+}
+
+inline void base_node::display() {
+    if (get_version_border()) {
+        static_cast<border_node*>(this)->display(); // NOLINT
+    } else {
+        static_cast<interior_node*>(this)->display(); // NOLINT
+    }
+}
+
+inline void base_node::mem_usage(std::size_t level,
+                                 memory_usage_stack& mem_stat) const {
+    if (get_version_border()) {
+        static_cast<const border_node*>(this)->mem_usage( // NOLINT
+                level, mem_stat);
+    } else {
+        static_cast<const interior_node*>(this)->mem_usage( // NOLINT
+                level, mem_stat);
+    }
+}
+
+inline void base_node::delete_node(base_node* const n) {
+    if (n->get_version_border()) {
+        delete static_cast<border_node*>(n); // NOLINT
+    } else {
+        delete static_cast<interior_node*>(n); // NOLINT
+    }
+}
+
 } // namespace yakushima
@@ -7,6 +7,7 @@
 #include "border_node.h"
 #include "interior_node.h"
 #include "log.h"
+#include "retry_stats.h"
 #include "version.h"
 
 #include "glog/logging.h"
@@ -20,7 +21,7 @@ namespace yakushima {
  *
  * @details It finds border node by using arguments @a root, @a key_slice.
  * If the @a root is not the root of some layer, this function finds root nodes of the
- * layer, then finds border node by using retry label.
+ * layer through the parents, then finds border node by using retry label.
  * @param[in] root
  * @param[in] key_slice
  * @param[in] key_slice_length
@@ -32,8 +33,9 @@ static std::tuple<border_node*, const node_version64_body>
 find_border(base_node* const root, const key_slice_type key_slice,
             const key_length_type key_slice_length, status& special_status) {
     special_status = status::OK;
+    base_node* layer_root = root;
 retry:
-    if (root == nullptr) {
+    if (layer_root == nullptr) {
         LOG(ERROR) << log_location_prefix << "find_border: root: " << root
                    << ", key_slice: " << key_slice
                    << ", key_slice_length: " << key_slice_length
@@ -42,11 +44,22 @@ retry:
         // if special status is warn, it is just after retry one.
     }
 
-    base_node* n = root;
+    base_node* n = layer_root;
+    n->prefetch_header();
     node_version64_body v = n->get_stable_version();
     if (!v.get_root()) {
-        special_status = status::WARN_RETRY_FROM_ROOT_OF_ALL;
-        return std::make_tuple(nullptr, node_version64_body());
+        /**
+         * The root of the layer was split, so its parent leads to the new root. A
+         * deleted node may have been detached from the layer.
+         */
+        base_node* parent = n->get_parent();
+        if (v.get_deleted() || parent == nullptr) {
+            ++get_retry_stats().from_root;
+            special_status = status::WARN_RETRY_FROM_ROOT_OF_ALL;
+            return std::make_tuple(nullptr, node_version64_body());
+        }
+        layer_root = parent;
+        goto retry; // NOLINT
     }
     if (v.get_deleted()) {
         // root && deleted node.
@@ -57,7 +70,9 @@ retry:
                        << ", special_status: " << special_status
                        << ", version: " << v;
         }
-        return std::make_tuple(dynamic_cast<border_node*>(n), v);
+        // the caller retries if the deleted root is not a border node.
+        return std::make_tuple(
+                v.get_border() ? static_cast<border_node*>(n) : nullptr, v);
     }
     /**
      * The caller checks whether it has been deleted.
@@ -66,7 +81,7 @@ retry:
         /**
          * @a n points to a interior_node object.
          */
-        base_node* n_child = dynamic_cast<interior_node*>(n)->get_child_of(
+        base_node* n_child = static_cast<interior_node*>(n)->get_child_of(
                 key_slice, key_slice_length, v);
         if (n_child == nullptr) {
             /**
@@ -85,7 +100,230 @@ retry:
                    << ", key_slice_length: " << key_slice_length
                    << ", special_status: " << special_status;
     }
-    return std::make_tuple(dynamic_cast<border_node*>(n), v);
+    return std::make_tuple(static_cast<border_node*>(n), v);
+}
+
+/**
+ * @brief The state of a key of find_border_group.
+ */
+struct border_cursor {
+    key_slice_type key_slice{};
+    key_length_type key_slice_length{};
+    /**
+     * @brief The node which the descent reached. It is the border node at the end, or
+     * nullptr if the descent met a concurrent SMO.
+     */
+    base_node* node{};
+    /**
+     * @brief The stable version of @a node.
+     */
+    node_version64_body v{};
+    base_node* child{};
+};
+
+/**
+ * @brief find_border of the layer for some keys in lock-step.
+ * @details Each round reads the node of every key, which was prefetched in the last round,
+ * and prefetches its child, so the cache misses of the keys overlap. It validates each
+ * step as interior_node::get_child_of does. If a descent meets a concurrent SMO or the
+ * root is not stable, the node of the key becomes nullptr and the caller finds border for
+ * it alone.
+ * @param[in] root The root of the layer.
+ * @param[in,out] cursors
+ * @param[in] num The number of @a cursors.
+ */
+static void find_border_group(base_node* const root, border_cursor* const cursors,
+                              const std::size_t num) {
+    root->prefetch_header();
+    node_version64_body root_v = root->get_stable_version();
+    bool stable = root_v.get_root() && !root_v.get_deleted();
+    for (std::size_t i = 0; i < num; ++i) {
+        cursors[i].node = stable ? root : nullptr; // NOLINT
+        cursors[i].v = root_v;                     // NOLINT
+    }
+    for (bool active = stable && !root_v.get_border(); active;) {
+        for (std::size_t i = 0; i < num; ++i) {
+            border_cursor& c = cursors[i]; // NOLINT
+            if (c.node == nullptr || c.v.get_border()) { continue; }
+            c.child = static_cast<interior_node*>(c.node)->peek_child_of(
+                    c.key_slice, c.key_slice_length);
+            if (c.child == nullptr) {
+                c.node = nullptr;
+                continue;
+            }
+            c.child->prefetch_header();
+        }
+        active = false;
+        for (std::size_t i = 0; i < num; ++i) {
+            border_cursor& c = cursors[i]; // NOLINT
+            if (c.node == nullptr || c.v.get_border()) { continue; }
+            // get child's status before rechecking version
+            node_version64_body child_v = c.child->get_stable_version();
+            node_version64_body check_v = c.node->get_stable_version();
+            if (c.v != check_v || child_v.get_deleted()) {
+                c.node = nullptr;
+                continue;
+            }
+            c.node = c.child;
+            c.v = child_v;
+            if (!child_v.get_border()) { active = true; }
+        }
+    }
+}
+
+/**
+ * @brief B-link style recovery of the border node which find_border returned, when it was
+ * split or deleted afterwards.
+ * @details A split moves the upper keys of a node to new right siblings, so the key is in
+ * @a n or to the right of it. It moves right while the key is not less than the lowest
+ * live key of the next node. Border nodes don't hold their fences, so if the key is in a
+ * gap between live keys of two nodes, it is not sure which node covers the key, and the
+ * caller has to find border again from the root of the layer.
+ * @param[in,out] n the border node, which becomes the node covering the key.
+ * @param[out] v the stable version of @a n.
+ * @param[in] layer_root the root of the layer of @a n which the caller found border from.
+ * nullptr if it is unknown.
+ * @param[in] key_slice
+ * @param[in] key_slice_length
+ * @return status::OK_RETRY_FETCH_LV @a n covers the key, so fetch lv from it again.
+ * @return status::OK_RETRY_AFTER_FB find border again from @a layer_root.
+ * @return status::OK_RETRY_FROM_ROOT retry from the root of the tree.
+ */
+static status recover_border(border_node*& n, node_version64_body& v,
+                             base_node* const layer_root,
+                             const key_slice_type key_slice,
+                             const key_length_type key_slice_length) {
+    border_node* bn = n;
+    for (;;) {
+        node_version64_body bv = bn->get_stable_version();
+        if (bv.get_deleted()) { break; }
+        if (bn->covers(key_slice, key_slice_length)) {
+            if (bv != bn->get_stable_version()) { continue; }
+            n = bn;
+            v = bv;
+            ++get_retry_stats().move_right;
+            return status::OK_RETRY_FETCH_LV;
+        }
+        border_node* next = bn->get_next();
+        if (next == nullptr) { break; }
+        node_version64_body next_v = next->get_stable_version();
+        bool beyond = next->lowest_key_not_greater(key_slice, key_slice_length);
+        if (next_v.get_deleted() || !beyond ||
+            next_v != next->get_stable_version()) {
+            break;
+        }
+        bn = next;
+    }
+    if (layer_root == nullptr || layer_root->get_version_deleted()) {
+        ++get_retry_stats().from_root;
+        return status::OK_RETRY_FROM_ROOT;
+    }
+    ++get_retry_stats().from_layer_root;
+    return status::OK_RETRY_AFTER_FB;
+}
+
+/**
+ * @brief It recovers the border node by recover_border and jumps to the retry label
+ * which the result selects.
+ * @details The caller defines the labels retry_fetch_lv, retry_find_border and
+ * retry_from_root, and the macro never falls through.
+ */
+#define YAKUSHIMA_RECOVER_BORDER(n, v, layer_root, key_slice, key_slice_length)       \
+    switch (recover_border((n), (v), (layer_root), (key_slice), (key_slice_length))) { \
+        case status::OK_RETRY_FETCH_LV:                                               \
+            goto retry_fetch_lv;                                                      \
+        case status::OK_RETRY_AFTER_FB:                                               \
+            goto retry_find_border;                                                   \
+        default:                                                                      \
+            goto retry_from_root;                                                     \
+    }
+
+/**
+ * @brief It descends to the border node of @a key_view and locks it.
+ * @details It goes down to the next layer if the key slice leads to it, so the node is
+ * in the deepest layer which the key reaches.
+ * @param[in] ti
+ * @param[in] key_view
+ * @param[out] prefix_length The length of the prefix of @a key_view which leads to the
+ * layer of the node.
+ * @return The locked border node. nullptr if the normal path should handle the key: the
+ * tree is empty, the node was split, or the layer was removed.
+ */
+[[maybe_unused]] static border_node*
+lock_border_of(tree_instance* ti, std::string_view key_view,
+               std::size_t& prefix_length) {
+    base_node* root = ti->load_root_ptr();
+    std::string_view traverse_key_view{key_view};
+    for (;;) {
+        if (root == nullptr) { return nullptr; }
+        key_slice_type key_slice = make_key_slice(traverse_key_view);
+        key_length_type key_length{};
+        if (traverse_key_view.size() > sizeof(key_slice_type)) {
+            key_length = sizeof(key_slice_type) + 1;
+        } else {
+            key_length = traverse_key_view.size();
+        }
+        status special_status{status::OK};
+        auto [border, v] = find_border(root, key_slice, key_length,
+                                       special_status);
+        if (special_status == status::WARN_RETRY_FROM_ROOT_OF_ALL ||
+            border == nullptr) {
+            return nullptr;
+        }
+        border->lock();
+        if ((border->get_version_deleted() && !border->get_version_root()) ||
+            border->get_version_vsplit() != v.get_vsplit()) {
+            border->version_unlock();
+            return nullptr;
+        }
+        link_or_value* lv_ptr =
+                border->get_lv_of_without_lock(key_slice, key_length);
+        if (lv_ptr == nullptr || lv_ptr->get_next_layer() == nullptr) {
+            prefix_length = key_view.size() - traverse_key_view.size();
+            return border;
+        }
+        root = lv_ptr->get_next_layer();
+        border->version_unlock();
+        traverse_key_view.remove_prefix(sizeof(key_slice_type));
+    }
+}
+
+/**
+ * @brief It locks the border node of @a key_view and finds the value of it.
+ * @param[in] ti
+ * @param[in] key_view
+ * @param[out] border The locked border node. The caller unlocks it.
+ * @param[out] key_slice The key slice of @a key_view in the layer of @a border.
+ * @param[out] key_length The key length of @a key_view in the layer of @a border.
+ * @return The link_or_value of the key. nullptr if the key doesn't exist.
+ */
+[[maybe_unused]] static link_or_value*
+lock_lv_of(tree_instance* ti, std::string_view key_view, border_node*& border,
+           key_slice_type& key_slice, key_length_type& key_length) {
+    std::size_t prefix_length{};
+    for (;;) {
+        border = lock_border_of(ti, key_view, prefix_length);
+        if (border != nullptr) { break; }
+        if (ti->load_root_ptr() == nullptr) { return nullptr; }
+        _mm_pause();
+    }
+    std::string_view traverse_key_view{key_view};
+    traverse_key_view.remove_prefix(prefix_length);
+    key_slice = make_key_slice(traverse_key_view);
+    if (traverse_key_view.size() > sizeof(key_slice_type)) {
+        key_length = sizeof(key_slice_type) + 1;
+    } else {
+        key_length = traverse_key_view.size();
+    }
+    link_or_value* lv_ptr = border->get_lv_of_without_lock(key_slice, key_length);
+    if (lv_ptr != nullptr && key_length > sizeof(key_slice_type)) {
+        traverse_key_view.remove_prefix(sizeof(key_slice_type));
+        if (lv_ptr->get_key_suffix() != nullptr &&
+            lv_ptr->get_key_suffix()->get_view() != traverse_key_view) {
+            return nullptr;
+        }
+    }
+    return lv_ptr;
 }
 
 } // namespace yakushima
@@ -16,4 +16,81 @@ namespace yakushima {
 
 #endif
 
+#ifndef YAKUSHIMA_BORDER_WIDTH
+
+// Max number of keys in a border node, from 3 to 15.
+#define YAKUSHIMA_BORDER_WIDTH 15
+
+#endif
+
+#ifndef YAKUSHIMA_INTERIOR_WIDTH
+
+// Max number of keys in an interior node, from 3 to 63.
+#define YAKUSHIMA_INTERIOR_WIDTH 15
+
+#endif
+
+#ifndef YAKUSHIMA_PREFETCH
+
+// Whether to prefetch nodes during traversal (1) or not (0).
+#define YAKUSHIMA_PREFETCH 1
+
+#endif
+
+#ifndef YAKUSHIMA_GET_MANY_GROUP
+
+// Number of lookups which get_many advances in lock-step.
+#define YAKUSHIMA_GET_MANY_GROUP 16
+
+#endif
+
+#ifndef YAKUSHIMA_VALUE_POOL_MAX_SIZE
+
+// Max size of the blocks of values which a session recycles [bytes]. 0 disables it.
+#define YAKUSHIMA_VALUE_POOL_MAX_SIZE 1024
+
+#endif
+
+#ifndef YAKUSHIMA_VALUE_POOL_CAPACITY
+
+// Max number of the recycled blocks of a size class which a session keeps.
+#define YAKUSHIMA_VALUE_POOL_CAPACITY 1024
+
+#endif
+
+#ifndef YAKUSHIMA_VALUE_POOL_SLAB_SIZE
+
+// Size of the memory which a session splits into the blocks of a size class at once [bytes].
+#define YAKUSHIMA_VALUE_POOL_SLAB_SIZE (64UL * 1024)
+
+#endif
+
+#ifndef YAKUSHIMA_NODE_POOL_CHUNK
+
+// Number of nodes which a thread allocates at once. 0 allocates each node from the heap.
+#define YAKUSHIMA_NODE_POOL_CHUNK 64
+
+#endif
+
+#ifndef YAKUSHIMA_INLINE_VALUE_SIZE
+
+// Max size of the values kept in the slots of border nodes [bytes]. 0 disables it.
+#define YAKUSHIMA_INLINE_VALUE_SIZE 0
+
+#endif
+
+#ifndef YAKUSHIMA_HUGE_PAGE_ARENA_SIZE
+
+// Size of the virtual memory which init reserves for the huge page arena [bytes].
+#define YAKUSHIMA_HUGE_PAGE_ARENA_SIZE (64UL * 1024 * 1024 * 1024)
+
+#endif
+
+#ifndef YAKUSHIMA_MAX_NUMA_NODES
+
+// Max number of NUMA nodes which the huge page arena splits itself into.
+#define YAKUSHIMA_MAX_NUMA_NODES 8
+
+#endif
+
 } // namespace yakushima
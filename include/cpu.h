@@ -4,7 +4,29 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
+#include "config.h"
+
 namespace yakushima {
 
 static constexpr std::size_t CACHE_LINE_SIZE{64};
+
+/**
+ * @brief It hints the cpu to load the cache lines which cover [begin, end).
+ * @details It does nothing if YAKUSHIMA_PREFETCH is 0.
+ */
+static inline void prefetch_range([[maybe_unused]] const void* begin,
+                                  [[maybe_unused]] const void* end) {
+#if YAKUSHIMA_PREFETCH
+    auto line = reinterpret_cast<std::uintptr_t>(begin) & // NOLINT
+                ~(CACHE_LINE_SIZE - 1);
+    auto last = reinterpret_cast<std::uintptr_t>(end); // NOLINT
+    for (; line < last; line += CACHE_LINE_SIZE) {
+        __builtin_prefetch(reinterpret_cast<const void*>(line)); // NOLINT
+    }
+#endif
 }
+
+} // namespace yakushima
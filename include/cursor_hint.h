@@ -0,0 +1,128 @@
+/**
+ * @file cursor_hint.h
+ * @brief the border node which the last point operation of a session reached.
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "border_node.h"
+#include "scheme.h"
+#include "thread_info.h"
+#include "tree_instance.h"
+#include "version.h"
+
+namespace yakushima {
+
+/**
+ * @brief It remembers the border node which the last point operation reached, so that the
+ * next operation on a near key starts there instead of descending from the root.
+ * @details The hint is only a shortcut: an operation validates it and descends from the
+ * root as usual when it is not valid. A hint may be used by one session at a time, and
+ * the node it holds is used only while the session which remembered it is still in
+ * (the same begin epoch), since the node may be reclaimed after that.
+ */
+class cursor_hint {
+public:
+    /**
+     * @brief It binds the hint to the session of the next operation.
+     * @details A hint remembered by another session is dropped.
+     * @param[in] token
+     */
+    void attach(Token token) {
+        if (token != token_) {
+            clear();
+            token_ = token;
+        }
+    }
+
+    void clear() { border_ = nullptr; }
+
+    /**
+     * @brief It returns the remembered border node if @a key_view belongs to it.
+     * @param[in] ti the tree of the operation.
+     * @param[in] key_view the key of the operation.
+     * @param[out] traverse_key_view the rest of @a key_view in the layer of the node.
+     * @param[out] stable_v the stable version of the node at validation.
+     * @return the border node to start from, or nullptr if it must descend from the root.
+     */
+    [[nodiscard]] border_node* find_border(tree_instance* const ti,
+                                           std::string_view key_view,
+                                           std::string_view& traverse_key_view,
+                                           node_version64_body& stable_v) {
+        if (border_ == nullptr || ti != ti_ || !in_session()) { return nullptr; }
+        /**
+         * The key must be in the same layer. A key which ends at the prefix lives in the
+         * upper layer.
+         */
+        if (!prefix_.empty() && (key_view.size() <= prefix_.size() ||
+                                 key_view.compare(0, prefix_.size(), prefix_) != 0)) {
+            return nullptr;
+        }
+        std::string_view rest{key_view};
+        rest.remove_prefix(prefix_.size());
+        key_length_type key_length =
+                rest.size() > sizeof(key_slice_type)
+                        ? sizeof(key_slice_type) + 1
+                        : static_cast<key_length_type>(rest.size());
+
+        node_version64_body v = border_->get_stable_version();
+        if (v.get_deleted() || v.get_vsplit() != v_.get_vsplit()) {
+            // the node was split or removed after it was remembered.
+            clear();
+            return nullptr;
+        }
+        bool covered = border_->covers(make_key_slice(rest), key_length);
+        if (v != border_->get_stable_version() || !covered) { return nullptr; }
+        traverse_key_view = rest;
+        stable_v = v;
+        return border_;
+    }
+
+    /**
+     * @brief It remembers the border node which the operation reached.
+     * @param[in] ti
+     * @param[in] key_view the key of the operation.
+     * @param[in] traverse_key_view the rest of @a key_view in the layer of @a bn.
+     * @param[in] bn
+     * @param[in] v the version of @a bn at reaching it.
+     */
+    void remember(tree_instance* const ti, std::string_view key_view,
+                  std::string_view traverse_key_view, border_node* const bn,
+                  const node_version64_body v) {
+        if (token_ == nullptr) { return; }
+        auto* tinfo = static_cast<thread_info*>(token_);
+        ti_ = ti;
+        epoch_ = tinfo->get_begin_epoch();
+        prefix_.assign(key_view.data(),
+                       key_view.size() - traverse_key_view.size());
+        border_ = bn;
+        v_ = v;
+    }
+
+private:
+    [[nodiscard]] bool in_session() const {
+        auto* tinfo = static_cast<thread_info*>(token_);
+        return tinfo->get_running() && tinfo->get_begin_epoch() == epoch_;
+    }
+
+    /**
+     * @brief the session which uses this hint.
+     */
+    Token token_{};
+    /**
+     * @brief the begin epoch of the session when @a border_ was remembered.
+     */
+    Epoch epoch_{};
+    tree_instance* ti_{};
+    border_node* border_{};
+    node_version64_body v_{};
+    /**
+     * @brief the key prefix which leads to the layer of @a border_.
+     */
+    std::string prefix_{};
+};
+
+} // namespace yakushima
@@ -13,6 +13,8 @@
 #include "concurrent_queue.h"
 #include "cpu.h"
 #include "epoch.h"
+#include "tree_instance.h"
+#include "value_pool.h"
 
 namespace yakushima {
 
@@ -21,19 +23,19 @@ public:
     void fin() {
         // for cache
         if (std::get<gc_target_index>(cache_node_container_) != nullptr) {
-            delete std::get<gc_target_index>(cache_node_container_); // NOLINT
+            base_node::delete_node(std::get<gc_target_index>(cache_node_container_));
             std::get<gc_target_index>(cache_node_container_) = nullptr;
         }
 
         while (!node_container_.empty()) {
             std::tuple<Epoch, base_node*> elem;
             if (!node_container_.try_pop(elem)) { continue; }
-            delete std::get<gc_target_index>(elem); // NOLINT
+            base_node::delete_node(std::get<gc_target_index>(elem));
         }
 
         // for cache
         if (std::get<gc_target_index>(cache_value_container_) != nullptr) {
-            ::operator delete(
+            value_pool::release_block(
                     std::get<gc_target_index>(cache_value_container_),
                     std::get<gc_target_size_index>(cache_value_container_),
                     std::get<gc_target_align_index>(cache_value_container_));
@@ -43,15 +45,29 @@ public:
         while (!value_container_.empty()) {
             std::tuple<Epoch, void*, std::size_t, std::align_val_t> elem;
             if (!value_container_.try_pop(elem)) { continue; }
-            ::operator delete(std::get<gc_target_index>(elem),
-                              std::get<gc_target_size_index>(elem),
-                              std::get<gc_target_align_index>(elem));
+            value_pool::release_block(std::get<gc_target_index>(elem),
+                                      std::get<gc_target_size_index>(elem),
+                                      std::get<gc_target_align_index>(elem));
+        }
+        value_pool_.fin();
+
+        // for cache
+        if (std::get<gc_target_index>(cache_tree_container_) != nullptr) {
+            destroy_tree(std::get<gc_target_index>(cache_tree_container_));
+            std::get<gc_target_index>(cache_tree_container_) = nullptr;
+        }
+
+        while (!tree_container_.empty()) {
+            std::tuple<Epoch, tree_instance*> elem;
+            if (!tree_container_.try_pop(elem)) { continue; }
+            destroy_tree(std::get<gc_target_index>(elem));
         }
     }
 
     void gc() {
         gc_node();
         gc_value();
+        gc_tree();
     }
 
     void gc_node() {
@@ -62,7 +78,7 @@ public:
             if (std::get<gc_epoch_index>(cache_node_container_) >= gc_epoch) {
                 return;
             }
-            delete std::get<gc_target_index>(cache_node_container_); // NOLINT
+            base_node::delete_node(std::get<gc_target_index>(cache_node_container_));
             std::get<gc_target_index>(cache_node_container_) = nullptr;
         }
 
@@ -74,7 +90,7 @@ public:
                 cache_node_container_ = elem;
                 return;
             }
-            delete std::get<gc_target_index>(elem); // NOLINT
+            base_node::delete_node(std::get<gc_target_index>(elem));
         }
     }
 
@@ -85,7 +101,7 @@ public:
             if (std::get<gc_epoch_index>(cache_value_container_) >= gc_epoch) {
                 return;
             }
-            ::operator delete(
+            value_pool_.recycle(
                     std::get<gc_target_index>(cache_value_container_),
                     std::get<gc_target_size_index>(cache_value_container_),
                     std::get<gc_target_align_index>(cache_value_container_));
@@ -99,9 +115,33 @@ public:
                 cache_value_container_ = elem;
                 return;
             }
-            ::operator delete(std::get<gc_target_index>(elem),
-                              std::get<gc_target_size_index>(elem),
-                              std::get<gc_target_align_index>(elem));
+            value_pool_.recycle(std::get<gc_target_index>(elem),
+                                std::get<gc_target_size_index>(elem),
+                                std::get<gc_target_align_index>(elem));
+        }
+    }
+
+    void gc_tree() {
+        Epoch gc_epoch = get_gc_epoch();
+
+        // for cache
+        if (std::get<gc_target_index>(cache_tree_container_) != nullptr) {
+            if (std::get<gc_epoch_index>(cache_tree_container_) >= gc_epoch) {
+                return;
+            }
+            destroy_tree(std::get<gc_target_index>(cache_tree_container_));
+            std::get<gc_target_index>(cache_tree_container_) = nullptr;
+        }
+
+        // for container
+        while (!tree_container_.empty()) {
+            std::tuple<Epoch, tree_instance*> elem;
+            if (!tree_container_.try_pop(elem)) { continue; }
+            if (std::get<gc_epoch_index>(elem) >= gc_epoch) {
+                cache_tree_container_ = elem;
+                return;
+            }
+            destroy_tree(std::get<gc_target_index>(elem));
         }
     }
 
@@ -109,6 +149,11 @@ public:
         return gc_epoch_.load(std::memory_order_acquire);
     }
 
+    /**
+     * @brief The pool which takes the values pushed to this after their epoch expires.
+     */
+    [[nodiscard]] value_pool& get_value_pool() { return value_pool_; }
+
     void push_node_container(std::tuple<Epoch, base_node*> elem) {
         node_container_.push(elem);
     }
@@ -118,11 +163,35 @@ public:
         value_container_.push(elem);
     }
 
+    /**
+     * @brief Push the tree of a deleted storage. The container takes over the reference
+     * of the storage table.
+     */
+    void push_tree_container(std::tuple<Epoch, tree_instance*> elem) {
+        tree_container_.push(elem);
+    }
+
     static void set_gc_epoch(const Epoch epoch) {
         gc_epoch_.store(epoch, std::memory_order_release);
     }
 
 private:
+    /**
+     * @brief Destroy all nodes and values of the tree of a deleted storage.
+     * @details No session refers the tree any more, since the sessions which found the
+     * storage before the deletion already left, and the later ones can't find it.
+     * Storage handles may still hold the tree instance itself.
+     */
+    static void destroy_tree(tree_instance* ti) {
+        base_node* root = ti->load_root_ptr();
+        if (root != nullptr) {
+            root->destroy();
+            base_node::delete_node(root);
+            ti->store_root_ptr(nullptr);
+        }
+        if (ti->release_ref()) { delete ti; } // NOLINT
+    }
+
     static constexpr std::size_t gc_epoch_index = 0;
     static constexpr std::size_t gc_target_index = 1;
     static constexpr std::size_t gc_target_size_index = 2;
@@ -136,6 +205,10 @@ private:
                                    static_cast<std::align_val_t>(0)}; // NOLINT
     concurrent_queue<std::tuple<Epoch, void*, std::size_t, std::align_val_t>>
             value_container_; // NOLINT
+    std::tuple<Epoch, tree_instance*> cache_tree_container_{0, nullptr}; // NOLINT
+    concurrent_queue<std::tuple<Epoch, tree_instance*>>
+            tree_container_; // NOLINT
+    value_pool value_pool_;  // NOLINT
 };
 
 } // namespace yakushima
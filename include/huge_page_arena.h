@@ -0,0 +1,172 @@
+/**
+ * @file huge_page_arena.h
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#ifdef YAKUSHIMA_LINUX
+#include <sys/mman.h>
+#endif
+
+#include "config.h"
+#include "numa.h"
+
+namespace yakushima {
+
+/**
+ * @brief The region of virtual memory from which the nodes and the small values are
+ * allocated, backed by huge pages where the kernel provides them.
+ * @details The region of YAKUSHIMA_HUGE_PAGE_ARENA_SIZE bytes is reserved at once without
+ * committing the memory, and the kernel is advised to back it with huge pages, which
+ * reduces the TLB misses of a large tree. If the kernel doesn't provide huge pages, the
+ * region is backed by normal pages. The blocks are carved from it in order and not
+ * returned to the kernel; the node and value pools reuse them. When the region is
+ * exhausted or it can't be reserved, allocate returns nullptr and the callers use the
+ * heap. The region is kept until the process exits, as the pools may keep its blocks.
+ * The region is split into a part for each NUMA node, whose pages are placed by the
+ * numa_policy of enable, and the pools keep the released blocks of each part apart. The
+ * parts and the lists of the pools are indexed by the index of the node of numa_nodes.
+ */
+class huge_page_arena {
+public:
+    static constexpr std::size_t kHugePageSize = 2UL * 1024 * 1024;
+
+    /**
+     * @brief Reserve the region if it is not reserved, and allocate from it after this.
+     * @param[in] policy The placement of the pages which are not touched yet.
+     * @return Whether the region is available.
+     */
+    static bool enable(const numa_policy policy = numa_policy::NONE) {
+        std::lock_guard<std::mutex> lk{mtx_};
+        if (base_.load(std::memory_order_relaxed) == 0 && !reserve()) {
+            return false;
+        }
+        const std::uintptr_t base = base_.load(std::memory_order_relaxed);
+        for (std::size_t node = 0; node < part_num_; ++node) {
+            bind_numa(reinterpret_cast<void*>(base + node * part_size_), // NOLINT
+                      part_size_, policy, node);
+        }
+        enabled_.store(true, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Allocate from the heap after this. The blocks of the region are still
+     * released to the pools.
+     */
+    static void disable() { enabled_.store(false, std::memory_order_release); }
+
+    [[nodiscard]] static bool is_enabled() {
+        return enabled_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @param[in] node The index of the NUMA node whose part it allocates from.
+     * @return The block of @a size bytes aligned to @a align, or nullptr if the arena is
+     * disabled or the part is exhausted.
+     */
+    [[nodiscard]] static void* allocate(const std::size_t size,
+                                        const std::size_t align,
+                                        const std::size_t node = 0) {
+        if (!is_enabled()) { return nullptr; }
+        const std::size_t part = node < part_num_ ? node : 0;
+        const std::uintptr_t base =
+                base_.load(std::memory_order_acquire) + part * part_size_;
+        std::atomic<std::size_t>& part_used = used_.at(part);
+        std::size_t used = part_used.load(std::memory_order_relaxed);
+        for (;;) {
+            const std::size_t begin = (base + used + align - 1) / align * align - base;
+            if (begin + size > part_size_) { return nullptr; }
+            if (part_used.compare_exchange_weak(used, begin + size,
+                                                std::memory_order_relaxed)) {
+                return reinterpret_cast<void*>(base + begin); // NOLINT
+            }
+        }
+    }
+
+    /**
+     * @return The index of the NUMA node of the caller, whose part it allocates from, or 0
+     * without looking it up if the arena is disabled.
+     */
+    [[nodiscard]] static std::size_t local_node() {
+        return is_enabled() ? current_numa_node() : 0;
+    }
+
+    /**
+     * @return The index of the NUMA node of the part which has @a ptr, or 0 if the arena
+     * is disabled or @a ptr is not in the region, which is the index of the lists of the
+     * pools.
+     */
+    [[nodiscard]] static std::size_t list_of(const void* const ptr) {
+        return is_enabled() && contains(ptr) ? node_of(ptr) : 0;
+    }
+
+    /**
+     * @return Whether @a ptr was allocated from the region.
+     */
+    [[nodiscard]] static bool contains(const void* const ptr) {
+        const std::uintptr_t base = base_.load(std::memory_order_acquire);
+        const auto addr = reinterpret_cast<std::uintptr_t>(ptr); // NOLINT
+        return base != 0 && base <= addr && addr < base + part_num_ * part_size_;
+    }
+
+    /**
+     * @pre contains(@a ptr)
+     * @return The index of the NUMA node of the part which has @a ptr.
+     */
+    [[nodiscard]] static std::size_t node_of(const void* const ptr) {
+        const std::uintptr_t base = base_.load(std::memory_order_acquire);
+        return (reinterpret_cast<std::uintptr_t>(ptr) - base) / part_size_; // NOLINT
+    }
+
+private:
+    /**
+     * @pre mtx_ is locked.
+     */
+    static bool reserve() {
+#ifdef YAKUSHIMA_LINUX
+        // the extra huge page aligns the region to the huge pages.
+        constexpr std::size_t map_size =
+                YAKUSHIMA_HUGE_PAGE_ARENA_SIZE + kHugePageSize;
+        void* map = mmap(nullptr, map_size, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (map == MAP_FAILED) { return false; } // NOLINT
+        auto addr = reinterpret_cast<std::uintptr_t>(map); // NOLINT
+        std::uintptr_t base =
+                (addr + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+        // it falls back to normal pages if the kernel doesn't support huge pages.
+        madvise(reinterpret_cast<void*>(base), // NOLINT
+                YAKUSHIMA_HUGE_PAGE_ARENA_SIZE, MADV_HUGEPAGE);
+        part_num_ = numa_node_num();
+        part_size_ = YAKUSHIMA_HUGE_PAGE_ARENA_SIZE / part_num_ / kHugePageSize *
+                     kHugePageSize;
+        base_.store(base, std::memory_order_release);
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    static inline std::mutex mtx_{};                   // NOLINT
+    static inline std::atomic<bool> enabled_{false};   // NOLINT
+    static inline std::atomic<std::uintptr_t> base_{0}; // NOLINT
+    /**
+     * @brief The number and the size of the parts, which are fixed before base_ is set.
+     */
+    static inline std::size_t part_num_{1};            // NOLINT
+    static inline std::size_t part_size_{0};           // NOLINT
+    /**
+     * @brief The bytes which each part allocated.
+     */
+    static inline std::array<std::atomic<std::size_t>, // NOLINT
+                             YAKUSHIMA_MAX_NUMA_NODES>
+            used_{};
+};
+
+} // namespace yakushima
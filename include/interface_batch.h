@@ -0,0 +1,170 @@
+/**
+ * @file interface_batch.h
+ */
+
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+#include "common_helper.h"
+#include "interface_put.h"
+#include "interface_remove.h"
+#include "storage_handle.h"
+#include "storage_impl.h"
+#include "tree_instance.h"
+
+namespace yakushima {
+
+/**
+ * @details The batch is applied node by node. It locks the border node of an entry once,
+ * and applies the following entries which the node covers under the same lock. An entry
+ * which needs a split, a removal of the node, or a new layer ends the run of the node
+ * and it is applied by the normal path.
+ */
+template<class ValueType>
+[[maybe_unused]] static void
+apply_batch(Token token, tree_instance* ti,
+            const std::vector<batch_entry<ValueType>>& batch,
+            std::vector<status>& rets) {
+    constexpr auto kIsInline = is_inlinable<ValueType>();
+    auto* thin = reinterpret_cast<thread_info*>(token); // NOLINT
+    rets.assign(batch.size(), status::OK);
+    border_node* border{};
+    // the key prefix which leads to the layer of border.
+    std::string_view prefix{};
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        const batch_entry<ValueType>& entry = batch[i];
+        bool descended{false};
+    retry_entry:
+        if (border == nullptr) {
+            std::size_t prefix_length{};
+            border = lock_border_of(ti, entry.key, prefix_length);
+            if (border == nullptr) {
+                // the normal path
+                if (entry.op == batch_op::PUT) {
+                    rets[i] = put(token, ti, entry.key, entry.value_ptr, false,
+                                  entry.value_length,
+                                  static_cast<ValueType**>(nullptr),
+                                  entry.value_align);
+                } else {
+                    rets[i] = remove(token, ti, entry.key);
+                }
+                continue;
+            }
+            prefix = entry.key.substr(0, prefix_length);
+            descended = true;
+        } else if (!prefix.empty() &&
+                   (entry.key.size() <= prefix.size() ||
+                    entry.key.compare(0, prefix.size(), prefix) != 0)) {
+            // another layer
+            border->version_unlock();
+            border = nullptr;
+            goto retry_entry; // NOLINT
+        }
+        std::string_view traverse_key_view{entry.key};
+        traverse_key_view.remove_prefix(prefix.size());
+        key_slice_type key_slice = make_key_slice(traverse_key_view);
+        key_length_type key_length{};
+        if (traverse_key_view.size() > sizeof(key_slice_type)) {
+            key_length = sizeof(key_slice_type) + 1;
+        } else {
+            key_length = traverse_key_view.size();
+        }
+        link_or_value* lv_ptr =
+                border->get_lv_of_without_lock(key_slice, key_length);
+        /**
+         * The entry which descended belongs to this node. A following entry belongs to it
+         * if the node has the key or covers it.
+         */
+        if ((lv_ptr == nullptr && !descended &&
+             !border->covers(key_slice, key_length)) ||
+            (lv_ptr != nullptr && lv_ptr->get_next_layer() != nullptr)) {
+            // the key is in another node or in the next layer.
+            border->version_unlock();
+            border = nullptr;
+            goto retry_entry; // NOLINT
+        }
+        std::string_view rest{traverse_key_view};
+        if (key_length > sizeof(key_slice_type)) {
+            rest.remove_prefix(sizeof(key_slice_type));
+        }
+        if (entry.op == batch_op::PUT) {
+            if (lv_ptr == nullptr) {
+                value_pool* pool = &thin->get_gc_info().get_value_pool();
+                value* v = value::create_value<kIsInline>(
+                        entry.value_ptr, entry.value_length, entry.value_align,
+                        pool);
+                std::size_t rank = border->compute_rank_if_insert(
+                        key_slice, key_length);
+                std::size_t cnk = border->get_permutation_cnk();
+                if (cnk == 0 || cnk == key_slice_length) {
+                    // it may split the node, and it unlocks the node.
+                    insert_lv(ti, border, traverse_key_view, v, nullptr,
+                              nullptr, rank, pool);
+                    border = nullptr;
+                    continue;
+                }
+                border->set_version_inserting_deleting(true);
+                border->insert_lv_at(border->get_permutation().get_empty_slot(),
+                                     traverse_key_view, v, nullptr, rank, pool);
+                continue;
+            }
+            if (lv_ptr->get_key_suffix() != nullptr &&
+                lv_ptr->get_key_suffix()->get_view() != rest) {
+                // two keys share the key slice, so it needs the next layer.
+                border->version_unlock();
+                border = nullptr;
+                rets[i] = put(token, ti, entry.key, entry.value_ptr, false,
+                              entry.value_length,
+                              static_cast<ValueType**>(nullptr),
+                              entry.value_align);
+                continue;
+            }
+            value* v = value::create_value<kIsInline>(
+                    entry.value_ptr, entry.value_length, entry.value_align,
+                    &thin->get_gc_info().get_value_pool());
+            border->replace_value_keeping_lock(token, lv_ptr, v, nullptr);
+            continue;
+        }
+        // batch_op::REMOVE
+        if (lv_ptr == nullptr || (lv_ptr->get_key_suffix() != nullptr &&
+                                  lv_ptr->get_key_suffix()->get_view() != rest)) {
+            rets[i] = status::OK_NOT_FOUND;
+            continue;
+        }
+        if (border->get_permutation_cnk() == 1) {
+            // the node becomes empty, and it unlocks the node.
+            border->delete_of<true>(token, ti, key_slice, key_length);
+            border = nullptr;
+            continue;
+        }
+        border->delete_value_keeping_lock(token, key_slice, key_length);
+    }
+    if (border != nullptr) { border->version_unlock(); }
+}
+
+template<class ValueType>
+[[maybe_unused]] static status
+apply_batch(Token token, std::string_view storage_name, // NOLINT
+            const std::vector<batch_entry<ValueType>>& batch,
+            std::vector<status>& rets) {
+    tree_instance* ti{};
+    status ret{storage::find_storage(storage_name, &ti)};
+    if (status::OK != ret) { return status::WARN_STORAGE_NOT_EXIST; }
+    apply_batch(token, ti, batch, rets);
+    return status::OK;
+}
+
+template<class ValueType>
+[[maybe_unused]] static status
+apply_batch(Token token, const storage_handle& storage, // NOLINT
+            const std::vector<batch_entry<ValueType>>& batch,
+            std::vector<status>& rets) {
+    tree_instance* ti{storage.get()};
+    if (ti == nullptr) { return status::WARN_STORAGE_NOT_EXIST; }
+    apply_batch(token, ti, batch, rets);
+    return status::OK;
+}
+
+} // namespace yakushima
@@ -0,0 +1,347 @@
+/**
+ * @file interface_bulk_load.h
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "border_node.h"
+#include "interior_node.h"
+#include "key_suffix.h"
+#include "storage_handle.h"
+#include "storage_impl.h"
+#include "thread_info.h"
+#include "tree_instance.h"
+#include "value.h"
+#include "value_pool.h"
+
+namespace yakushima {
+
+/**
+ * @brief It builds a tree from sorted key-values bottom-up, without the splits of put.
+ * @details It fills border nodes from the left, links them, and builds the interior
+ * levels over them. Keys which share a key slice and are longer than it make the next
+ * layer, which is built the same way. The nodes are not visible until the caller
+ * publishes the root, so it doesn't lock them. The values and the key suffixes are
+ * allocated from the value pool of the session of each building thread.
+ */
+template<class ValueType>
+class bulk_loader {
+public:
+    using entry_type = std::tuple<std::string_view, ValueType*, std::size_t>;
+
+    /**
+     * @pre The keys of @a entries are sorted and unique.
+     * @param[in] entries
+     * @param[in] fill_factor The ratio of the slots of a node which it fills, in (0, 1].
+     * @param[in] value_align The alignment of the values.
+     */
+    bulk_loader(const std::vector<entry_type>& entries, const double fill_factor,
+                const value_align_type value_align)
+        : entries_(entries), value_align_(value_align),
+          border_fill_(std::max<std::size_t>(
+                  1, static_cast<std::size_t>(fill_factor * key_slice_length))),
+          interior_fill_(std::max<std::size_t>(
+                  2, static_cast<std::size_t>(fill_factor *
+                                              interior_node::child_length))) {}
+
+    /**
+     * @param[in] parallelism The number of threads which build the border nodes of the
+     * first layer and the layers under them.
+     * @param[in] pool The value pool of the session of the caller. The other threads
+     * enter their own sessions for their pools.
+     * @return The root of the tree.
+     */
+    [[nodiscard]] base_node* build(const std::size_t parallelism,
+                                   value_pool* const pool) {
+        return build_layer(0, entries_.size(), 0, parallelism, pool);
+    }
+
+private:
+    /**
+     * @brief A key of a layer: a key-value, or the key-values under a next layer.
+     */
+    struct item {
+        key_slice_type key_slice{};
+        key_length_type key_length{};
+        // the range of the entries of this item.
+        std::size_t begin{};
+        std::size_t end{};
+    };
+
+    /**
+     * @brief A node of a level and its lowest key, which is the separator in the parent.
+     */
+    struct level_node {
+        base_node* node{};
+        key_slice_type key_slice{};
+        key_length_type key_length{};
+    };
+
+    /**
+     * @return The sizes of the nodes which share @a num elements evenly, when a node
+     * takes at most @a fill elements and at least @a min_size elements.
+     */
+    static std::vector<std::size_t> split_sizes(const std::size_t num,
+                                                const std::size_t fill,
+                                                const std::size_t min_size) {
+        std::size_t node_num = (num + fill - 1) / fill;
+        node_num = std::max<std::size_t>(1, std::min(node_num, num / min_size));
+        std::vector<std::size_t> sizes(node_num, num / node_num);
+        for (std::size_t i = 0; i < num % node_num; ++i) { ++sizes[i]; }
+        return sizes;
+    }
+
+    [[nodiscard]] std::vector<item> make_items(const std::size_t begin,
+                                               const std::size_t end,
+                                               const std::size_t depth) const {
+        std::vector<item> items{};
+        const std::size_t offset = depth * sizeof(key_slice_type);
+        for (std::size_t i = begin; i < end; ++i) {
+            std::string_view rest{std::get<0>(entries_[i])};
+            rest.remove_prefix(offset);
+            key_slice_type key_slice = make_key_slice(rest);
+            key_length_type key_length{};
+            if (rest.size() > sizeof(key_slice_type)) {
+                key_length = sizeof(key_slice_type) + 1;
+            } else {
+                key_length = rest.size();
+            }
+            if (!items.empty() && items.back().key_slice == key_slice &&
+                items.back().key_length == key_length &&
+                key_length > sizeof(key_slice_type)) {
+                // it shares the key slice, so it goes to the next layer.
+                items.back().end = i + 1;
+                continue;
+            }
+            items.push_back({key_slice, key_length, i, i + 1});
+        }
+        return items;
+    }
+
+    [[nodiscard]] border_node* build_border(const item* const items,
+                                            const std::size_t num,
+                                            const std::size_t depth,
+                                            value_pool* const pool) const {
+        constexpr auto kIsInline = is_inlinable<ValueType>();
+        auto* border = new border_node(); // NOLINT
+        border->init_border();
+        border->set_version_root(false);
+        for (std::size_t i = 0; i < num; ++i) {
+            const item& it = items[i];
+            border->set_key_slice_at(i, it.key_slice);
+            border->set_key_length_at(i, it.key_length);
+            if (it.end - it.begin > 1) {
+                base_node* next_layer =
+                        build_layer(it.begin, it.end, depth + 1, 1, pool);
+                next_layer->set_parent(border);
+                border->set_lv_next_layer(i, next_layer);
+                continue;
+            }
+            const auto& [key, v_ptr, v_len] = entries_[it.begin];
+            if (it.key_length > sizeof(key_slice_type)) {
+                border->get_lv_at(i)->set_key_suffix(key_suffix::create_key_suffix(
+                        key.substr((depth + 1) * sizeof(key_slice_type)), pool));
+            }
+            border->set_lv_value(i,
+                                 value::create_value<kIsInline>(v_ptr, v_len,
+                                                                value_align_, pool),
+                                 nullptr);
+        }
+        border->get_permutation().split_dest(num);
+        return border;
+    }
+
+    [[nodiscard]] base_node* build_layer(const std::size_t begin,
+                                         const std::size_t end,
+                                         const std::size_t depth,
+                                         const std::size_t parallelism,
+                                         value_pool* const pool) const {
+        std::vector<item> items = make_items(begin, end, depth);
+        std::vector<std::size_t> sizes = split_sizes(items.size(), border_fill_, 1);
+        std::vector<level_node> level(sizes.size());
+        std::vector<std::size_t> starts(sizes.size());
+        for (std::size_t i = 1; i < sizes.size(); ++i) {
+            starts[i] = starts[i - 1] + sizes[i - 1];
+        }
+        auto process = [this, depth, &items, &sizes, &starts,
+                        &level](std::size_t first, std::size_t last,
+                                value_pool* const th_pool) {
+            for (std::size_t i = first; i < last; ++i) {
+                const item& low = items[starts[i]];
+                level[i] = {build_border(&items[starts[i]], sizes[i], depth, th_pool),
+                            low.key_slice, low.key_length};
+            }
+        };
+        std::size_t th_num = std::min(parallelism, level.size());
+        /**
+         * The pool of a session is not shared, so each of the other threads uses a session
+         * of its own. They are as many as the free sessions, so that this never waits for
+         * a session.
+         */
+        std::vector<Token> tokens{};
+        while (tokens.size() + 1 < th_num) {
+            Token token{};
+            if (enter(token) != status::OK) { break; }
+            tokens.emplace_back(token);
+        }
+        th_num = tokens.size() + 1;
+        std::vector<std::thread> th_vc{};
+        for (std::size_t i = 1; i < th_num; ++i) {
+            auto* tinfo = reinterpret_cast<thread_info*>(tokens[i - 1]); // NOLINT
+            th_vc.emplace_back(process, level.size() * i / th_num,
+                               level.size() * (i + 1) / th_num,
+                               &tinfo->get_gc_info().get_value_pool());
+        }
+        process(0, level.size() / th_num, pool);
+        for (auto&& th : th_vc) { th.join(); }
+        for (auto&& token : tokens) { leave(token); }
+        for (std::size_t i = 1; i < level.size(); ++i) {
+            auto* left = static_cast<border_node*>(level[i - 1].node);
+            auto* right = static_cast<border_node*>(level[i].node);
+            left->set_next(right);
+            right->set_prev(left);
+        }
+        return build_interior_levels(level);
+    }
+
+    /**
+     * @return The root of the layer which has the nodes of @a level at the bottom.
+     */
+    [[nodiscard]] base_node*
+    build_interior_levels(std::vector<level_node> level) const {
+        while (level.size() > 1) {
+            std::vector<std::size_t> sizes =
+                    split_sizes(level.size(), interior_fill_, 2);
+            std::vector<level_node> upper{};
+            std::size_t pos{0};
+            for (auto size : sizes) {
+                auto* interior = new interior_node(); // NOLINT
+                interior->init_interior();
+                for (std::size_t i = 0; i < size; ++i) {
+                    const level_node& child = level[pos + i];
+                    interior->set_child_at(i, child.node);
+                    child.node->set_parent(interior);
+                    if (i > 0) {
+                        interior->set_key(i - 1, child.key_slice,
+                                          child.key_length);
+                    }
+                }
+                interior->set_n_keys(
+                        static_cast<interior_node::n_keys_body_type>(size - 1));
+                upper.push_back(
+                        {interior, level[pos].key_slice, level[pos].key_length});
+                pos += size;
+            }
+            level.swap(upper);
+        }
+        level.front().node->set_version_root(true);
+        return level.front().node;
+    }
+
+    const std::vector<entry_type>& entries_;
+    const value_align_type value_align_;
+    /**
+     * @brief the number of keys of a border node.
+     */
+    const std::size_t border_fill_;
+    /**
+     * @brief the number of children of an interior node.
+     */
+    const std::size_t interior_fill_;
+};
+
+template<class ValueType>
+[[maybe_unused]] static status bulk_load(
+        Token token, tree_instance* ti,
+        const std::vector<std::tuple<std::string_view, ValueType*, std::size_t>>&
+                entries,
+        const double fill_factor, const std::size_t parallelism,
+        const value_align_type value_align) {
+    if (!(fill_factor > 0 && fill_factor <= 1) || parallelism == 0) {
+        return status::ERR_BAD_USAGE;
+    }
+    for (std::size_t i = 1; i < entries.size(); ++i) {
+        if (!(std::get<0>(entries[i - 1]) < std::get<0>(entries[i]))) {
+            return status::ERR_BAD_USAGE;
+        }
+    }
+    /**
+     * A new storage has an empty border node as the root, which may also be left by
+     * removes.
+     */
+    auto* old_root = static_cast<border_node*>(ti->load_root_ptr());
+    if (old_root != nullptr && (!old_root->get_version_border() ||
+                                old_root->get_permutation_cnk() != 0)) {
+        return status::WARN_EXIST;
+    }
+    if (entries.empty()) { return status::OK; }
+
+    auto* tinfo = reinterpret_cast<thread_info*>(token); // NOLINT
+    base_node* root = bulk_loader<ValueType>(entries, fill_factor, value_align)
+                              .build(parallelism,
+                                     &tinfo->get_gc_info().get_value_pool());
+    auto discard = [root] {
+        root->destroy();
+        base_node::delete_node(root);
+        return status::WARN_EXIST;
+    };
+    if (old_root == nullptr) {
+        base_node* expected{nullptr};
+        if (!ti->cas_root_ptr(&expected, &root)) { return discard(); }
+        return status::OK;
+    }
+    old_root->lock();
+    ti->root_lock();
+    if (ti->load_root_ptr() != old_root || old_root->get_permutation_cnk() != 0) {
+        // another session put a key meanwhile.
+        ti->root_unlock();
+        old_root->version_unlock();
+        return discard();
+    }
+    ti->store_root_ptr(root);
+    ti->root_unlock();
+    /**
+     * The sessions which reached the old root retry from the root, as they do for a
+     * removed node.
+     */
+    old_root->set_version_root(false);
+    old_root->set_version_deleted(true);
+    old_root->version_unlock();
+    tinfo->get_gc_info().push_node_container({tinfo->get_begin_epoch(), old_root});
+    return status::OK;
+}
+
+template<class ValueType>
+[[maybe_unused]] static status bulk_load(
+        Token token, std::string_view storage_name, // NOLINT
+        const std::vector<std::tuple<std::string_view, ValueType*, std::size_t>>&
+                entries,
+        const double fill_factor = 1.0, const std::size_t parallelism = 1,
+        const value_align_type value_align =
+                static_cast<value_align_type>(alignof(ValueType))) {
+    tree_instance* ti{};
+    status ret{storage::find_storage(storage_name, &ti)};
+    if (status::OK != ret) { return status::WARN_STORAGE_NOT_EXIST; }
+    return bulk_load(token, ti, entries, fill_factor, parallelism, value_align);
+}
+
+template<class ValueType>
+[[maybe_unused]] static status bulk_load(
+        Token token, const storage_handle& storage, // NOLINT
+        const std::vector<std::tuple<std::string_view, ValueType*, std::size_t>>&
+                entries,
+        const double fill_factor = 1.0, const std::size_t parallelism = 1,
+        const value_align_type value_align =
+                static_cast<value_align_type>(alignof(ValueType))) {
+    tree_instance* ti{storage.get()};
+    if (ti == nullptr) { return status::WARN_STORAGE_NOT_EXIST; }
+    return bulk_load(token, ti, entries, fill_factor, parallelism, value_align);
+}
+
+} // namespace yakushima
@@ -18,22 +18,28 @@ namespace yakushima {
 
 [[maybe_unused]] static status destroy() {
     if (storage::get_storages()->empty()) { return status::OK_ROOT_IS_NULL; }
-    std::vector<std::tuple<std::string, tree_instance*, std::size_t>>
+    std::vector<std::tuple<std::string, tree_instance**, std::size_t>>
             tuple_list;
     scan(storage::get_storages(), "", scan_endpoint::INF, "",
          scan_endpoint::INF, tuple_list, nullptr, 0);
     for (auto&& elem : tuple_list) {
-        base_node* root = std::get<1>(elem)->load_root_ptr();
-        if (root == nullptr) { continue; }
-        root->destroy();
-        delete root; // NOLINT
-        std::get<1>(elem)->store_root_ptr(nullptr);
+        // the pointer is an inline value.
+        auto* ti = reinterpret_cast<tree_instance*>(std::get<1>(elem)); // NOLINT
+        ti->set_dropped();
+        base_node* root = ti->load_root_ptr();
+        if (root != nullptr) {
+            root->destroy();
+            base_node::delete_node(root);
+            ti->store_root_ptr(nullptr);
+        }
+        // storage handles may still hold it.
+        if (ti->release_ref()) { delete ti; } // NOLINT
     }
 
     base_node* tables_root = storage::get_storages()->load_root_ptr();
     if (tables_root != nullptr) {
         tables_root->destroy();
-        delete tables_root; // NOLINT
+        base_node::delete_node(tables_root);
         storage::get_storages()->store_root_ptr(nullptr);
     }
     return status::OK_DESTROY_ALL;
@@ -51,18 +51,21 @@ static void display_border(std::stringstream& ss, border_node* n,
         key_slice_type ks = n->get_key_slice_at(index);
         key_length_type kl = n->get_key_length_at(index);
         std::string key{};
-        if (kl > 0) {
-            if (kl > sizeof(key_slice_type)) {
-                key = std::string(reinterpret_cast<char*>(&ks), // NOLINT
-                                  sizeof(key_slice_type));
-            } else {
-                key = std::string(reinterpret_cast<char*>(&ks), kl); // NOLINT
-            }
+        append_key_slice(key, ks, kl);
+        base_node* next_layer{n->get_lv_at(index)->get_next_layer()};
+        if (key_suffix* suffix{n->get_lv_at(index)->get_key_suffix()};
+            kl > sizeof(key_slice_type) && next_layer == nullptr &&
+            suffix != nullptr) {
+            // the value has a key suffix.
+            key.append(suffix->get_view());
+            ss << "((" << display_printstr(key_prefix + key) << ","
+               << std::to_string(key.size() + key_prefix.size()) << "),";
+        } else {
+            ss << "((" << display_printstr(key_prefix + key) << ","
+               << std::to_string(n->get_key_length_at(index) + key_prefix.size())
+               << "),";
         }
-        ss << "((" << display_printstr(key_prefix + key) << ","
-           << std::to_string(n->get_key_length_at(index) + key_prefix.size())
-           << "),";
-        if (kl > sizeof(key_slice_type)) {
+        if (kl > sizeof(key_slice_type) && next_layer != nullptr) {
             ss << n->get_lv_at(index)->get_next_layer();
         } else if (!value::is_value_ptr(value_ptr)) { // inlined value
             ss << value_ptr;
@@ -90,19 +93,12 @@ static void display_border(std::stringstream& ss, border_node* n,
         std::size_t index = perm.get_index_of_rank(i);
         link_or_value* lv = n->get_lv_at(index);
         base_node* next_layer = lv->get_next_layer();
-        if (n->get_key_length_at(index) > sizeof(key_slice_type)) {
+        if (n->get_key_length_at(index) > sizeof(key_slice_type) &&
+            next_layer != nullptr) {
             key_slice_type ks = n->get_key_slice_at(index);
             key_length_type kl = n->get_key_length_at(index);
             std::string key{};
-            if (kl > 0) {
-                if (kl > sizeof(key_slice_type)) {
-                    key = std::string(reinterpret_cast<char*>(&ks), // NOLINT
-                                      sizeof(key_slice_type));
-                } else {
-                    key = std::string(reinterpret_cast<char*>(&ks), // NOLINT
-                                      kl);
-                }
-            }
+            append_key_slice(key, ks, kl);
             std::string new_prefix{key_prefix + key};
             display_node(ss, next_layer, new_prefix);
         }
@@ -117,9 +113,7 @@ static void display_interior(std::stringstream& ss, interior_node* n,
         key_slice_type ks = n->get_key_slice_at(i);
         key_length_type kl = n->get_key_length_at(i);
         std::string key{};
-        if (kl > 0) {
-            key = std::string(reinterpret_cast<char*>(&ks), kl); // NOLINT
-        }
+        append_key_slice(key, ks, kl);
         ss << n->get_child_at(i) << "," << display_printstr(key_prefix + key) << ",";
     }
     ss << n->get_child_at(n->get_n_keys()) << "\n";
@@ -133,9 +127,9 @@ static void display_node(std::stringstream& ss, base_node* n,
     auto* ver = n->get_version_ptr();
     auto verb = ver->get_stable_version();
     if (verb.get_border()) {
-        display_border(ss, dynamic_cast<border_node*>(n), key_prefix);
+        display_border(ss, static_cast<border_node*>(n), key_prefix);
     } else {
-        display_interior(ss, dynamic_cast<interior_node*>(n), key_prefix);
+        display_interior(ss, static_cast<interior_node*>(n), key_prefix);
     }
 }
 
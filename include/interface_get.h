@@ -4,24 +4,39 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <string>
+#include <vector>
 
 #include "base_node.h"
 #include "border_node.h"
 #include "common_helper.h"
+#include "cursor_hint.h"
 #include "kvs.h"
 #include "link_or_value.h"
+#include "storage_handle.h"
 #include "storage_impl.h"
 #include "tree_instance.h"
 
 namespace yakushima {
 
+/**
+ * @param[in] start The border node of the first layer which the caller found for the key,
+ * and its stable version. If it is not nullptr, it skips the first descent like a hint.
+ * @param[out] found The border node which has the value and its version at the final
+ * check, when the key is found.
+ */
 template<class ValueType>
 [[maybe_unused]] static status
 get(tree_instance* ti, std::string_view key_view,
     std::pair<ValueType*, std::size_t>& out,
     std::pair<node_version64_body, node_version64*>* checked_version =
-            nullptr) {
+            nullptr,
+    cursor_hint* hint = nullptr,
+    std::tuple<border_node*, node_version64_body> start = {nullptr, {}},
+    std::tuple<border_node*, node_version64_body>* found = nullptr) {
     // init
     if (checked_version != nullptr) {
         checked_version->second = nullptr;
@@ -31,21 +46,23 @@ retry_from_root:
     base_node* root = ti->load_root_ptr();
     if (root == nullptr) { return status::WARN_NOT_EXIST; }
     std::string_view traverse_key_view{key_view};
+    node_version64_body hinted_v{std::get<1>(start)};
+    border_node* hinted_border =
+            hint != nullptr ? hint->find_border(ti, key_view, traverse_key_view,
+                                                hinted_v)
+                            : std::get<0>(start);
+    // the retry doesn't use the start again.
+    std::get<0>(start) = nullptr;
 
 retry_find_border:
     /**
      * prepare key_slice
      */
-    key_slice_type key_slice(0);
+    key_slice_type key_slice = make_key_slice(traverse_key_view);
     key_length_type key_slice_length{};
     if (traverse_key_view.size() > sizeof(key_slice_type)) {
-        memcpy(&key_slice, traverse_key_view.data(), sizeof(key_slice_type));
         key_slice_length = sizeof(key_slice_type) + 1;
     } else {
-        if (!traverse_key_view.empty()) {
-            memcpy(&key_slice, traverse_key_view.data(),
-                   traverse_key_view.size());
-        }
         key_slice_length = traverse_key_view.size();
     }
 
@@ -53,17 +70,26 @@ retry_find_border:
      * traverse tree to border node.
      */
     status special_status{status::OK};
-    if (root == nullptr) {
-        LOG(ERROR) << log_location_prefix << "unexpected process.";
-    }
-    std::tuple<border_node*, node_version64_body> node_and_v =
-            find_border(root, key_slice, key_slice_length, special_status);
-    if (special_status == status::WARN_RETRY_FROM_ROOT_OF_ALL) {
-        /**
-         * @a root is the root node of the some layer, but it was deleted.
-         * So it must retry from root of the all tree.
-         */
-        goto retry_from_root; // NOLINT
+    std::tuple<border_node*, node_version64_body> node_and_v{hinted_border,
+                                                              hinted_v};
+    if (hinted_border != nullptr) {
+        // the hint skips the descent. It is used only once.
+        hinted_border = nullptr;
+        // the root of the layer is unknown.
+        root = nullptr;
+    } else {
+        if (root == nullptr) {
+            LOG(ERROR) << log_location_prefix << "unexpected process.";
+        }
+        node_and_v = find_border(root, key_slice, key_slice_length,
+                                 special_status);
+        if (special_status == status::WARN_RETRY_FROM_ROOT_OF_ALL) {
+            /**
+             * @a root is the root node of the some layer, but it was deleted.
+             * So it must retry from root of the all tree.
+             */
+            goto retry_from_root; // NOLINT
+        }
     }
     constexpr std::size_t tuple_node_index = 0;
     constexpr std::size_t tuple_v_index = 1;
@@ -84,13 +110,18 @@ retry_fetch_lv:
          * The correct border was changed between atomically fetching border node and
          * atomically fetching lv.
          */
-        goto retry_from_root; // NOLINT
+        YAKUSHIMA_RECOVER_BORDER(target_border, v_at_fb, root, key_slice, // NOLINT
+                                 key_slice_length);
     }
     if (lv_ptr == nullptr) {
         if (checked_version != nullptr) {
             checked_version->first = v_at_fetch_lv;
             checked_version->second = target_border->get_version_ptr();
         }
+        if (hint != nullptr) {
+            hint->remember(ti, key_view, traverse_key_view, target_border,
+                           v_at_fb);
+        }
         return status::WARN_NOT_EXIST;
     }
 
@@ -100,26 +131,70 @@ retry_fetch_lv:
         node_version64_body final_check = target_border->get_stable_version();
         if (final_check.get_vsplit() != v_at_fb.get_vsplit() ||
             (final_check.get_deleted() && !final_check.get_root())) {
-            goto retry_from_root; // NOLINT
+            YAKUSHIMA_RECOVER_BORDER(target_border, v_at_fb, root, key_slice, // NOLINT
+                                     key_slice_length);
         }
         if (final_check.get_vinsert_delete() !=
             v_at_fetch_lv.get_vinsert_delete()) {
             goto retry_fetch_lv; // NOLINT
         }
         out = std::make_pair(v_body, value::get_len(vp));
+        if (found != nullptr) { *found = {target_border, final_check}; }
+        if (hint != nullptr) {
+            hint->remember(ti, key_view, traverse_key_view, target_border,
+                           v_at_fb);
+        }
         return status::OK;
     }
 
-    root = lv_ptr->get_next_layer();
+    base_node* next_layer = lv_ptr->get_next_layer();
+    if (next_layer == nullptr) {
+        /**
+         * The value has a key suffix. It is read before the final check, since the lv
+         * may be replaced by the next layer concurrently.
+         */
+        value* vp = lv_ptr->get_value();
+        key_suffix* suffix = lv_ptr->get_key_suffix();
+        std::string_view rest{traverse_key_view};
+        rest.remove_prefix(sizeof(key_slice_type));
+        bool hit = vp != nullptr && suffix != nullptr && suffix->get_view() == rest;
+        node_version64_body final_check = target_border->get_stable_version();
+        if (final_check.get_vsplit() != v_at_fb.get_vsplit() ||
+            (final_check.get_deleted() && !final_check.get_root())) {
+            YAKUSHIMA_RECOVER_BORDER(target_border, v_at_fb, root, key_slice, // NOLINT
+                                     key_slice_length);
+        }
+        if (final_check.get_vinsert_delete() !=
+            v_at_fetch_lv.get_vinsert_delete()) {
+            goto retry_fetch_lv; // NOLINT
+        }
+        if (hint != nullptr) {
+            hint->remember(ti, key_view, traverse_key_view, target_border,
+                           v_at_fb);
+        }
+        if (!hit) {
+            if (checked_version != nullptr) {
+                checked_version->first = v_at_fetch_lv;
+                checked_version->second = target_border->get_version_ptr();
+            }
+            return status::WARN_NOT_EXIST;
+        }
+        out = std::make_pair(static_cast<ValueType*>(value::get_body(vp)),
+                             value::get_len(vp));
+        if (found != nullptr) { *found = {target_border, final_check}; }
+        return status::OK;
+    }
     node_version64_body final_check = target_border->get_stable_version();
     if (final_check.get_vsplit() != v_at_fb.get_vsplit() ||
         (final_check.get_deleted() && !final_check.get_root())) {
-        goto retry_from_root; // NOLINT
+        YAKUSHIMA_RECOVER_BORDER(target_border, v_at_fb, root, key_slice, // NOLINT
+                                 key_slice_length);
     }
     if (final_check.get_vinsert_delete() !=
         v_at_fetch_lv.get_vinsert_delete()) {
         goto retry_fetch_lv; // NOLINT
     }
+    root = next_layer;
     if (root == nullptr) {
         LOG(ERROR) << log_location_prefix << "unexpected process.";
     }
@@ -127,6 +202,44 @@ retry_fetch_lv:
     goto retry_find_border; // NOLINT
 }
 
+/**
+ * @details It finds the border nodes of the first layer for each group of keys by
+ * find_border_group, then gets each key from its border node.
+ */
+template<class ValueType>
+[[maybe_unused]] static void
+get_many(tree_instance* ti, const std::vector<std::string_view>& keys,
+         std::vector<std::pair<ValueType*, std::size_t>>& out,
+         std::vector<status>& rets) {
+    constexpr std::size_t group = YAKUSHIMA_GET_MANY_GROUP;
+    out.assign(keys.size(), {});
+    rets.resize(keys.size());
+    std::array<border_cursor, group> cursors{};
+    for (std::size_t first = 0; first < keys.size(); first += group) {
+        const std::size_t num = std::min(group, keys.size() - first);
+        base_node* root = ti->load_root_ptr();
+        if (root != nullptr) {
+            for (std::size_t i = 0; i < num; ++i) {
+                std::string_view key_view{keys[first + i]};
+                cursors.at(i).key_slice = make_key_slice(key_view);
+                cursors.at(i).key_slice_length =
+                        key_view.size() > sizeof(key_slice_type)
+                                ? sizeof(key_slice_type) + 1
+                                : key_view.size();
+            }
+            find_border_group(root, cursors.data(), num);
+        }
+        for (std::size_t i = 0; i < num; ++i) {
+            border_cursor& c = cursors.at(i);
+            border_node* bn = root != nullptr && c.node != nullptr
+                                      ? static_cast<border_node*>(c.node)
+                                      : nullptr;
+            rets[first + i] = get<ValueType>(ti, keys[first + i], out[first + i],
+                                             nullptr, nullptr, {bn, c.v});
+        }
+    }
+}
+
 template<class ValueType>
 [[maybe_unused]] static status
 get(std::string_view storage_name, std::string_view key_view,
@@ -140,4 +253,109 @@ get(std::string_view storage_name, std::string_view key_view,
     return get<ValueType>(ti, key_view, out, checked_version);
 }
 
+template<class ValueType>
+[[maybe_unused]] static status
+get(Token token, cursor_hint& hint, std::string_view storage_name,
+    std::string_view key_view, std::pair<ValueType*, std::size_t>& out) {
+    tree_instance* ti{};
+    if (status::OK != storage::find_storage(storage_name, &ti)) {
+        return status::WARN_STORAGE_NOT_EXIST;
+    }
+    hint.attach(token);
+    return get<ValueType>(ti, key_view, out, nullptr, &hint);
+}
+
+template<class ValueType>
+[[maybe_unused]] static status
+get(const storage_handle& storage, std::string_view key_view,
+    std::pair<ValueType*, std::size_t>& out,
+    std::pair<node_version64_body, node_version64*>* checked_version =
+            nullptr) {
+    tree_instance* ti{storage.get()};
+    if (ti == nullptr) { return status::WARN_STORAGE_NOT_EXIST; }
+    return get<ValueType>(ti, key_view, out, checked_version);
+}
+
+template<class ValueType>
+[[maybe_unused]] static status
+get(Token token, cursor_hint& hint, const storage_handle& storage,
+    std::string_view key_view, std::pair<ValueType*, std::size_t>& out) {
+    tree_instance* ti{storage.get()};
+    if (ti == nullptr) { return status::WARN_STORAGE_NOT_EXIST; }
+    hint.attach(token);
+    return get<ValueType>(ti, key_view, out, nullptr, &hint);
+}
+
+template<class ValueType>
+[[maybe_unused]] static status
+get_many(std::string_view storage_name, const std::vector<std::string_view>& keys,
+         std::vector<std::pair<ValueType*, std::size_t>>& out,
+         std::vector<status>& rets) {
+    tree_instance* ti{};
+    if (status::OK != storage::find_storage(storage_name, &ti)) {
+        return status::WARN_STORAGE_NOT_EXIST;
+    }
+    get_many<ValueType>(ti, keys, out, rets);
+    return status::OK;
+}
+
+template<class ValueType>
+[[maybe_unused]] static status
+get_many(const storage_handle& storage, const std::vector<std::string_view>& keys,
+         std::vector<std::pair<ValueType*, std::size_t>>& out,
+         std::vector<status>& rets) {
+    tree_instance* ti{storage.get()};
+    if (ti == nullptr) { return status::WARN_STORAGE_NOT_EXIST; }
+    get_many<ValueType>(ti, keys, out, rets);
+    return status::OK;
+}
+
+/**
+ * @details It copies the body which get found, and validates the copy by the version of
+ * the border node, which overwrite and update change while they write the body.
+ */
+template<class ValueType>
+[[maybe_unused]] static status get_copy(tree_instance* ti, std::string_view key_view,
+                                        std::string& out) {
+    constexpr auto kIsInline = is_inlinable<ValueType>();
+    for (;;) {
+        std::pair<ValueType*, std::size_t> body{};
+        std::tuple<border_node*, node_version64_body> found{};
+        status ret = get<ValueType>(ti, key_view, body, nullptr, nullptr,
+                                    {nullptr, {}}, &found);
+        if (ret != status::OK) { return ret; }
+        if constexpr (kIsInline) {
+            // the body of an inline value is the word itself.
+            out.assign(reinterpret_cast<char*>(&body.first), // NOLINT
+                       sizeof(uintptr_t));
+            return status::OK;
+        }
+        out.assign(reinterpret_cast<char*>(body.first), body.second); // NOLINT
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (std::get<0>(found)->get_stable_version() == std::get<1>(found)) {
+            return status::OK;
+        }
+    }
+}
+
+template<class ValueType>
+[[maybe_unused]] static status
+get_copy(std::string_view storage_name, std::string_view key_view, // NOLINT
+         std::string& out) {
+    tree_instance* ti{};
+    if (status::OK != storage::find_storage(storage_name, &ti)) {
+        return status::WARN_STORAGE_NOT_EXIST;
+    }
+    return get_copy<ValueType>(ti, key_view, out);
+}
+
+template<class ValueType>
+[[maybe_unused]] static status
+get_copy(const storage_handle& storage, std::string_view key_view, // NOLINT
+         std::string& out) {
+    tree_instance* ti{storage.get()};
+    if (ti == nullptr) { return status::WARN_STORAGE_NOT_EXIST; }
+    return get_copy<ValueType>(ti, key_view, out);
+}
+
 } // namespace yakushima
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "huge_page_arena.h"
 #include "interface_scan.h"
 #include "kvs.h"
 #include "manager_thread.h"
@@ -19,11 +20,23 @@ namespace yakushima {
     return thread_info_table::leave_thread_info(token);
 }
 
-[[maybe_unused]] static void init() {
+[[maybe_unused]] static std::size_t get_numa_node(Token token) {
+    return numa_node_id(static_cast<thread_info*>(token)->get_numa_node());
+}
+
+[[maybe_unused]] static void
+init(const bool use_huge_page_arena = false,
+     const numa_policy placement = numa_policy::NONE) {
     /**
      * initialize thread information table (kThreadInfoTable)
      */
     thread_info_table::init();
+    if (!use_huge_page_arena) {
+        huge_page_arena::disable();
+    } else if (!huge_page_arena::enable(placement)) {
+        LOG(WARNING) << log_location_prefix
+                     << "the huge page arena is not available, so it uses the heap.";
+    }
     epoch_manager::invoke_epoch_thread();
     epoch_manager::invoke_gc_thread();
 }
@@ -8,6 +8,7 @@
 #include "kvs.h"
 #include "log.h"
 #include "storage.h"
+#include "storage_handle.h"
 #include "tree_instance.h"
 
 #include "glog/logging.h"
@@ -62,6 +63,9 @@ class iscan_context {
 
     std::deque<stack_element> stackq_;
 
+    // the key suffix of the value at the top of the stack, if it has one
+    std::string suffix_;
+
 public:
     tree_instance *get_ti() { return ti_; }
     const std::string& get_end_key() { return end_key_; }
@@ -81,14 +85,15 @@ public:
     [[nodiscard]] bool stack_empty() const { return stackq_.empty(); }
     [[nodiscard]] auto stack_size() const { return stackq_.size(); }
     void stack_clear() { stackq_.clear(); }
+    void set_suffix(std::string_view suffix) { suffix_.assign(suffix); }
 
     std::string full_key() {
         std::string buf{};
-        buf.reserve(stackq_.size() * sizeof(key_slice_type));
+        buf.reserve(stackq_.size() * sizeof(key_slice_type) + suffix_.size());
         for (auto&& elem : stackq_) {
-            buf.append(reinterpret_cast<const char*>(&elem.key.get_key_slice()), // NOLINT
-                       std::min<std::size_t>(elem.key.get_key_length(), sizeof(key_slice_type)));
+            append_key_slice(buf, elem.key.get_key_slice(), elem.key.get_key_length());
         }
+        buf.append(suffix_);
         return buf;
     }
 
@@ -207,6 +212,49 @@ retry_fetch_lv:
          */
         goto retry_from_root; // NOLINT
     }
+    if (lv_ptr != nullptr && target_border->get_key_length_at(lv_pos) > sizeof(key_slice_type) &&
+        lv_ptr->get_next_layer() == nullptr) {
+        // case 1'. lv_ptr != nullptr, and it is value with key suffix
+        value* vp = lv_ptr->get_value();
+        key_suffix* suffix = lv_ptr->get_key_suffix();
+        // the order of the key to start key in the direction of the scan
+        int cmp{};
+        if (vp == nullptr || suffix == nullptr) {
+            cmp = -1; // removed, so skip it
+        } else if (traverse_endpoint == scan_endpoint::INF) {
+            cmp = 1;
+        } else {
+            cmp = suffix->get_view().compare(traverse_key_view.substr(sizeof(key_slice_type)));
+            if (right_to_left) { cmp = -cmp; }
+        }
+        node_version64_body final_check = target_border->get_stable_version();
+        if (final_check.get_vsplit() != v_at_fb.get_vsplit() ||
+            (final_check.get_deleted() && !final_check.get_root())) {
+            if (early_abort) { return status::WARN_CONCURRENT_OPERATIONS; }
+            goto retry_from_root; // NOLINT
+        }
+        if (final_check.get_vinsert_delete() != v_at_fetch_lv.get_vinsert_delete()) {
+            if (early_abort) { return status::WARN_CONCURRENT_OPERATIONS; }
+            goto retry_fetch_lv; // NOLINT
+        }
+        if (cmp == 0 && traverse_endpoint == scan_endpoint::INCLUSIVE) {
+            // just hit start_key
+            out = value::get_body(vp);
+            ctx->set_suffix(suffix->get_view());
+            ctx->stack(key_tup, root, target_border, cmp_to_end,
+                       {v_at_fb, permutation(target_border->get_permutation().get_body()), 0});
+            return status::OK;
+        }
+        if (cmp > 0) {
+            // findnext visits the key, so pass the key tuple just before it.
+            // The length is out of the range of keys, which no key has.
+            key_tup.set_key_length(right_to_left ? sizeof(key_slice_type) + 2 : sizeof(key_slice_type));
+        }
+        // pass to findnext
+        ctx->stack(key_tup, root, target_border, cmp_to_end,
+                   {v_at_fb, permutation(target_border->get_permutation().get_body()), 0});
+        return status::OK_SCAN_CONTINUE;
+    }
     if (lv_ptr != nullptr && target_border->get_key_length_at(lv_pos) > sizeof(key_slice_type)) {
         // case 1. lv_ptr != nullptr, and link to next-layer
         // visited this node
@@ -258,6 +306,7 @@ retry_fetch_lv:
                 goto retry_fetch_lv; // NOLINT
             }
             out = v_body;
+            ctx->set_suffix({});
             ctx->stack(key_tup, root, target_border, cmp_to_end,
                        {v_at_fb, permutation(target_border->get_permutation().get_body()), 0});
             return status::OK;
@@ -414,7 +463,8 @@ retry_after_fb:
 
         link_or_value* lv = bn->get_lv_at(index);
         value* vp = lv->get_value();
-        // base_node* next_layer = lv->get_next_layer();
+        base_node* child = lv->get_next_layer();
+        key_suffix* suffix = kl > sizeof(key_slice_type) && child == nullptr ? lv->get_key_suffix() : nullptr;
 
         /*
          * This verification may seem verbose, but it can also be considered
@@ -454,6 +504,13 @@ retry_after_fb:
                     hit = (kt > ekt) || (kt == ekt && kt.get_key_length() > sizeof(key_slice_type));
                 }
             }
+            if (hit && suffix != nullptr && kt == ekt && eep != scan_endpoint::INF) {
+                // the value with key suffix, compare the rest of the end key
+                int cmp = suffix->get_view().compare(
+                    std::string_view(ctx->get_end_key()).substr(ctx->stack_size() * sizeof(key_slice_type)));
+                if (right_to_left) { cmp = -cmp; }
+                hit = cmp < 0 || (cmp == 0 && eep == scan_endpoint::INCLUSIVE);
+            }
             if (!hit) { // reach to range end
                 // callback range, from last_key to range_end.
                 // if last_key = range_end_key and range_end_ep = INCLUSIVE, callback range is empty
@@ -466,12 +523,11 @@ retry_after_fb:
             }
         }
         // in range
-        if (kl > sizeof(key_slice_type)) {
-            base_node* child = lv->get_next_layer();
-            if (child == nullptr) {
-                if (early_abort) { return status::WARN_CONCURRENT_OPERATIONS; }
-//                goto retry_fetch_lv; // NOLINT
-            }
+        if (kl > sizeof(key_slice_type) && child == nullptr && (vp == nullptr || suffix == nullptr)) {
+            // the value with key suffix was removed
+            continue;
+        }
+        if (kl > sizeof(key_slice_type) && child != nullptr) {
             // TODO: implement check and retry
 
             if (bnv_cb(bn->get_version_ptr(), v_at_fb)) {
@@ -515,6 +571,7 @@ retry_after_fb:
             }
             //out = std::make_pair(v_body, value::get_len(vp));
             out = v_body;
+            ctx->set_suffix(suffix != nullptr ? suffix->get_view() : std::string_view{});
             ctx->stack_top().bn = bn;
             ctx->stack_top().key = {ks, kl};
             ctx->stack_top().bi.perm_rank = i+1;
@@ -632,6 +689,42 @@ iscan_open(std::string_view storage_name,
     return iscan_open(ti, l_key, l_end, r_key, r_end, context, value, bnv_cb, right_to_left, early_abort);
 }
 
+/**
+ * @brief open scan iterator on the storage of @a storage and find first key
+ * @return Same to iscan_open with the storage name.
+ */
+[[maybe_unused]] static auto
+iscan_open(const storage_handle& storage,
+        std::string_view l_key, scan_endpoint l_end,
+        std::string_view r_key, scan_endpoint r_end,
+        bool right_to_left, bool early_abort,
+        iscan_context*& context, void*& value,
+        const std::function<bool(node_version64*, node_version64_body)>& bnv_cb = dummycallback) {
+    if ((l_key.data() == nullptr && !l_key.empty()) ||
+        (r_key.data() == nullptr && !r_key.empty())) {
+        context = nullptr;
+        return status::ERR_BAD_USAGE;
+    }
+
+    if (auto rc = check_empty_scan_range(l_key, l_end, r_key, r_end); rc != status::OK) {
+        context = nullptr;
+        return rc;
+    }
+
+    // check storage
+    tree_instance* ti{storage.get()};
+    if (ti == nullptr) {
+        context = nullptr;
+        return status::WARN_STORAGE_NOT_EXIST;
+    }
+    if (l_end == scan_endpoint::INF) {
+        // treat l_key as ""
+        l_key = "";
+        l_end = scan_endpoint::INCLUSIVE;
+    }
+    return iscan_open(ti, l_key, l_end, r_key, r_end, context, value, bnv_cb, right_to_left, early_abort);
+}
+
 /**
  * @brief find next key using scan context
  * @return status::OK if found first key, and stored value to @a value.
@@ -7,8 +7,10 @@
 #include <utility>
 
 #include "border_helper.h"
+#include "cursor_hint.h"
 #include "interior_node.h"
 #include "storage.h"
+#include "storage_handle.h"
 #include "storage_impl.h"
 
 namespace yakushima {
@@ -24,18 +26,27 @@ namespace yakushima {
  * @param[in] created_value_ptr
  * @param[in] v_align
  * @param[in] inserted_node_info_ptr
+ * @param[in,out] hint If this is not nullptr, it starts from the border node which the
+ * hint remembers if possible, and the hint remembers the border node of this put.
  */
 template<class ValueType>
 [[maybe_unused]] static status
-put([[maybe_unused]] Token token, tree_instance* ti, std::string_view key_view,
+put(Token token, tree_instance* ti, std::string_view key_view,
     ValueType* v_ptr, bool unique_restriction,
     value_length_type v_len = sizeof(ValueType),
     ValueType** created_value_ptr = nullptr,
     value_align_type v_align =
             static_cast<value_align_type>(alignof(ValueType)),
-    inserted_node_info* inserted_node_info_ptr = nullptr) {
+    inserted_node_info* inserted_node_info_ptr = nullptr,
+    cursor_hint* hint = nullptr) {
     constexpr auto kIsInline = is_inlinable<ValueType>();
     auto* created_v_ptr = reinterpret_cast<void**>(created_value_ptr); // NOLINT
+    value_pool* pool =
+            token != nullptr
+                    ? &reinterpret_cast<thread_info*>(token) // NOLINT
+                               ->get_gc_info()
+                               .get_value_pool()
+                    : nullptr;
     if (inserted_node_info_ptr != nullptr) {
         inserted_node_info_ptr->created_nvp = nullptr;
     }
@@ -47,15 +58,15 @@ root_nullptr:
          * root is nullptr, so put single border nodes.
          */
         border_node* new_border = new border_node(); // NOLINT
-        value* v = value::create_value<kIsInline>(v_ptr, v_len, v_align);
-        new_border->init_border(key_view, v, created_value_ptr, true);
+        value* v = value::create_value<kIsInline>(v_ptr, v_len, v_align, pool);
+        new_border->init_border(key_view, v, created_value_ptr, true, pool);
         for (;;) {
             if (inserted_node_info_ptr != nullptr) {
                 // strictly speaking, a new node is created in this case, but for consistency with other cases,
                 // the result is stored to modified_nvp instead of created_nvp.
                 inserted_node_info_ptr->modified_nvp = new_border->get_version_ptr();
             }
-            base_node* desired{dynamic_cast<base_node*>(new_border)};
+            base_node* desired{new_border};
             if (ti->cas_root_ptr(&expected, &desired)) { return status::OK; }
             if (expected != nullptr) {
                 // root is not nullptr;
@@ -75,39 +86,48 @@ retry_from_root:
     if (root == nullptr) goto root_nullptr; // NOLINT
 
     std::string_view traverse_key_view{key_view};
+    node_version64_body hinted_v{};
+    border_node* hinted_border =
+            hint != nullptr ? hint->find_border(ti, key_view, traverse_key_view,
+                                                hinted_v)
+                            : nullptr;
 retry_find_border:
     /**
      * prepare key_slice
      */
-    key_slice_type key_slice(0);
+    key_slice_type key_slice = make_key_slice(traverse_key_view);
     key_length_type key_slice_length{};
     if (traverse_key_view.size() > sizeof(key_slice_type)) {
-        memcpy(&key_slice, traverse_key_view.data(), sizeof(key_slice_type));
         key_slice_length = sizeof(key_slice_type) + 1; // rule
     } else {
-        if (!traverse_key_view.empty()) {
-            memcpy(&key_slice, traverse_key_view.data(),
-                   traverse_key_view.size());
-        }
         key_slice_length = traverse_key_view.size();
     }
     /**
      * traverse tree to border node.
      */
     status special_status{status::OK};
-    if (root == nullptr) {
-        LOG(ERROR) << log_location_prefix << "unexpected process.";
-    }
-    std::tuple<border_node*, node_version64_body> node_and_v =
-            find_border(root, key_slice, key_slice_length, special_status);
-    if (special_status == status::WARN_RETRY_FROM_ROOT_OF_ALL) {
-        /**
-         * @a root is the root node of the some layer, but it was deleted.
-         * So it must retry from root of the all tree.
-         */
-        node_version64_body nv = std::get<1>(node_and_v);
-        if (!(nv.get_root() && nv.get_deleted())) {
-            goto retry_from_root; // NOLINT
+    std::tuple<border_node*, node_version64_body> node_and_v{hinted_border,
+                                                              hinted_v};
+    if (hinted_border != nullptr) {
+        // the hint skips the descent. It is used only once.
+        hinted_border = nullptr;
+        // the root of the layer is unknown.
+        root = nullptr;
+    } else {
+        if (root == nullptr) {
+            LOG(ERROR) << log_location_prefix << "unexpected process.";
+        }
+        node_and_v = find_border(root, key_slice, key_slice_length,
+                                 special_status);
+        if (special_status == status::WARN_RETRY_FROM_ROOT_OF_ALL) {
+            /**
+             * @a root is the root node of the some layer, but it was deleted.
+             * So it must retry from root of the all tree.
+             */
+            node_version64_body nv = std::get<1>(node_and_v);
+            if (!(nv.get_root() && nv.get_deleted())) {
+                goto retry_from_root; // NOLINT
+            }
         }
     }
     constexpr std::size_t tuple_node_index = 0;
@@ -129,7 +149,8 @@ retry_fetch_lv:
          * It may be change the correct border between atomically fetching border node and
          * atomically fetching lv.
          */
-        goto retry_from_root; // NOLINT
+        YAKUSHIMA_RECOVER_BORDER(target_border, v_at_fb, root, key_slice, // NOLINT
+                                 key_slice_length);
     }
     if (lv_ptr == nullptr) {
         target_border->lock();
@@ -143,7 +164,8 @@ retry_fetch_lv:
              * atomically fetching border and lock.
              */
             target_border->version_unlock();
-            goto retry_from_root; // NOLINT
+            YAKUSHIMA_RECOVER_BORDER(target_border, v_at_fb, root, key_slice, // NOLINT
+                                     key_slice_length);
         }
         /**
           * Here, border node is the correct.
@@ -159,12 +181,18 @@ retry_fetch_lv:
             target_border->version_unlock();
             goto retry_fetch_lv; // NOLINT
         }
-        value* v = value::create_value<kIsInline>(v_ptr, v_len, v_align);
+        if (hint != nullptr) {
+            // a split by this insert makes the hint invalid by vsplit.
+            hint->remember(ti, key_view, traverse_key_view, target_border,
+                           v_at_fb);
+        }
+        value* v = value::create_value<kIsInline>(v_ptr, v_len, v_align, pool);
         insert_lv(
                 ti, target_border, traverse_key_view, v, created_v_ptr,
                 inserted_node_info_ptr,
                 target_border->compute_rank_if_insert(key_slice,
-                                                      key_slice_length));
+                                                      key_slice_length),
+                pool);
         return status::OK;
     }
 
@@ -183,7 +211,8 @@ retry_fetch_lv:
                 target_border->get_version_vsplit() != v_at_fb.get_vsplit()) {
                 // maybe wrong node
                 target_border->version_unlock();
-                goto retry_from_root; // NOLINT
+                YAKUSHIMA_RECOVER_BORDER(target_border, v_at_fb, root, key_slice, // NOLINT
+                                         key_slice_length);
             }
             if (target_border->get_version_vinsert_delete() !=
                 v_at_fetch_lv.get_vinsert_delete()) {
@@ -198,21 +227,13 @@ retry_fetch_lv:
                 goto retry_fetch_lv; // NOLINT
             }
 
-            value* v = value::create_value<kIsInline>(v_ptr, v_len, v_align);
-            if constexpr (kIsInline) {
-                lv_ptr->set_value(v, created_v_ptr);
-                target_border->version_unlock();
-            } else {
-                value* old_v = nullptr;
-                lv_ptr->set_value(v, created_v_ptr, &old_v);
-                target_border->version_unlock();
-                auto* thin = reinterpret_cast<thread_info*>(token); // NOLINT
-                if (old_v != nullptr) {
-                    auto [o_ptr, o_len, o_align] = value::get_gc_info(old_v);
-                    thin->get_gc_info().push_value_container(
-                            {thin->get_begin_epoch(), o_ptr, o_len, o_align});
-                }
+            if (hint != nullptr) {
+                hint->remember(ti, key_view, traverse_key_view, target_border,
+                               v_at_fb);
             }
+            value* v = value::create_value<kIsInline>(v_ptr, v_len, v_align, pool);
+            target_border->replace_value_keeping_lock(token, lv_ptr, v, created_v_ptr);
+            target_border->version_unlock();
             return status::OK;
         }
 
@@ -226,18 +247,86 @@ retry_fetch_lv:
              !target_border->get_version_root()) ||
             target_border->get_version_vsplit() != v_at_fb.get_vsplit()) {
             // maybe wrong node
-            goto retry_from_root; // NOLINT
+            YAKUSHIMA_RECOVER_BORDER(target_border, v_at_fb, root, key_slice, // NOLINT
+                                     key_slice_length);
+        }
+        if (target_border->get_version_vinsert_delete() !=
+            v_at_fetch_lv.get_vinsert_delete()) {
+            // maybe wrong lv
+            goto retry_fetch_lv; // NOLINT
+        }
+    }
+    if (lv_ptr->get_next_layer() == nullptr) {
+        /**
+         * Here, lv_ptr has some value whose key shares the key slice, and the rest of the
+         * key is the key suffix.
+         */
+        target_border->lock();
+        if ((target_border->get_version_deleted() &&
+             !target_border->get_version_root()) ||
+            target_border->get_version_vsplit() != v_at_fb.get_vsplit()) {
+            // maybe wrong node
+            target_border->version_unlock();
+            YAKUSHIMA_RECOVER_BORDER(target_border, v_at_fb, root, key_slice, // NOLINT
+                                     key_slice_length);
         }
         if (target_border->get_version_vinsert_delete() !=
             v_at_fetch_lv.get_vinsert_delete()) {
             // maybe wrong lv
+            target_border->version_unlock();
             goto retry_fetch_lv; // NOLINT
         }
+        // re-check because delete operation is not tracked.
+        lv_ptr = target_border->get_lv_of_without_lock(key_slice, key_slice_length);
+        if (lv_ptr == nullptr || lv_ptr->get_next_layer() != nullptr) {
+            target_border->version_unlock();
+            goto retry_fetch_lv; // NOLINT
+        }
+        std::string_view rest{traverse_key_view};
+        rest.remove_prefix(sizeof(key_slice_type));
+        key_suffix* suffix = lv_ptr->get_key_suffix();
+        if (suffix->get_view() == rest) {
+            if (unique_restriction) {
+                target_border->version_unlock();
+                return status::WARN_UNIQUE_RESTRICTION;
+            }
+            if (hint != nullptr) {
+                hint->remember(ti, key_view, traverse_key_view, target_border,
+                               v_at_fb);
+            }
+            value* v = value::create_value<kIsInline>(v_ptr, v_len, v_align, pool);
+            target_border->replace_value_keeping_lock(token, lv_ptr, v, created_v_ptr);
+            target_border->version_unlock();
+            return status::OK;
+        }
+        /**
+         * Two keys share the key slice, so the next layer for them replaces the value.
+         * It is seen as an insert by readers of this node.
+         */
+        value* v = value::create_value<kIsInline>(v_ptr, v_len, v_align, pool);
+        border_node* next_layer_border = create_layer_of_two(
+                suffix->get_view(), lv_ptr->get_value(), rest, v, created_v_ptr,
+                pool);
+        next_layer_border->set_parent(target_border);
+        target_border->set_version_inserting_deleting(true);
+        lv_ptr->set_next_layer(next_layer_border);
+        lv_ptr->set_key_suffix(nullptr);
+        if (inserted_node_info_ptr != nullptr) {
+            inserted_node_info_ptr->modified_nvp =
+                    target_border->get_version_ptr();
+        }
+        target_border->version_unlock();
+        auto* thin = reinterpret_cast<thread_info*>(token); // NOLINT
+        auto [s_ptr, s_len, s_align] = key_suffix::get_gc_info(suffix);
+        thin->get_gc_info().push_value_container(
+                {thin->get_begin_epoch(), s_ptr, s_len, s_align});
+        return status::OK;
     }
+
     /**
      * Here, lv_ptr has some next_layer.
      */
-    root = lv_ptr->get_next_layer();
+    base_node* next_layer = lv_ptr->get_next_layer();
     /**
      * check whether border is still correct.
      */
@@ -246,7 +335,8 @@ retry_fetch_lv:
          !final_check.get_root()) || // this border was deleted.
         final_check.get_vsplit() !=
                 v_at_fb.get_vsplit()) { // this border may be incorrect.
-        goto retry_from_root;           // NOLINT
+        YAKUSHIMA_RECOVER_BORDER(target_border, v_at_fb, root, key_slice, // NOLINT
+                                 key_slice_length);
     }
     /**
      * check whether fetching lv is still correct.
@@ -255,6 +345,7 @@ retry_fetch_lv:
         v_at_fetch_lv.get_vinsert_delete()) { // fetched lv may be deleted
         goto retry_fetch_lv;                  // NOLINT
     }
+    root = next_layer;
     if (root == nullptr) {
         LOG(ERROR) << log_location_prefix
                    << "unexpected process. lv_ptr:" << lv_ptr
@@ -287,6 +378,58 @@ put(Token token, std::string_view storage_name, // NOLINT
                inserted_node_info_ptr);
 }
 
+template<class ValueType>
+[[maybe_unused]] static status
+put(Token token, cursor_hint& hint, std::string_view storage_name, // NOLINT
+    std::string_view key_view, ValueType* value_ptr,
+    std::size_t arg_value_length = sizeof(ValueType),
+    ValueType** created_value_ptr = nullptr,
+    value_align_type value_align =
+            static_cast<value_align_type>(alignof(ValueType)),
+    bool unique_restriction = false) {
+    tree_instance* ti{};
+    status ret{storage::find_storage(storage_name, &ti)};
+    if (status::OK != ret) { return status::WARN_STORAGE_NOT_EXIST; }
+    hint.attach(token);
+    return put(token, ti, key_view, value_ptr, unique_restriction,
+               arg_value_length, created_value_ptr, value_align, nullptr,
+               &hint);
+}
+
+template<class ValueType>
+[[maybe_unused]] static status
+put(Token token, const storage_handle& storage, // NOLINT
+    std::string_view key_view, ValueType* value_ptr,
+    std::size_t arg_value_length = sizeof(ValueType),
+    ValueType** created_value_ptr = nullptr,
+    value_align_type value_align =
+            static_cast<value_align_type>(alignof(ValueType)),
+    bool unique_restriction = false,
+    inserted_node_info* inserted_node_info_ptr = nullptr) {
+    tree_instance* ti{storage.get()};
+    if (ti == nullptr) { return status::WARN_STORAGE_NOT_EXIST; }
+    return put(token, ti, key_view, value_ptr, unique_restriction,
+               arg_value_length, created_value_ptr, value_align,
+               inserted_node_info_ptr);
+}
+
+template<class ValueType>
+[[maybe_unused]] static status
+put(Token token, cursor_hint& hint, const storage_handle& storage, // NOLINT
+    std::string_view key_view, ValueType* value_ptr,
+    std::size_t arg_value_length = sizeof(ValueType),
+    ValueType** created_value_ptr = nullptr,
+    value_align_type value_align =
+            static_cast<value_align_type>(alignof(ValueType)),
+    bool unique_restriction = false) {
+    tree_instance* ti{storage.get()};
+    if (ti == nullptr) { return status::WARN_STORAGE_NOT_EXIST; }
+    hint.attach(token);
+    return put(token, ti, key_view, value_ptr, unique_restriction,
+               arg_value_length, created_value_ptr, value_align, nullptr,
+               &hint);
+}
+
 // old interface, pass to new interface
 template<class ValueType>
 [[maybe_unused]] static status
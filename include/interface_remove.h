@@ -7,9 +7,12 @@
 #include <utility>
 
 #include "border_node.h"
+#include "common_helper.h"
+#include "cursor_hint.h"
 #include "kvs.h"
 #include "log.h"
 #include "storage.h"
+#include "storage_handle.h"
 #include "storage_impl.h"
 #include "tree_instance.h"
 
@@ -19,7 +22,8 @@ namespace yakushima {
 // end - forward declaration
 
 [[maybe_unused]] static status remove(Token token, tree_instance* ti, // NOLINT
-                                      std::string_view key_view) {
+                                      std::string_view key_view,
+                                      cursor_hint* hint = nullptr) {
 retry_from_root:
     base_node* root = ti->load_root_ptr();
     if (root == nullptr) {
@@ -30,37 +34,45 @@ retry_from_root:
     }
 
     std::string_view traverse_key_view{key_view};
+    node_version64_body hinted_v{};
+    border_node* hinted_border =
+            hint != nullptr ? hint->find_border(ti, key_view, traverse_key_view,
+                                                hinted_v)
+                            : nullptr;
 retry_find_border:
     /**
      * prepare key_slice
      */
-    key_slice_type key_slice = 0;
+    key_slice_type key_slice = make_key_slice(traverse_key_view);
     key_length_type key_length{};
     if (traverse_key_view.size() > sizeof(key_slice_type)) {
-        memcpy(&key_slice, traverse_key_view.data(), sizeof(key_slice_type));
         key_length = sizeof(key_slice_type) + 1;
     } else {
-        if (!traverse_key_view.empty()) {
-            memcpy(&key_slice, traverse_key_view.data(),
-                   traverse_key_view.size());
-        }
         key_length = traverse_key_view.size();
     }
     /**
      * traverse tree to border node.
      */
     status special_status{status::OK};
-    if (root == nullptr) {
-        LOG(ERROR) << log_location_prefix << "unexpected process.";
-    }
-    std::tuple<border_node*, node_version64_body> node_and_v =
-            find_border(root, key_slice, key_length, special_status);
-    if (special_status == status::WARN_RETRY_FROM_ROOT_OF_ALL) {
-        /**
-         * @a root is the root node of the some layer, but it was deleted.
-         * So it must retry from root of the all tree.
-         */
-        goto retry_from_root; // NOLINT
+    std::tuple<border_node*, node_version64_body> node_and_v{hinted_border,
+                                                              hinted_v};
+    if (hinted_border != nullptr) {
+        // the hint skips the descent. It is used only once.
+        hinted_border = nullptr;
+        // the root of the layer is unknown.
+        root = nullptr;
+    } else {
+        if (root == nullptr) {
+            LOG(ERROR) << log_location_prefix << "unexpected process.";
+        }
+        node_and_v = find_border(root, key_slice, key_length, special_status);
+        if (special_status == status::WARN_RETRY_FROM_ROOT_OF_ALL) {
+            /**
+             * @a root is the root node of the some layer, but it was deleted.
+             * So it must retry from root of the all tree.
+             */
+            goto retry_from_root; // NOLINT
+        }
     }
     constexpr std::size_t tuple_node_index = 0;
     constexpr std::size_t tuple_v_index = 1;
@@ -78,7 +90,7 @@ retry_find_border:
         goto retry_from_root; // NOLINT
     }
     // check target_border is border node.
-    if (typeid(*target_border) != typeid(border_node)) {
+    if (!target_border->get_version_border()) {
         LOG(ERROR) << log_location_prefix
                    << "find_border return not border node.";
         return status::ERR_FATAL;
@@ -98,7 +110,8 @@ retry_fetch_lv:
          * It may be change the correct border between atomically fetching border node
          * and atomically fetching lv.
          */
-        goto retry_from_root; // NOLINT
+        YAKUSHIMA_RECOVER_BORDER(target_border, v_at_fb, root, key_slice, // NOLINT
+                                 key_length);
     }
     // the target node is correct
 
@@ -111,6 +124,10 @@ retry_fetch_lv:
             v_at_fetch_lv.get_vinsert_delete()) { // the lv may be inserted.
             goto retry_fetch_lv;                  // NOLINT
         }
+        if (hint != nullptr) {
+            hint->remember(ti, key_view, traverse_key_view, target_border,
+                           v_at_fb);
+        }
         return status::OK_NOT_FOUND;
     }
 
@@ -126,8 +143,9 @@ retry_fetch_lv:
             final_check.get_vsplit() !=
                     v_at_fb.get_vsplit()) { // the border may be incorrect.
             target_border->version_unlock();
-            goto retry_from_root; // NOLINT
-        }                         // here border is correct.
+            YAKUSHIMA_RECOVER_BORDER(target_border, v_at_fb, root, key_slice, // NOLINT
+                                     key_length);
+        } // here border is correct.
         if (final_check.get_vinsert_delete() !=
             v_at_fetch_lv
                     .get_vinsert_delete()) { // the lv may be inserted/deleted.
@@ -142,23 +160,67 @@ retry_fetch_lv:
             return status::OK_NOT_FOUND;
         }
 
+        if (hint != nullptr) {
+            // the node may be removed by this delete, which the hint notices.
+            hint->remember(ti, key_view, traverse_key_view, target_border,
+                           v_at_fb);
+        }
         // success delete
         target_border->delete_of<true>(token, ti, key_slice, key_length);
         return status::OK;
     }
 
-    root = lv_ptr->get_next_layer();
+    if (lv_ptr->get_next_layer() == nullptr) {
+        /**
+         * The value has a key suffix, which is compared under the lock.
+         */
+        target_border->lock();
+        node_version64_body final_check = target_border->get_version();
+        if ((final_check.get_deleted() && !final_check.get_root()) ||
+            final_check.get_vsplit() != v_at_fb.get_vsplit()) {
+            target_border->version_unlock();
+            YAKUSHIMA_RECOVER_BORDER(target_border, v_at_fb, root, key_slice, // NOLINT
+                                     key_length);
+        }
+        if (final_check.get_vinsert_delete() !=
+            v_at_fetch_lv.get_vinsert_delete()) {
+            target_border->version_unlock();
+            goto retry_fetch_lv; // NOLINT
+        }
+        lv_ptr = target_border->get_lv_of_without_lock(key_slice, key_length);
+        if (lv_ptr != nullptr && lv_ptr->get_next_layer() != nullptr) {
+            // it was replaced by the next layer.
+            target_border->version_unlock();
+            goto retry_fetch_lv; // NOLINT
+        }
+        std::string_view rest{traverse_key_view};
+        rest.remove_prefix(sizeof(key_slice_type));
+        if (hint != nullptr) {
+            hint->remember(ti, key_view, traverse_key_view, target_border,
+                           v_at_fb);
+        }
+        if (lv_ptr == nullptr || lv_ptr->get_key_suffix()->get_view() != rest) {
+            target_border->version_unlock();
+            return status::OK_NOT_FOUND;
+        }
+        target_border->delete_of<true>(token, ti, key_slice, key_length);
+        return status::OK;
+    }
+
+    base_node* next_layer = lv_ptr->get_next_layer();
     node_version64_body final_check = target_border->get_stable_version();
     if ((final_check.get_deleted() &&
          !final_check.get_root()) || // this border was deleted.
         final_check.get_vsplit() !=
                 v_at_fb.get_vsplit()) { // this border is incorrect.
-        goto retry_from_root;           // NOLINT
+        YAKUSHIMA_RECOVER_BORDER(target_border, v_at_fb, root, key_slice, // NOLINT
+                                 key_length);
     }
     if (final_check.get_vinsert_delete() !=
         v_at_fetch_lv.get_vinsert_delete()) { // fetched lv may be deleted.
         goto retry_fetch_lv;                  // NOLINT
     }
+    root = next_layer;
     traverse_key_view.remove_prefix(sizeof(key_slice_type));
     if (root == nullptr) {
         LOG(ERROR) << log_location_prefix << "unexpected process.";
@@ -175,4 +237,77 @@ retry_fetch_lv:
     return remove(token, ti, key_view);
 }
 
+[[maybe_unused]] static status remove(Token token, cursor_hint& hint, // NOLINT
+                                      std::string_view storage_name,
+                                      std::string_view key_view) {
+    tree_instance* ti{};
+    status ret{storage::find_storage(storage_name, &ti)};
+    if (status::OK != ret) { return status::WARN_STORAGE_NOT_EXIST; }
+    hint.attach(token);
+    return remove(token, ti, key_view, &hint);
+}
+
+[[maybe_unused]] static status remove(Token token, // NOLINT
+                                      const storage_handle& storage,
+                                      std::string_view key_view) {
+    tree_instance* ti{storage.get()};
+    if (ti == nullptr) { return status::WARN_STORAGE_NOT_EXIST; }
+    return remove(token, ti, key_view);
+}
+
+[[maybe_unused]] static status remove(Token token, cursor_hint& hint, // NOLINT
+                                      const storage_handle& storage,
+                                      std::string_view key_view) {
+    tree_instance* ti{storage.get()};
+    if (ti == nullptr) { return status::WARN_STORAGE_NOT_EXIST; }
+    hint.attach(token);
+    return remove(token, ti, key_view, &hint);
+}
+
+/**
+ * @details The value is removed as remove does, which pushes it to the gc with the epoch
+ * of @a token, so the body stays until the session leaves.
+ */
+template<class ValueType>
+[[maybe_unused]] static status take(Token token, tree_instance* ti, // NOLINT
+                                    std::string_view key_view,
+                                    std::pair<ValueType*, std::size_t>& out) {
+    border_node* border{};
+    key_slice_type key_slice{};
+    key_length_type key_length{};
+    link_or_value* lv_ptr =
+            lock_lv_of(ti, key_view, border, key_slice, key_length);
+    if (lv_ptr == nullptr) {
+        out = {nullptr, 0};
+        if (border == nullptr) { return status::OK_ROOT_IS_NULL; }
+        border->version_unlock();
+        return status::OK_NOT_FOUND;
+    }
+    value* vp = lv_ptr->get_value();
+    out = {static_cast<ValueType*>(value::get_body(vp)), value::get_len(vp)};
+    border->delete_of<true>(token, ti, key_slice, key_length);
+    return status::OK;
+}
+
+template<class ValueType>
+[[maybe_unused]] static status take(Token token, // NOLINT
+                                    std::string_view storage_name,
+                                    std::string_view key_view,
+                                    std::pair<ValueType*, std::size_t>& out) {
+    tree_instance* ti{};
+    status ret{storage::find_storage(storage_name, &ti)};
+    if (status::OK != ret) { return status::WARN_STORAGE_NOT_EXIST; }
+    return take(token, ti, key_view, out);
+}
+
+template<class ValueType>
+[[maybe_unused]] static status take(Token token, // NOLINT
+                                    const storage_handle& storage,
+                                    std::string_view key_view,
+                                    std::pair<ValueType*, std::size_t>& out) {
+    tree_instance* ti{storage.get()};
+    if (ti == nullptr) { return status::WARN_STORAGE_NOT_EXIST; }
+    return take(token, ti, key_view, out);
+}
+
 } // namespace yakushima
@@ -8,6 +8,7 @@
 #include "log.h"
 #include "scan_helper.h"
 #include "storage.h"
+#include "storage_handle.h"
 #include "tree_instance.h"
 
 #include "glog/logging.h"
@@ -81,17 +82,9 @@ retry_from_root:
     /**
      * prepare key_slice
      */
-    key_slice_type key_slice(0);
+    key_slice_type key_slice = make_key_slice(traverse_key_view);
     auto key_slice_length =
             static_cast<key_length_type>(traverse_key_view.size());
-    if (traverse_key_view.size() > sizeof(key_slice_type)) {
-        memcpy(&key_slice, traverse_key_view.data(), sizeof(key_slice_type));
-    } else {
-        if (!traverse_key_view.empty()) {
-            memcpy(&key_slice, traverse_key_view.data(),
-                   traverse_key_view.size());
-        }
-    }
     if (right_to_left) {
         // assuming r_end == scan_endpoint::INF
         // put maximum value of key_slice
@@ -143,6 +136,7 @@ retry_from_root:
          * fail. It will clear all tuple and node information after goto.
          */
         if (check_status == status::OK_RETRY_FROM_ROOT) {
+            ++get_retry_stats().from_root;
             goto retry_from_root; // NOLINT
         } else {
             // unreachable
@@ -169,4 +163,19 @@ scan(std::string_view storage_name, std::string_view l_key, // NOLINT
                 max_size, right_to_left);
 }
 
+template<class ValueType>
+[[maybe_unused]] static status
+scan(const storage_handle& storage, std::string_view l_key, // NOLINT
+     scan_endpoint l_end, std::string_view r_key, scan_endpoint r_end,
+     std::vector<std::tuple<std::string, ValueType*, std::size_t>>& tuple_list,
+     std::vector<std::pair<node_version64_body, node_version64*>>*
+             node_version_vec = nullptr,
+     std::size_t max_size = 0,
+     bool right_to_left = false) {
+    tree_instance* ti{storage.get()};
+    if (ti == nullptr) { return status::WARN_STORAGE_NOT_EXIST; }
+    return scan(ti, l_key, l_end, r_key, r_end, tuple_list, node_version_vec,
+                max_size, right_to_left);
+}
+
 } // namespace yakushima
@@ -0,0 +1,264 @@
+/**
+ * @file interface_update.h
+ */
+
+#pragma once
+
+#include <cstring>
+#include <string_view>
+#include <utility>
+
+#include "common_helper.h"
+#include "interface_put.h"
+#include "storage_handle.h"
+#include "storage_impl.h"
+#include "tree_instance.h"
+
+namespace yakushima {
+
+/**
+ * @details It locks the border node of @a key_view and calls @a fn with the body of the
+ * value under the lock, so the value is neither allocated again nor pushed to the gc.
+ * An inline value is copied out, given to @a fn and stored back.
+ */
+template<class ValueType, class Fn>
+[[maybe_unused]] static status update(tree_instance* ti, std::string_view key_view,
+                                      Fn&& fn) {
+    constexpr auto kIsInline = is_inlinable<ValueType>();
+    border_node* border{};
+    key_slice_type key_slice{};
+    key_length_type key_length{};
+    link_or_value* lv_ptr =
+            lock_lv_of(ti, key_view, border, key_slice, key_length);
+    if (lv_ptr == nullptr) {
+        if (border != nullptr) { border->version_unlock(); }
+        return status::WARN_NOT_EXIST;
+    }
+    value* v = lv_ptr->get_value();
+    // get_copy sees the change of the version.
+    border->set_version_inserting_deleting(true);
+    if constexpr (kIsInline) {
+        ValueType body{};
+        memcpy(&body, &v, sizeof(uintptr_t)); // NOLINT
+        fn(&body, value::get_len(v));
+        lv_ptr->set_value(value::create_value<true>(&body, sizeof(uintptr_t),
+                                                    static_cast<value_align_type>(
+                                                            alignof(ValueType))),
+                          nullptr);
+    } else {
+        fn(static_cast<ValueType*>(value::get_body(v)), value::get_len(v));
+    }
+    border->version_unlock();
+    return status::OK;
+}
+
+template<class ValueType, class Fn>
+[[maybe_unused]] static status
+update(Token, std::string_view storage_name, // NOLINT
+       std::string_view key_view, Fn&& fn) {
+    tree_instance* ti{};
+    status ret{storage::find_storage(storage_name, &ti)};
+    if (status::OK != ret) { return status::WARN_STORAGE_NOT_EXIST; }
+    return update<ValueType>(ti, key_view, std::forward<Fn>(fn));
+}
+
+template<class ValueType, class Fn>
+[[maybe_unused]] static status
+update(Token, const storage_handle& storage, // NOLINT
+       std::string_view key_view, Fn&& fn) {
+    tree_instance* ti{storage.get()};
+    if (ti == nullptr) { return status::WARN_STORAGE_NOT_EXIST; }
+    return update<ValueType>(ti, key_view, std::forward<Fn>(fn));
+}
+
+/**
+ * @details If the key is absent, it puts @a init_value_ptr with unique restriction.
+ * When another session put the key meanwhile, it updates the value of the session.
+ */
+template<class ValueType, class Fn>
+[[maybe_unused]] static status
+upsert(Token token, tree_instance* ti, std::string_view key_view, Fn&& fn,
+       ValueType* init_value_ptr, const std::size_t arg_value_length,
+       const value_align_type value_align) {
+    for (;;) {
+        status ret = update<ValueType>(ti, key_view, fn);
+        if (ret != status::WARN_NOT_EXIST) { return ret; }
+        ret = put(token, ti, key_view, init_value_ptr, true, arg_value_length,
+                  static_cast<ValueType**>(nullptr), value_align);
+        if (ret != status::WARN_UNIQUE_RESTRICTION) { return ret; }
+    }
+}
+
+template<class ValueType, class Fn>
+[[maybe_unused]] static status
+upsert(Token token, std::string_view storage_name, // NOLINT
+       std::string_view key_view, Fn&& fn, ValueType* init_value_ptr,
+       const std::size_t arg_value_length = sizeof(ValueType),
+       const value_align_type value_align =
+               static_cast<value_align_type>(alignof(ValueType))) {
+    tree_instance* ti{};
+    status ret{storage::find_storage(storage_name, &ti)};
+    if (status::OK != ret) { return status::WARN_STORAGE_NOT_EXIST; }
+    return upsert(token, ti, key_view, std::forward<Fn>(fn), init_value_ptr,
+                  arg_value_length, value_align);
+}
+
+template<class ValueType, class Fn>
+[[maybe_unused]] static status
+upsert(Token token, const storage_handle& storage, // NOLINT
+       std::string_view key_view, Fn&& fn, ValueType* init_value_ptr,
+       const std::size_t arg_value_length = sizeof(ValueType),
+       const value_align_type value_align =
+               static_cast<value_align_type>(alignof(ValueType))) {
+    tree_instance* ti{storage.get()};
+    if (ti == nullptr) { return status::WARN_STORAGE_NOT_EXIST; }
+    return upsert(token, ti, key_view, std::forward<Fn>(fn), init_value_ptr,
+                  arg_value_length, value_align);
+}
+
+/**
+ * @details It compares the value with @a expected under the lock of the border node,
+ * which put, update and remove of the key also take. update and overwrite change the
+ * body in place, so an address in the body always has the current bytes: @a expected
+ * must be a copy which the caller owns, and an address in the body doesn't match.
+ */
+template<class ValueType>
+[[maybe_unused]] static status
+compare_exchange(Token token, tree_instance* ti, std::string_view key_view,
+                 std::pair<ValueType*, std::size_t>& expected,
+                 ValueType* desired_ptr, const std::size_t arg_value_length,
+                 const value_align_type value_align) {
+    constexpr auto kIsInline = is_inlinable<ValueType>();
+    border_node* border{};
+    key_slice_type key_slice{};
+    key_length_type key_length{};
+    link_or_value* lv_ptr =
+            lock_lv_of(ti, key_view, border, key_slice, key_length);
+    if (lv_ptr == nullptr) {
+        if (border != nullptr) { border->version_unlock(); }
+        expected = {nullptr, 0};
+        return status::WARN_NOT_EXIST;
+    }
+    value* v = lv_ptr->get_value();
+    auto* body = static_cast<ValueType*>(value::get_body(v));
+    const std::size_t len = value::get_len(v);
+    bool match{};
+    if constexpr (kIsInline) {
+        // the body of an inline value is the word itself, as get returns.
+        match = expected.first == body;
+    } else {
+        const auto exp_begin = reinterpret_cast<std::uintptr_t>(expected.first); // NOLINT
+        const auto body_begin = reinterpret_cast<std::uintptr_t>(body);         // NOLINT
+        const bool aliased = exp_begin < body_begin + len &&
+                             body_begin < exp_begin + expected.second;
+        match = expected.first != nullptr && !aliased && expected.second == len &&
+                memcmp(expected.first, body, len) == 0;
+    }
+    if (!match) {
+        border->version_unlock();
+        expected = {body, len};
+        return status::WARN_VALUE_MISMATCH;
+    }
+    auto* thin = reinterpret_cast<thread_info*>(token); // NOLINT
+    border->replace_value_keeping_lock(
+            token, lv_ptr,
+            value::create_value<kIsInline>(desired_ptr, arg_value_length, value_align,
+                                           &thin->get_gc_info().get_value_pool()),
+            nullptr);
+    border->version_unlock();
+    return status::OK;
+}
+
+template<class ValueType>
+[[maybe_unused]] static status
+compare_exchange(Token token, std::string_view storage_name, // NOLINT
+                 std::string_view key_view,
+                 std::pair<ValueType*, std::size_t>& expected,
+                 ValueType* desired_ptr,
+                 const std::size_t arg_value_length = sizeof(ValueType),
+                 const value_align_type value_align =
+                         static_cast<value_align_type>(alignof(ValueType))) {
+    tree_instance* ti{};
+    status ret{storage::find_storage(storage_name, &ti)};
+    if (status::OK != ret) { return status::WARN_STORAGE_NOT_EXIST; }
+    return compare_exchange(token, ti, key_view, expected, desired_ptr,
+                            arg_value_length, value_align);
+}
+
+template<class ValueType>
+[[maybe_unused]] static status
+compare_exchange(Token token, const storage_handle& storage, // NOLINT
+                 std::string_view key_view,
+                 std::pair<ValueType*, std::size_t>& expected,
+                 ValueType* desired_ptr,
+                 const std::size_t arg_value_length = sizeof(ValueType),
+                 const value_align_type value_align =
+                         static_cast<value_align_type>(alignof(ValueType))) {
+    tree_instance* ti{storage.get()};
+    if (ti == nullptr) { return status::WARN_STORAGE_NOT_EXIST; }
+    return compare_exchange(token, ti, key_view, expected, desired_ptr,
+                            arg_value_length, value_align);
+}
+
+/**
+ * @details If the current value is not inline and it has the same length and a body
+ * aligned to @a value_align, it copies @a value_ptr into the body under the lock of the
+ * border node. Otherwise it is same to put.
+ */
+template<class ValueType>
+[[maybe_unused]] static status
+overwrite(Token token, tree_instance* ti, std::string_view key_view,
+          ValueType* value_ptr, const std::size_t arg_value_length,
+          const value_align_type value_align) {
+    if constexpr (!is_inlinable<ValueType>()) {
+        border_node* border{};
+        key_slice_type key_slice{};
+        key_length_type key_length{};
+        link_or_value* lv_ptr =
+                lock_lv_of(ti, key_view, border, key_slice, key_length);
+        if (lv_ptr != nullptr) {
+            value* v = lv_ptr->get_value();
+            void* body = value::get_body(v);
+            if (value::is_value_ptr(v) && value::get_len(v) == arg_value_length &&
+                reinterpret_cast<uintptr_t>(body) %               // NOLINT
+                                static_cast<std::size_t>(value_align) ==
+                        0) {
+                // get_copy sees the change of the version.
+                border->set_version_inserting_deleting(true);
+                memcpy(body, value_ptr, arg_value_length);
+                border->version_unlock();
+                return status::OK;
+            }
+        }
+        if (border != nullptr) { border->version_unlock(); }
+    }
+    return put(token, ti, key_view, value_ptr, false, arg_value_length,
+               static_cast<ValueType**>(nullptr), value_align);
+}
+
+template<class ValueType>
+[[maybe_unused]] static status
+overwrite(Token token, std::string_view storage_name, // NOLINT
+          std::string_view key_view, ValueType* value_ptr,
+          const std::size_t arg_value_length = sizeof(ValueType),
+          const value_align_type value_align =
+                  static_cast<value_align_type>(alignof(ValueType))) {
+    tree_instance* ti{};
+    status ret{storage::find_storage(storage_name, &ti)};
+    if (status::OK != ret) { return status::WARN_STORAGE_NOT_EXIST; }
+    return overwrite(token, ti, key_view, value_ptr, arg_value_length, value_align);
+}
+
+template<class ValueType>
+[[maybe_unused]] static status
+overwrite(Token token, const storage_handle& storage, // NOLINT
+          std::string_view key_view, ValueType* value_ptr,
+          const std::size_t arg_value_length = sizeof(ValueType),
+          const value_align_type value_align =
+                  static_cast<value_align_type>(alignof(ValueType))) {
+    tree_instance* ti{storage.get()};
+    if (ti == nullptr) { return status::WARN_STORAGE_NOT_EXIST; }
+    return overwrite(token, ti, key_view, value_ptr, arg_value_length, value_align);
+}
+
+} // namespace yakushima
@@ -73,11 +73,11 @@ interior_split(tree_instance* ti, interior_node* const interior,
     /**
      * split keys among n and n'
      */
-    key_slice_type pivot_key_pos = key_slice_length / 2;
+    key_slice_type pivot_key_pos = interior_key_slice_length / 2;
     std::size_t split_children_points = pivot_key_pos + 1;
     interior->move_key_to_base_range(new_interior, split_children_points);
     interior->set_n_keys(pivot_key_pos);
-    new_interior->set_n_keys(key_slice_length - pivot_key_pos - 1);
+    new_interior->set_n_keys(interior_key_slice_length - pivot_key_pos - 1);
     interior->move_children_to_interior_range(new_interior,
                                               split_children_points);
     key_slice_type pivot_key = interior->get_key_slice_at(pivot_key_pos);
@@ -95,15 +95,8 @@ interior_split(tree_instance* ti, interior_node* const interior,
         LOG(ERROR) << log_location_prefix;
     }
 #endif
-    std::size_t comp_length{0};
-    if (key_length > sizeof(key_slice_type) &&
-        pivot_length > sizeof(key_slice_type)) {
-        comp_length = 8;
-    } else {
-        comp_length = key_length < pivot_length ? key_length : pivot_length;
-    }
-    int ret_memcmp = memcmp(&key_slice, &pivot_key, comp_length);
-    if (ret_memcmp < 0 || (ret_memcmp == 0 && key_length < pivot_length)) {
+    if (key_slice < pivot_key ||
+        (key_slice == pivot_key && key_length < pivot_length)) {
         child_node->set_parent(interior); // guard by parent lock
         interior->insert(child_node, inserting_key);
     } else {
@@ -144,7 +137,7 @@ interior_split(tree_instance* ti, interior_node* const interior,
     }
 #endif
     if (p->get_version_border()) {
-        auto* pb = dynamic_cast<border_node*>(p);
+        auto* pb = static_cast<border_node*>(p);
         base_node* new_p{};
         create_interior_parent_of_interior(
                 interior, new_interior, std::make_pair(pivot_key, pivot_length),
@@ -158,11 +151,11 @@ interior_split(tree_instance* ti, interior_node* const interior,
         p->version_unlock();
         return;
     }
-    auto* pi = dynamic_cast<interior_node*>(p);
+    auto* pi = static_cast<interior_node*>(p);
     interior->version_unlock();
     new_interior->set_parent(pi); // guard by parent lock
     new_interior->version_unlock();
-    if (pi->get_n_keys() == key_slice_length) {
+    if (pi->get_n_keys() == interior_key_slice_length) {
         /**
          * parent interior full case.
          */
@@ -202,11 +195,11 @@ interior_node::delete_of(Token token, tree_instance* ti, base_node* const child)
                     set_version_root(false); // guard by parent lock
                     //pn->set_version_inserting_deleting(true);
                     if (pn->get_version_border()) { // if this node is layer 1+ root
-                        link_or_value* lv = dynamic_cast<border_node*>(pn)->get_lv(this);
+                        link_or_value* lv = static_cast<border_node*>(pn)->get_lv(this);
                         lv->set_next_layer(sibling);
                         sibling->atomic_set_version_root(true); // guard by parent lock
                     } else {
-                        dynamic_cast<interior_node*>(pn)->swap_child(this, sibling);
+                        static_cast<interior_node*>(pn)->swap_child(this, sibling);
                     }
                     sibling->set_parent(pn); // guard by parent lock
                     pn->version_unlock();
@@ -12,8 +12,11 @@
 #include "base_node.h"
 #include "destroy_manager.h"
 #include "garbage_collection.h"
+#include "key_search.h"
 #include "link_or_value.h"
 #include "log.h"
+#include "node_keys.h"
+#include "node_pool.h"
 #include "thread_info.h"
 #include "tree_instance.h"
 
@@ -22,18 +25,28 @@
 namespace yakushima {
 
 class alignas(CACHE_LINE_SIZE) interior_node final // NOLINT
-    : public base_node {                           // NOLINT
+    : public base_node,
+      public node_keys<interior_key_slice_length> {
 public:
+    /**
+     * @brief The nodes are allocated from node_pool.
+     */
+    static void* operator new([[maybe_unused]] std::size_t size) {
+        return node_pool<interior_node>::allocate();
+    }
+
+    static void operator delete(void* const p) {
+        node_pool<interior_node>::deallocate(p);
+    }
+
     /**
      * @details The structure is "ptr, key, ptr, key, ..., ptr".
-     * So the child_length is key_slice_length plus 1.
+     * So the child_length is interior_key_slice_length plus 1.
      */
-    static constexpr std::size_t child_length = key_slice_length + 1;
+    static constexpr std::size_t child_length = interior_key_slice_length + 1;
     using n_keys_body_type = std::uint8_t;
     using n_keys_type = std::atomic<n_keys_body_type>;
 
-    ~interior_node() override{}; // NOLINT
-
     /**
      * @pre There is a child which is the same to @a child.
      * @a this interior node is locked by caller.
@@ -50,13 +63,13 @@ public:
      * @brief release all heap objects and clean up.
      * @pre This function is called by single thread.
      */
-    status destroy() override {
+    status destroy() {
         std::vector<std::thread> th_vc;
         th_vc.reserve(n_keys_ + 1);
         for (auto i = 0; i < n_keys_ + 1; ++i) {
             auto process = [this, i] {
                 get_child_at(i)->destroy();
-                delete get_child_at(i); // NOLINT
+                delete_node(get_child_at(i));
             };
             if (destroy_manager::check_room()) {
                 th_vc.emplace_back(process);
@@ -75,8 +88,9 @@ public:
     /**
      * @details display function for analysis and debug.
      */
-    void display() override {
+    void display() {
         display_base();
+        display_keys();
 
         std::cout << "interior_node::display\n";
         std::cout << "nkeys_ : " << std::to_string(get_n_keys()) << "\n";
@@ -93,7 +107,7 @@ public:
      * @param mem_stat the stack of memory usage for each level.
      */
     void mem_usage(std::size_t level,
-                   memory_usage_stack& mem_stat) const override {
+                   memory_usage_stack& mem_stat) const {
         if (mem_stat.size() <= level) { mem_stat.emplace_back(0, 0, 0); }
         auto& [node_num, used, reserved] = mem_stat.at(level);
 
@@ -117,40 +131,34 @@ public:
         return loadAcquireN(children.at(index));
     }
 
+    /**
+     * @brief The first half of get_child_of, which doesn't read the child.
+     * @details The caller validates the step as get_child_of does, after it reads the
+     * version of the child.
+     */
+    [[nodiscard]] base_node* peek_child_of(const key_slice_type key_slice,
+                                           const key_length_type key_length) {
+        n_keys_body_type n_key = get_n_keys();
+        /**
+         * The key_slice must be left direction of the first separator which is
+         * greater than it. See key_search.h.
+         */
+        return children.at(search_child_index(get_key_slice_ref(),
+                                              get_key_length_ref(), n_key,
+                                              key_slice, key_length));
+    }
+
     base_node* get_child_of(const key_slice_type key_slice,
                             const key_length_type key_length,
                             node_version64_body& v) {
         base_node* ret_child{};
         for (;;) {
-            n_keys_body_type n_key = get_n_keys();
-            ret_child = nullptr;
-            for (auto i = 0; i < n_key; ++i) {
-                std::size_t comp_length = key_length < get_key_length_at(i)
-                                                  ? key_length
-                                                  : get_key_length_at(i);
-                int ret_memcmp = memcmp(&key_slice, &get_key_slice_ref().at(i),
-                                        comp_length > sizeof(key_slice_type)
-                                                ? sizeof(key_slice_type)
-                                                : comp_length);
-                if (ret_memcmp < 0 ||
-                    (ret_memcmp == 0 && key_length < get_key_length_at(i))) {
-                    /**
-                     * The key_slice must be left direction of the index.
-                     */
-                    ret_child = children.at(i);
-                    break;
-                }
-            }
+            ret_child = peek_child_of(key_slice, key_length);
             if (ret_child == nullptr) {
-                /**
-                 * The key_slice must be right direction of the index.
-                 */
-                ret_child = children.at(n_key);
-                if (ret_child == nullptr) {
-                    // SMOs have found, so retry from a root node
-                    break;
-                }
+                // SMOs have found, so retry from a root node
+                break;
             }
+            ret_child->prefetch_header();
 
             // get child's status before rechecking version
             node_version64_body child_v = ret_child->get_stable_version();
@@ -170,8 +178,31 @@ public:
         return ret_child;
     }
 
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+    /**
+     * @brief offsets for the layout verification. See node_layout_test.cpp.
+     */
+    [[nodiscard]] static constexpr std::size_t key_length_offset() {
+        return offsetof(interior_node, key_length_);
+    }
+
+    [[nodiscard]] static constexpr std::size_t key_slice_offset() {
+        return offsetof(interior_node, key_slice_);
+    }
+
+    [[nodiscard]] static constexpr std::size_t n_keys_offset() {
+        return offsetof(interior_node, n_keys_);
+    }
+
+    [[nodiscard]] static constexpr std::size_t children_offset() {
+        return offsetof(interior_node, children);
+    }
+#pragma GCC diagnostic pop
+
     void init_interior() {
         init_base();
+        init_keys();
         set_version_border(false);
         children.fill(nullptr);
         set_n_keys(0);
@@ -192,19 +223,10 @@ public:
         key_length_type key_length{pivot_key.second};
         n_keys_body_type n_key = get_n_keys();
         for (auto i = 0; i < n_key; ++i) {
-            std::size_t comp_length{0};
-            if (key_length > sizeof(key_slice_type) &&
-                get_key_length_at(i) > sizeof(key_slice_type)) {
-                comp_length = 8;
-            } else {
-                comp_length = key_length < get_key_length_at(i)
-                                      ? key_length
-                                      : get_key_length_at(i);
-            }
-            int ret_memcmp =
-                    memcmp(&key_slice, &get_key_slice_ref().at(i), comp_length);
-            if (ret_memcmp < 0 ||
-                (ret_memcmp == 0 && key_length < get_key_length_at(i))) {
+            key_slice_type target_key_slice = get_key_slice_at(i);
+            if (key_slice < target_key_slice ||
+                (key_slice == target_key_slice &&
+                 key_length < get_key_length_at(i))) {
                 if (i == 0) { // insert to child[0] or child[1].
                     shift_right_base_member(i, 1);
                     set_key(i, key_slice, key_length);
@@ -306,4 +328,13 @@ private:
     std::array<base_node*, child_length> children{};
 };
 
+// a search reads the version, the keys and the number of keys, packed at the head.
+static_assert(interior_node::key_length_offset() == sizeof(base_node));
+static_assert(interior_node::key_slice_offset() <
+              interior_node::key_length_offset() + interior_key_slice_length +
+                      alignof(key_slice_type));
+static_assert(interior_node::n_keys_offset() ==
+              interior_node::key_slice_offset() +
+                      sizeof(key_slice_type) * interior_key_slice_length);
+
 } // namespace yakushima
@@ -0,0 +1,175 @@
+/**
+ * @file key_search.h
+ * @brief vectorized search over the key slices of a node.
+ * @details The AVX2 path is used when the translation unit is compiled with AVX2
+ * (e.g. -march=native on a recent x86 host), the SSE4.2 path otherwise if available,
+ * and a scalar loop as the last resort. All paths return the same result.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#if defined(__AVX2__) || defined(__SSE4_2__)
+
+#include <immintrin.h>
+
+#endif
+
+#include "scheme.h"
+
+namespace yakushima {
+
+/**
+ * @brief It compares @a key_slice against all slots of @a slices at once.
+ * @details The slots are compared as a whole regardless of the permutation, so
+ * the caller must mask the result with the live slots.
+ * @tparam Width the number of keys of the node, at most 64.
+ * @param[in] slices key slices of a node.
+ * @param[in] key_slice the probe.
+ * @return bit mask whose i-th bit is set iff slices[i] equals @a key_slice.
+ */
+template<std::size_t Width>
+[[nodiscard]] static inline std::uint64_t
+match_key_slice(const std::array<key_slice_type, Width>& slices,
+                const key_slice_type key_slice) {
+    std::uint64_t mask{0};
+    std::size_t i{0};
+#if defined(__AVX2__)
+    const __m256i probe =
+            _mm256_set1_epi64x(static_cast<long long>(key_slice)); // NOLINT
+    for (; i + 4 <= Width; i += 4) {
+        __m256i s = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(&slices[i])); // NOLINT
+        auto m = static_cast<std::uint64_t>(
+                _mm256_movemask_pd(_mm256_castsi256_pd(
+                        _mm256_cmpeq_epi64(s, probe))));
+        mask |= m << i;
+    }
+    if constexpr (Width % 4 != 0) {
+        // masked load does not touch the memory beyond the array.
+        constexpr std::size_t rest = Width % 4;
+        const __m256i load_mask = _mm256_set_epi64x(
+                0, rest > 2 ? -1 : 0, rest > 1 ? -1 : 0, -1);
+        __m256i s = _mm256_maskload_epi64(
+                reinterpret_cast<const long long*>(&slices[i]), // NOLINT
+                load_mask);
+        auto m = static_cast<std::uint64_t>(
+                _mm256_movemask_pd(_mm256_castsi256_pd(
+                        _mm256_cmpeq_epi64(s, probe))));
+        mask |= (m & ((1ULL << rest) - 1)) << i;
+        i += rest;
+    }
+#elif defined(__SSE4_2__)
+    const __m128i probe =
+            _mm_set1_epi64x(static_cast<long long>(key_slice)); // NOLINT
+    for (; i + 2 <= Width; i += 2) {
+        __m128i s = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(&slices[i])); // NOLINT
+        auto m = static_cast<std::uint64_t>(_mm_movemask_pd(
+                _mm_castsi128_pd(_mm_cmpeq_epi64(s, probe))));
+        mask |= m << i;
+    }
+#endif
+    for (; i < Width; ++i) {
+        mask |= static_cast<std::uint64_t>(slices[i] == key_slice) << i;
+    }
+    return mask;
+}
+
+/**
+ * @brief It compares @a key_slice against all slots of @a slices at once.
+ * @details Slices are big-endian, so the comparison is an unsigned one.
+ * @param[in] slices key slices of a node.
+ * @param[in] key_slice the probe.
+ * @return bit mask whose i-th bit is set iff slices[i] is less than @a key_slice.
+ */
+template<std::size_t Width>
+[[nodiscard]] static inline std::uint64_t
+less_key_slice(const std::array<key_slice_type, Width>& slices,
+               const key_slice_type key_slice) {
+    std::uint64_t mask{0};
+    std::size_t i{0};
+#if defined(__AVX2__)
+    // there is no unsigned 64-bit compare, so flip the sign bits.
+    const __m256i sign = _mm256_set1_epi64x(
+            static_cast<long long>(1ULL << 63)); // NOLINT
+    const __m256i probe = _mm256_xor_si256(
+            _mm256_set1_epi64x(static_cast<long long>(key_slice)), // NOLINT
+            sign);
+    for (; i + 4 <= Width; i += 4) {
+        __m256i s = _mm256_xor_si256(
+                _mm256_loadu_si256(
+                        reinterpret_cast<const __m256i*>(&slices[i])), // NOLINT
+                sign);
+        auto m = static_cast<std::uint64_t>(
+                _mm256_movemask_pd(_mm256_castsi256_pd(
+                        _mm256_cmpgt_epi64(probe, s))));
+        mask |= m << i;
+    }
+#elif defined(__SSE4_2__)
+    const __m128i sign = _mm_set1_epi64x(
+            static_cast<long long>(1ULL << 63)); // NOLINT
+    const __m128i probe = _mm_xor_si128(
+            _mm_set1_epi64x(static_cast<long long>(key_slice)), // NOLINT
+            sign);
+    for (; i + 2 <= Width; i += 2) {
+        __m128i s = _mm_xor_si128(
+                _mm_loadu_si128(
+                        reinterpret_cast<const __m128i*>(&slices[i])), // NOLINT
+                sign);
+        auto m = static_cast<std::uint64_t>(_mm_movemask_pd(
+                _mm_castsi128_pd(_mm_cmpgt_epi64(probe, s))));
+        mask |= m << i;
+    }
+#endif
+    for (; i < Width; ++i) {
+        mask |= static_cast<std::uint64_t>(slices[i] < key_slice) << i;
+    }
+    return mask;
+}
+
+/**
+ * @brief lower bound over the sorted separators of an interior node.
+ * @details A key goes to the left of separator i iff it is less than the separator,
+ * where equal slices are ordered by key length. So the child index is the number of
+ * separators which are not greater than the key.
+ * @param[in] slices separator slices.
+ * @param[in] lengths separator lengths.
+ * @param[in] n_keys the number of valid separators.
+ * @param[in] key_slice
+ * @param[in] key_length
+ * @return the index of the child which covers the key.
+ */
+template<std::size_t Width>
+[[nodiscard]] static inline std::size_t
+search_child_index(const std::array<key_slice_type, Width>& slices,
+                   const std::array<key_length_type, Width>& lengths,
+                   const std::size_t n_keys, const key_slice_type key_slice,
+                   const key_length_type key_length) {
+    static_assert(Width < 64);
+#if !defined(__AVX2__) && !defined(__SSE4_2__)
+    // without vector compares, the early exit of a plain scan wins.
+    for (std::size_t i = 0; i < n_keys; ++i) {
+        if (key_slice < slices[i] ||
+            (key_slice == slices[i] && key_length < lengths[i])) {
+            return i;
+        }
+    }
+    return n_keys;
+#else
+    const std::uint64_t live = (1ULL << n_keys) - 1;
+    std::uint64_t not_greater = less_key_slice(slices, key_slice) & live;
+    // equal slices are rare, so the tie-break by length is resolved per candidate.
+    std::uint64_t equal = match_key_slice(slices, key_slice) & live;
+    while (equal != 0) {
+        auto i = static_cast<std::size_t>(__builtin_ctzll(equal));
+        not_greater |= static_cast<std::uint64_t>(lengths[i] <= key_length) << i;
+        equal &= equal - 1;
+    }
+    return static_cast<std::size_t>(__builtin_popcountll(not_greater));
+#endif
+}
+
+} // namespace yakushima
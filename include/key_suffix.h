@@ -0,0 +1,87 @@
+/**
+ * @file key_suffix.h
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string_view>
+#include <tuple>
+
+#include "scheme.h"
+#include "value_pool.h"
+
+namespace yakushima {
+
+/**
+ * @brief The rest of a key after its key slice, which a border node holds instead of
+ * creating a next layer while no other key shares the key slice.
+ * @details It is immutable after creation, so readers can compare it optimistically and
+ * validate with the version of the border node. It is released by the garbage collection
+ * like a value, since readers may refer to it until their epoch ends.
+ */
+class key_suffix {
+public:
+    /**
+     * @brief Create a new key suffix with dynamic memory allocation.
+     * @param[in] suffix The rest of the key after the key slice.
+     * @param[in] pool The pool of the session which allocates the memory. If this is
+     * nullptr, it is allocated from the heap.
+     * @return The pointer to the new key suffix.
+     */
+    [[nodiscard]] static key_suffix* create_key_suffix(std::string_view suffix,
+                                                       value_pool* pool = nullptr) {
+        auto len = static_cast<std::uint32_t>(suffix.size());
+        auto* page = value_pool::allocate_block(alloc_size(len), kAlign, pool);
+        auto* ks = new (page) key_suffix{len}; // NOLINT
+        memcpy(ks->get_body(), suffix.data(), suffix.size());
+        return ks;
+    }
+
+    /**
+     * @brief Release the given key suffix.
+     * @param[in] ks The key suffix to be deleted.
+     */
+    static void delete_key_suffix(key_suffix* ks) {
+        value_pool::release_block(ks, alloc_size(ks->len_), kAlign);
+    }
+
+    /**
+     * @retval 1st: The address of the given key suffix.
+     * @retval 2nd: The allocated memory size for the given key suffix.
+     * @retval 3rd: The alignment size of the given key suffix.
+     */
+    [[nodiscard]] static std::tuple<void*, std::size_t, value_align_type>
+    get_gc_info(key_suffix* ks) {
+        return {ks, alloc_size(ks->len_), kAlign};
+    }
+
+    [[nodiscard]] std::string_view get_view() const {
+        return {reinterpret_cast<const char*>(this + 1), len_}; // NOLINT
+    }
+
+    [[nodiscard]] std::size_t get_alloc_size() const { return alloc_size(len_); }
+
+private:
+    static constexpr auto kAlign =
+            static_cast<value_align_type>(alignof(std::uint32_t));
+
+    explicit key_suffix(std::uint32_t len) : len_(len) {}
+
+    [[nodiscard]] static std::size_t alloc_size(std::uint32_t len) {
+        return sizeof(key_suffix) + len;
+    }
+
+    [[nodiscard]] char* get_body() {
+        return reinterpret_cast<char*>(this + 1); // NOLINT
+    }
+
+    /**
+     * @brief The length of the suffix, which follows this header.
+     */
+    std::uint32_t len_{0};
+};
+
+} // namespace yakushima
@@ -16,7 +16,11 @@
 #include "interface_put.h"
 #include "interface_remove.h"
 #include "interface_scan.h"
+#include "interface_batch.h"
+#include "interface_update.h"
+#include "interface_bulk_load.h"
 #include "storage.h"
+#include "storage_handle.h"
 #include "storage_impl.h"
 
 namespace yakushima {
@@ -24,8 +28,15 @@ namespace yakushima {
 /**
  * @brief Initialize kThreadInfoTable which is a table that holds thread execution
  * information about garbage collection and invoke epoch thread.
+ * @param[in] use_huge_page_arena If this is true, the nodes and the values of at most
+ * YAKUSHIMA_VALUE_POOL_MAX_SIZE bytes are allocated from the region which is backed by
+ * huge pages (see huge_page_arena), which reduces the TLB misses of a large tree. If the
+ * region can't be reserved, they are allocated from the heap. Default is false.
+ * @param[in] placement The placement of the region on the NUMA nodes. With LOCAL, a
+ * session allocates from the part on the NUMA node where it entered. Default is NONE.
  */
-[[maybe_unused]] static void init(); // NOLINT
+[[maybe_unused]] static void init(bool use_huge_page_arena, // NOLINT
+                                  numa_policy placement);
 
 /**
  * @brief Delete all tree from the root, release all heap objects, and join epoch thread.
@@ -54,10 +65,10 @@ mem_usage(std::string_view storage_name); // NOLINT
 
 /**
  * @brief Create storage
+ * @details It may run in parallel with the other DDL operations and DML operations. The
+ * operations with @a storage_name find the storage after this returns.
  * @param [in] storage_name
- * @attention Do not treat DDL operations in parallel with DML operations.
- * create_storage / delete_storage can be processed in parallel.
- * At least one of these and find_storage / list_storage cannot work in parallel.
+ * @attention Do not run it in parallel with init, fin or destroy.
  * @return Same to put function.
  */
 [[maybe_unused]] static status create_storage(std::string_view storage_name) {
@@ -66,10 +77,16 @@ mem_usage(std::string_view storage_name); // NOLINT
 
 /**
  * @brief Delete existing storage and values under the storage
+ * @details The storage is removed from the storage table at once, so it can't be found
+ * from then on. The tree of it is destroyed by the gc thread after all sessions which
+ * could find it leave, so this may run in parallel with DML operations on the storage.
+ * They work on the detached tree until they finish, and the storage handles of it keep
+ * referring it.
  * @param [in] storage_name
- * @attention Do not treat DDL operations in parallel with DML operations.
- * create_storage / delete_storage can be processed in parallel.
- * At least one of these and find_storage / list_storage cannot work in parallel.
+ * @attention Do not run it in parallel with init, fin or destroy. The tree_instance
+ * pointers which find_storage or list_storages gave must not be used after the sessions
+ * which were in at the time of the deletion leave. Use storage_handle to refer the
+ * storage beyond that.
  * @return status::OK if successful.
  * @return status::WARN_CONCURRENT_OPERATIONS if it can find the storage,
  * but This function failed because it was preceded by concurrent delete_storage.
@@ -86,10 +103,11 @@ mem_usage(std::string_view storage_name); // NOLINT
  * @param [in] storage_name
  * @param [out] found_storage output parameter to pass tree_instance information. If this
  * is nullptr (by default argument), this function simply note the existence of target.
- * The address obtained here can be safely accessed until the storage is deleted_storage.
- * @attention Do not treat DDL operations in parallel with DML operations.
- * create_storage / delete_storage can be processed in parallel.
- * At least one of these and find_storage / list_storage cannot work in parallel.
+ * The address obtained here can be safely accessed until the storage is deleted_storage
+ * and the session which was in at the time of the deletion leaves.
+ * @attention It may run in parallel with create_storage, delete_storage and DML
+ * operations, but use @a found_storage in a session which the caller entered before this,
+ * or a concurrent delete_storage may reclaim it.
  * @return status::OK if existence.
  * @return status::WARN_NOT_EXIST if not existence.
  */
@@ -99,13 +117,30 @@ find_storage(std::string_view storage_name,
     return storage::find_storage(storage_name, found_storage);
 }
 
+/**
+ * @brief Find existing storage and get the handle of it.
+ * @details The operations with @a found_storage skip the search of the storage by the
+ * name, which is a search of the storage table. @a found_storage keeps referring the
+ * storage even after delete_storage, and the operations with it return
+ * status::WARN_STORAGE_NOT_EXIST from then on.
+ * @param [in] storage_name
+ * @param [out] found_storage The handle of the storage. It is not changed if the storage
+ * is not found.
+ * @return status::OK if existence.
+ * @return status::WARN_NOT_EXIST if not existence.
+ */
+[[maybe_unused]] static status find_storage(std::string_view storage_name,
+                                            storage_handle& found_storage) {
+    return storage::find_storage(storage_name, found_storage);
+}
+
 /**
  * @brief List existing storage
  * @param [out] out output parameter to pass list of existing storage.
  * The address obtained here can be safely accessed until the storage is deleted_storage.
- * @attention Do not treat DDL operations in parallel with DML opeartions.
- * create_storage / delete_storage can be processed in parallel.
- * At least one of these and find_storage / list_storage cannot work in parallel.
+ * @attention It may run in parallel with create_storage, delete_storage and DML
+ * operations, but use the addresses in @a out in a session which the caller entered before
+ * this, or a concurrent delete_storage may reclaim them.
  * @return status::OK if it found.
  * @return status::WARN_NOT_EXIST if it found no storage.
  */
@@ -123,9 +158,19 @@ list_storages(std::vector<std::pair<std::string, tree_instance*>>& out) {
  * @return status::OK success.
  * @return status::WARN_MAX_SESSIONS The maximum number of sessions is already up and
  * running.
+ * It records the NUMA node of the caller, from which the session allocates the values
+ * when init enabled the huge page arena with numa_policy::LOCAL.
  */
 [[maybe_unused]] static status enter(Token& token); // NOLINT
 
+/**
+ * @param[in] token A session which entered.
+ * @return The id of the NUMA node of the caller of enter, or the first online node if the
+ * huge page arena is disabled, since the node is only used to place the blocks of the
+ * arena.
+ */
+[[maybe_unused]] static std::size_t get_numa_node(Token token); // NOLINT
+
 /**
  * @details It declares that the session ends. Values read during the session may be
  * invalidated from now on. It will clean up the contents of GC containers that have been
@@ -161,6 +206,99 @@ get(std::string_view storage_name, // NOLINT
     std::string_view key_view, std::pair<ValueType*, std::size_t>& out,
     std::pair<node_version64_body, node_version64*>* checked_version);
 
+/**
+ * @brief Get value which is corresponding to given @a key_view, starting from the border
+ * node which @a hint remembers.
+ * @details If the key belongs to the border node which the last operation with @a hint
+ * reached, it skips the descent from the root. Otherwise it descends as usual. Then
+ * @a hint remembers the border node of this operation. This helps when the keys of
+ * consecutive operations are near to each other.
+ * @pre @a token of arguments is valid. @a hint is not shared with other sessions
+ * concurrently.
+ * @param[in] token
+ * @param[in,out] hint
+ * @param[in] storage_name The key_view of storage name.
+ * @param[in] key_view The key_view of key-value.
+ * @param[out] out The result about pointer to value and value size.
+ * The address obtained here can be accessed safely until the Token entered at the time of address acquisition leaves.
+ * @return Same to get function.
+ */
+template<class ValueType>
+[[maybe_unused]] static status
+get(Token token, cursor_hint& hint, std::string_view storage_name, // NOLINT
+    std::string_view key_view, std::pair<ValueType*, std::size_t>& out);
+
+/**
+ * @brief Get value from the storage of @a storage, which is obtained by find_storage.
+ * @details The overloads of get / put / remove / scan / iscan_open with a storage handle
+ * are same to the ones with a storage name, except they don't search the storage.
+ * @return Same to get function. status::WARN_STORAGE_NOT_EXIST if the storage was
+ * deleted.
+ */
+template<class ValueType>
+[[maybe_unused]] static status
+get(const storage_handle& storage, // NOLINT
+    std::string_view key_view, std::pair<ValueType*, std::size_t>& out,
+    std::pair<node_version64_body, node_version64*>* checked_version);
+
+template<class ValueType>
+[[maybe_unused]] static status
+get(Token token, cursor_hint& hint, const storage_handle& storage, // NOLINT
+    std::string_view key_view, std::pair<ValueType*, std::size_t>& out);
+
+/**
+ * @brief Get the values of @a keys at once.
+ * @details It advances the lookups of some keys in lock-step, and prefetches the next
+ * node of each key before it reads any of them, so the cache misses of the keys overlap.
+ * The number of keys in a group is YAKUSHIMA_GET_MANY_GROUP. It is faster than calling
+ * get for each key when the tree doesn't fit in the cache. Each key is got as get does,
+ * and it is not atomic among the keys.
+ * @tparam ValueType Same to get function.
+ * @param[in] storage_name The key_view of storage name.
+ * @param[in] keys The keys to get. They need not be sorted.
+ * @param[out] out The results of @a keys in the same order. An element is {nullptr, 0}
+ * if the key doesn't exist.
+ * The address obtained here can be accessed safely until the Token entered at the time of address acquisition leaves.
+ * @param[out] rets The status of each key, which is same to get function.
+ * @return status::OK success.
+ * @return status::WARN_STORAGE_NOT_EXIST The target storage of this operation
+ * does not exist.
+ */
+template<class ValueType>
+[[maybe_unused]] static status
+get_many(std::string_view storage_name, // NOLINT
+         const std::vector<std::string_view>& keys,
+         std::vector<std::pair<ValueType*, std::size_t>>& out,
+         std::vector<status>& rets);
+
+template<class ValueType>
+[[maybe_unused]] static status
+get_many(const storage_handle& storage, // NOLINT
+         const std::vector<std::string_view>& keys,
+         std::vector<std::pair<ValueType*, std::size_t>>& out,
+         std::vector<status>& rets);
+
+/**
+ * @brief Get the copy of the value with given @a key_view.
+ * @details Unlike get, the copy is consistent while overwrite or update changes the body
+ * of the value in place: it copies the body and retries if the version of the border
+ * node was changed meanwhile.
+ * @tparam ValueType Same to get function. An inline value is copied as the word itself.
+ * @param[in] storage_name The key_view of storage name.
+ * @param[in] key_view The key_view of key-value.
+ * @param[out] out The bytes of the value.
+ * @return Same to get function.
+ */
+template<class ValueType>
+[[maybe_unused]] static status
+get_copy(std::string_view storage_name, std::string_view key_view, // NOLINT
+         std::string& out);
+
+template<class ValueType>
+[[maybe_unused]] static status
+get_copy(const storage_handle& storage, std::string_view key_view, // NOLINT
+         std::string& out);
+
 /**
  * @biref Put the value with given @a key_view.
  * @pre @a token of arguments is valid.
@@ -229,6 +367,44 @@ put(Token token, std::string_view storage_name, // NOLINT
     value_align_type value_align, bool unique_restriction,
     std::nullptr_t);
 
+/**
+ * @brief Put the value with given @a key_view, starting from the border node which
+ * @a hint remembers.
+ * @details The usage of @a hint is same to get with a hint.
+ * @pre @a token of arguments is valid. @a hint is not shared with other sessions
+ * concurrently.
+ * @param[in] token
+ * @param[in,out] hint
+ * @return Same to put function.
+ */
+template<class ValueType>
+[[maybe_unused]] static status
+put(Token token, cursor_hint& hint, std::string_view storage_name, // NOLINT
+    std::string_view key_view, ValueType* value_ptr,
+    std::size_t arg_value_length, ValueType** created_value_ptr,
+    value_align_type value_align, bool unique_restriction);
+
+/**
+ * @brief Put the value to the storage of @a storage, which is obtained by find_storage.
+ * @return Same to put function. status::WARN_STORAGE_NOT_EXIST if the storage was
+ * deleted.
+ */
+template<class ValueType>
+[[maybe_unused]] static status
+put(Token token, const storage_handle& storage, // NOLINT
+    std::string_view key_view, ValueType* value_ptr,
+    std::size_t arg_value_length,
+    ValueType** created_value_ptr,
+    value_align_type value_align, bool unique_restriction,
+    inserted_node_info* inserted_node_info_ptr);
+
+template<class ValueType>
+[[maybe_unused]] static status
+put(Token token, cursor_hint& hint, const storage_handle& storage, // NOLINT
+    std::string_view key_view, ValueType* value_ptr,
+    std::size_t arg_value_length, ValueType** created_value_ptr,
+    value_align_type value_align, bool unique_restriction);
+
 /**
  * @pre @a token of arguments is valid.
  * @param[in] token
@@ -244,6 +420,262 @@ put(Token token, std::string_view storage_name, // NOLINT
                                       std::string_view storage_name,
                                       std::string_view key_view);
 
+/**
+ * @brief Remove the value with given @a key_view, starting from the border node which
+ * @a hint remembers.
+ * @details The usage of @a hint is same to get with a hint.
+ * @pre @a token of arguments is valid. @a hint is not shared with other sessions
+ * concurrently.
+ * @param[in] token
+ * @param[in,out] hint
+ * @return Same to remove function.
+ */
+[[maybe_unused]] static status remove(Token token, cursor_hint& hint, // NOLINT
+                                      std::string_view storage_name,
+                                      std::string_view key_view);
+
+/**
+ * @brief Remove the value from the storage of @a storage, which is obtained by
+ * find_storage.
+ * @return Same to remove function. status::WARN_STORAGE_NOT_EXIST if the storage was
+ * deleted.
+ */
+[[maybe_unused]] static status remove(Token token, // NOLINT
+                                      const storage_handle& storage,
+                                      std::string_view key_view);
+
+[[maybe_unused]] static status remove(Token token, cursor_hint& hint, // NOLINT
+                                      const storage_handle& storage,
+                                      std::string_view key_view);
+
+/**
+ * @brief Remove the value with given @a key_view and get the removed value.
+ * @details It is same to get and remove in one descent, and no other session changes
+ * the value between them.
+ * @pre @a token of arguments is valid.
+ * @tparam ValueType Same to get function.
+ * @param[in] token
+ * @param[in] storage_name
+ * @param[in] key_view The key_view of key-value.
+ * @param[out] out The removed value and its length, which are same to get. It is
+ * {nullptr, 0} if the key doesn't exist.
+ * The address obtained here can be accessed safely until the Token entered at the time of address acquisition leaves.
+ * @return Same to remove function.
+ */
+template<class ValueType>
+[[maybe_unused]] static status take(Token token, // NOLINT
+                                    std::string_view storage_name,
+                                    std::string_view key_view,
+                                    std::pair<ValueType*, std::size_t>& out);
+
+template<class ValueType>
+[[maybe_unused]] static status take(Token token, // NOLINT
+                                    const storage_handle& storage,
+                                    std::string_view key_view,
+                                    std::pair<ValueType*, std::size_t>& out);
+
+/**
+ * @brief Update the value of @a key_view in place by @a fn.
+ * @details It calls @a fn with the body of the value while it holds the lock of the
+ * border node, so the updates of a key by some sessions are serialized. Unlike get and
+ * put, it neither allocates a new value nor leaves the old value to the gc, which suits
+ * counters and statistics. It changes the version of the node as an insert does, so
+ * get_copy doesn't return a body which @a fn is writing. A session which got the address
+ * of the value by get may read it while @a fn writes it.
+ * @pre @a token of arguments is valid. @a fn doesn't call the functions of yakushima.
+ * @tparam ValueType Same to put function. An inline value is given to @a fn as a copy,
+ * which is stored back after @a fn.
+ * @param[in] token
+ * @param[in] storage_name
+ * @param[in] key_view The key_view of key-value.
+ * @param[in] fn The functor which is called as fn(ValueType*, std::size_t) with the
+ * body and the length of the value.
+ * @return status::OK success.
+ * @return status::WARN_NOT_EXIST The key doesn't exist.
+ * @return status::WARN_STORAGE_NOT_EXIST The target storage of this operation
+ * does not exist.
+ */
+template<class ValueType, class Fn>
+[[maybe_unused]] static status
+update(Token token, std::string_view storage_name, // NOLINT
+       std::string_view key_view, Fn&& fn);
+
+template<class ValueType, class Fn>
+[[maybe_unused]] static status
+update(Token token, const storage_handle& storage, // NOLINT
+       std::string_view key_view, Fn&& fn);
+
+/**
+ * @brief Update the value of @a key_view in place by @a fn, or put @a init_value_ptr if
+ * the key doesn't exist.
+ * @details @a fn is same to update function. @a fn is not called for the value which
+ * this puts.
+ * @param[in] init_value_ptr The pointer to the value which is put if the key doesn't
+ * exist.
+ * @param[in] arg_value_length Same to put function. Default is @a sizeof(ValueType).
+ * @param[in] value_align Same to put function. Default is @a
+ * static_cast<value_align_type>(alignof(ValueType)).
+ * @return status::OK success.
+ * @return status::WARN_STORAGE_NOT_EXIST The target storage of this operation
+ * does not exist.
+ */
+template<class ValueType, class Fn>
+[[maybe_unused]] static status
+upsert(Token token, std::string_view storage_name, // NOLINT
+       std::string_view key_view, Fn&& fn, ValueType* init_value_ptr,
+       std::size_t arg_value_length, value_align_type value_align);
+
+template<class ValueType, class Fn>
+[[maybe_unused]] static status
+upsert(Token token, const storage_handle& storage, // NOLINT
+       std::string_view key_view, Fn&& fn, ValueType* init_value_ptr,
+       std::size_t arg_value_length, value_align_type value_align);
+
+/**
+ * @brief Replace the value of @a key_view with @a desired_ptr only if it is @a expected.
+ * @details It compares and replaces the value while it holds the lock of the border
+ * node, which put, remove and update of the key also take, so no other writer changes
+ * the value between them. A non-inline value matches if @a expected has the same length
+ * and bytes as the value. @a expected must point to a copy which the caller owns, e.g.
+ * by get_copy: update and overwrite change the body in place, so the address which get
+ * returned would always have the current bytes, and an address in the body never
+ * matches. An inline value matches if it is same to @a expected.first.
+ * @pre @a token of arguments is valid.
+ * @param[in] token
+ * @param[in] storage_name
+ * @param[in] key_view The key_view of key-value.
+ * @param[in,out] expected The pointer to the expected value and its length. If the value
+ * doesn't match, it is set to the current value as get does, which is to be copied
+ * before it is passed again.
+ * The address obtained here can be accessed safely until the Token entered at the time of address acquisition leaves.
+ * @param[in] desired_ptr The pointer to the new value.
+ * @param[in] arg_value_length Same to put function. Default is @a sizeof(ValueType).
+ * @param[in] value_align Same to put function. Default is @a
+ * static_cast<value_align_type>(alignof(ValueType)).
+ * @return status::OK success.
+ * @return status::WARN_VALUE_MISMATCH The value is not @a expected.
+ * @return status::WARN_NOT_EXIST The key doesn't exist. @a expected is set to
+ * {nullptr, 0}.
+ * @return status::WARN_STORAGE_NOT_EXIST The target storage of this operation
+ * does not exist.
+ */
+template<class ValueType>
+[[maybe_unused]] static status
+compare_exchange(Token token, std::string_view storage_name, // NOLINT
+                 std::string_view key_view,
+                 std::pair<ValueType*, std::size_t>& expected,
+                 ValueType* desired_ptr, std::size_t arg_value_length,
+                 value_align_type value_align);
+
+template<class ValueType>
+[[maybe_unused]] static status
+compare_exchange(Token token, const storage_handle& storage, // NOLINT
+                 std::string_view key_view,
+                 std::pair<ValueType*, std::size_t>& expected,
+                 ValueType* desired_ptr, std::size_t arg_value_length,
+                 value_align_type value_align);
+
+/**
+ * @brief Put the value with given @a key_view, reusing the body of the current value if
+ * it has the same size.
+ * @details If the current value is not inline and it has the same length as @a
+ * arg_value_length and an alignment which satisfies @a value_align, it copies the new
+ * value into the body in place while it holds the lock of the border node, so it neither
+ * allocates a new value nor leaves the old value to the gc. Otherwise it is same to put.
+ * The in-place copy changes the version of the node as an insert does. The readers of
+ * the value should use get_copy, which validates the copy by the version. A session which
+ * got the address of the value by get may read it while it is written.
+ * @pre @a token of arguments is valid.
+ * @param[in] token
+ * @param[in] storage_name
+ * @param[in] key_view The key_view of key-value.
+ * @param[in] value_ptr The pointer to given value.
+ * @param[in] arg_value_length Same to put function. Default is @a sizeof(ValueType).
+ * @param[in] value_align Same to put function. Default is @a
+ * static_cast<value_align_type>(alignof(ValueType)).
+ * @return Same to put function without unique restriction.
+ */
+template<class ValueType>
+[[maybe_unused]] static status
+overwrite(Token token, std::string_view storage_name, // NOLINT
+          std::string_view key_view, ValueType* value_ptr,
+          std::size_t arg_value_length, value_align_type value_align);
+
+template<class ValueType>
+[[maybe_unused]] static status
+overwrite(Token token, const storage_handle& storage, // NOLINT
+          std::string_view key_view, ValueType* value_ptr,
+          std::size_t arg_value_length, value_align_type value_align);
+
+/**
+ * @brief Apply the puts and removes of @a batch in order.
+ * @details Each entry is same to put (without unique restriction) or remove. The
+ * entries which fall in the same border node are applied under one lock of the node
+ * without descending from the root again, so it is efficient when @a batch is sorted
+ * by key, as log replay or index maintenance produces. An unsorted batch is also
+ * applied correctly. The batch is not atomic: other sessions may see a part of it.
+ * @pre @a token of arguments is valid.
+ * @param[in] token
+ * @param[in] storage_name
+ * @param[in] batch The entries. The keys and the values are copied, so the caller can
+ * release them after this.
+ * @param[out] rets The result of each entry, which is same to put or remove.
+ * @return status::OK success.
+ * @return status::WARN_STORAGE_NOT_EXIST The target storage of this operation
+ * does not exist.
+ */
+template<class ValueType>
+[[maybe_unused]] static status
+apply_batch(Token token, std::string_view storage_name, // NOLINT
+            const std::vector<batch_entry<ValueType>>& batch,
+            std::vector<status>& rets);
+
+template<class ValueType>
+[[maybe_unused]] static status
+apply_batch(Token token, const storage_handle& storage, // NOLINT
+            const std::vector<batch_entry<ValueType>>& batch,
+            std::vector<status>& rets);
+
+/**
+ * @brief Build the tree of an empty storage from sorted key-values at once.
+ * @details It fills border nodes and builds the interior nodes and the next layers over
+ * them directly, so it doesn't pay for the descents, locks and splits of put. The tree
+ * becomes visible to other sessions when it is completed.
+ * @pre @a token of arguments is valid.
+ * @param[in] token The session whose value pool takes the values and the key suffixes.
+ * This enters the sessions of the other threads of @a parallelism, and it uses only as
+ * many threads as the free sessions allow rather than waiting for a session.
+ * @param[in] storage_name
+ * @param[in] entries The tuples of a key, a pointer to the value and the length of the
+ * value, which are same to put. The keys must be sorted and unique. The keys and the
+ * values are copied, so the caller can release them after this.
+ * @param[in] fill_factor The ratio of the slots of a node which it fills, in (0, 1].
+ * The rest of the slots take the later puts without splits. Default is 1.0.
+ * @param[in] parallelism The maximum number of threads which build the tree. Default is
+ * 1.
+ * @param[in] value_align The alignment of all the values, which is same to put.
+ * Default is @a static_cast<value_align_type>(alignof(ValueType)).
+ * @return status::OK success.
+ * @return status::ERR_BAD_USAGE The keys are not sorted or not unique, or the other
+ * arguments are out of range.
+ * @return status::WARN_EXIST The storage is not empty.
+ * @return status::WARN_STORAGE_NOT_EXIST The target storage of this operation
+ * does not exist.
+ */
+template<class ValueType>
+[[maybe_unused]] static status bulk_load(
+        Token token, std::string_view storage_name, // NOLINT
+        const std::vector<std::tuple<std::string_view, ValueType*, std::size_t>>&
+                entries,
+        double fill_factor, std::size_t parallelism, value_align_type value_align);
+
+template<class ValueType>
+[[maybe_unused]] static status bulk_load(
+        Token token, const storage_handle& storage, // NOLINT
+        const std::vector<std::tuple<std::string_view, ValueType*, std::size_t>>&
+                entries,
+        double fill_factor, std::size_t parallelism, value_align_type value_align);
+
 /**
  * TODO : add new 3 modes : try-mode : 1 trial : wait-mode : try until success : mid-mode
  * : middle between try and wait.
@@ -307,4 +739,19 @@ scan(std::string_view storage_name, std::string_view l_key, // NOLINT
      std::size_t max_size,
      bool right_to_left);
 
+/**
+ * @brief scan the storage of @a storage, which is obtained by find_storage.
+ * @return Same to scan function. status::WARN_STORAGE_NOT_EXIST if the storage was
+ * deleted.
+ */
+template<class ValueType>
+[[maybe_unused]] static status
+scan(const storage_handle& storage, std::string_view l_key, // NOLINT
+     scan_endpoint l_end, std::string_view r_key, scan_endpoint r_end,
+     std::vector<std::tuple<std::string, ValueType*, std::size_t>>& tuple_list,
+     std::vector<std::pair<node_version64_body, node_version64*>>*
+             node_version_vec,
+     std::size_t max_size,
+     bool right_to_left);
+
 } // namespace yakushima
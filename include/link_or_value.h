@@ -7,9 +7,15 @@
 #include "atomic_wrapper.h"
 #include "base_node.h"
 #include "cpu.h"
+#include "epoch.h"
+#include "garbage_collection.h"
+#include "key_suffix.h"
 #include "log.h"
 #include "value.h"
 
+#include <array>
+#include <cstddef>
+#include <cstring>
 #include <new>
 #include <typeinfo>
 
@@ -37,10 +43,13 @@ public:
     void destroy() {
         if (auto* child = get_next_layer(); child != nullptr) {
             child->destroy();
-            delete child; // NOLINT
+            base_node::delete_node(child);
         } else if (auto* v = get_value(); v != nullptr) {
             if (value::need_delete(v)) { value::delete_value(v); }
         }
+        if (auto* ks = get_key_suffix(); ks != nullptr) {
+            key_suffix::delete_key_suffix(ks);
+        }
         init_lv();
     }
 
@@ -64,6 +73,9 @@ public:
                          "value_length_ : " << value::get_len(v) << "\n"
                          "value_align_ : " << v_align << "\n";
         }
+        if (auto* ks = get_key_suffix(); ks != nullptr) {
+            std::cout << "key_suffix_length_ : " << ks->get_view().size() << "\n";
+        }
     }
 
     /**
@@ -81,6 +93,11 @@ public:
             used += v_len;
             reserved += v_len;
         }
+        if (auto* ks = get_key_suffix(); ks != nullptr) {
+            auto& [node_num, used, reserved] = mem_stat.at(level);
+            used += ks->get_alloc_size();
+            reserved += ks->get_alloc_size();
+        }
     }
 
     [[maybe_unused]] [[nodiscard]] const std::type_info* get_lv_type() const {
@@ -119,11 +136,26 @@ public:
         return reinterpret_cast<value*>(ptr); // NOLINT
     }
 
+    /**
+     * @brief Get the key suffix of the value.
+     *
+     * @retval The rest of the key after the key slice if the value has a key longer
+     * than the key slice.
+     * @retval nullptr otherwise.
+     */
+    [[nodiscard]] key_suffix* get_key_suffix() const {
+        return loadAcquireN(key_suffix_);
+    }
+
     /**
      * @brief Initialize the payload to zero.
      *
      */
-    void init_lv() { child_or_v_ = kValPtrFlag; }
+    void init_lv() {
+        vacate_in_node_area();
+        child_or_v_ = kValPtrFlag;
+        key_suffix_ = nullptr;
+    }
 
     /**
      * @details This is move process.
@@ -132,8 +164,14 @@ public:
     void set(link_or_value* const nlv) {
         /**
          * This object in this function is not accessed concurrently, so it can copy assign.
+         * The caller initializes @a nlv after this, which keeps its area for the readers.
          */
         *this = *nlv;
+        if (value::is_in_node(get_value())) {
+            // the value moved with the area.
+            child_or_v_ = reinterpret_cast<uintptr_t>(get_in_node_area()) | // NOLINT
+                          kValPtrFlag;
+        }
     }
 
     /**
@@ -145,6 +183,7 @@ public:
      */
     void set_value(value* new_value, void** const created_value_ptr,
                    value** old_value = nullptr) {
+        vacate_in_node_area();
         auto* cur_v = get_value();
         if (cur_v != nullptr && value::need_delete(cur_v)) {
             if (old_value == nullptr) {
@@ -155,7 +194,23 @@ public:
         }
 
         // store the given value
-        const auto ptr = reinterpret_cast<uintptr_t>(new_value); // NOLINT
+        if (value::is_in_node(new_value) && !is_in_node_area_free()) {
+            // readers may still have the address of the former value of the area.
+            new_value = value::copy_to_heap(new_value);
+        }
+        auto ptr = reinterpret_cast<uintptr_t>(new_value); // NOLINT
+        if (value::is_in_node(new_value)) {
+            /**
+             * The value is in the staging area of the thread or in another slot, so it is
+             * copied to the area of this slot, which no reader refers to.
+             */
+            auto* area = get_in_node_area();
+            if (reinterpret_cast<void*>(ptr & ~kValPtrFlag) != area) { // NOLINT
+                memcpy(area, reinterpret_cast<void*>(ptr & ~kValPtrFlag), // NOLINT
+                       value::kInNodeAreaSize);
+            }
+            ptr = reinterpret_cast<uintptr_t>(area) | kValPtrFlag; // NOLINT
+        }
         storeReleaseN(child_or_v_, ptr);
         if (created_value_ptr != nullptr) {
             auto* v_ptr = reinterpret_cast<value*>(child_or_v_); // NOLINT
@@ -168,11 +223,52 @@ public:
      * @param[in] new_next_layer
      */
     void set_next_layer(base_node* const new_next_layer) {
+        vacate_in_node_area();
         auto ptr = reinterpret_cast<uintptr_t>(new_next_layer); // NOLINT
         storeReleaseN(child_or_v_, ptr | kChildFlag);
     }
 
+    /**
+     * @param[in] new_key_suffix The key suffix of the value, or nullptr after the value
+     * is replaced by the next layer. The caller releases the old one.
+     */
+    void set_key_suffix(key_suffix* const new_key_suffix) {
+        storeReleaseN(key_suffix_, new_key_suffix);
+    }
+
 private:
+    [[nodiscard]] std::byte* get_in_node_area() {
+#if YAKUSHIMA_INLINE_VALUE_SIZE > 0
+        return in_node_.data();
+#else
+        return nullptr;
+#endif
+    }
+
+    /**
+     * @brief Record the epoch if the value in the area of this slot leaves it.
+     */
+    void vacate_in_node_area() {
+#if YAKUSHIMA_INLINE_VALUE_SIZE > 0
+        if (loadAcquireN(child_or_v_) ==
+            (reinterpret_cast<uintptr_t>(in_node_.data()) | kValPtrFlag)) { // NOLINT
+            in_node_epoch_ = epoch_management::get_epoch();
+        }
+#endif
+    }
+
+    /**
+     * @return Whether no reader refers to the area, so a new value can take it.
+     */
+    [[nodiscard]] bool is_in_node_area_free() const {
+#if YAKUSHIMA_INLINE_VALUE_SIZE > 0
+        return in_node_epoch_ == 0 ||
+               in_node_epoch_ < garbage_collection::get_gc_epoch();
+#else
+        return true;
+#endif
+    }
+
     /**
      * @brief A flag for indicating that the next layer exists.
      */
@@ -191,6 +287,28 @@ private:
      * Otherwise, this contains the pointer of a value.
      */
     uintptr_t child_or_v_{kValPtrFlag};
+
+    /**
+     * @attention
+     * This variable is read/write concurrently.
+     * It is not nullptr only if this contains a value whose key is longer than the key
+     * slice, and the rest of the key is here instead of the next layer.
+     */
+    key_suffix* key_suffix_{nullptr};
+
+    /**
+     * @brief The area which keeps a value that fits in the node: the header of the value
+     * followed by the body. child_or_v_ points to it.
+     */
+#if YAKUSHIMA_INLINE_VALUE_SIZE > 0
+    alignas(8) std::array<std::byte, value::kInNodeAreaSize> in_node_{};
+    /**
+     * @brief The epoch when a value left the area, or 0 if none did. Readers may keep
+     * the address of the value until their sessions leave, as for a value on the heap,
+     * so the area takes a new value after the epoch expires.
+     */
+    Epoch in_node_epoch_{0};
+#endif
 };
 
 } // namespace yakushima
@@ -0,0 +1,135 @@
+/**
+ * @file node_keys.h
+ * @brief sorted or permuted keys of a node, whose width depends on the node kind.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "atomic_wrapper.h"
+#include "scheme.h"
+
+namespace yakushima {
+
+/**
+ * @tparam Width the number of keys which the node holds.
+ */
+template<std::size_t Width>
+class node_keys {
+public:
+    static constexpr std::size_t width = Width;
+
+    void display_keys() const {
+        for (std::size_t i = 0; i < Width; ++i) {
+            std::cout << "key_slice_[" << i
+                      << "] : " << std::to_string(get_key_slice_at(i))
+                      << "\n"
+                      << "key_length_[" << i
+                      << "] : " << std::to_string(get_key_length_at(i))
+                      << "\n";
+        }
+    }
+
+    [[nodiscard]] const std::array<key_length_type, Width>&
+    get_key_length_ref() const {
+        return key_length_;
+    }
+
+    [[nodiscard]] key_length_type
+    get_key_length_at(const std::size_t index) const {
+        return key_length_.at(index);
+    }
+
+    [[nodiscard]] const std::array<key_slice_type, Width>&
+    get_key_slice_ref() const {
+        return key_slice_;
+    }
+
+    [[nodiscard]] key_slice_type
+    get_key_slice_at(const std::size_t index) const {
+        return key_slice_.at(index);
+    }
+
+    void init_keys() {
+        key_slice_.fill(0);
+        key_length_.fill(0);
+    }
+
+    /**
+     * @details init at @a pos as position.
+     * @param[in] pos This is a position (index) to be initialized.
+     */
+    void init_key_at(const std::size_t pos) { set_key(pos, 0, 0); }
+
+    [[maybe_unused]] void init_base_member_range(const std::size_t start) {
+        for (std::size_t i = start; i < Width; ++i) { set_key(i, 0, 0); }
+    }
+
+    [[maybe_unused]] void move_key_to_base_range(node_keys* const right,
+                                                 const std::size_t start) {
+        for (auto i = start; i < Width; ++i) {
+            right->set_key(i - start, get_key_slice_at(i),
+                           get_key_length_at(i));
+            set_key(i, 0, 0);
+        }
+    }
+
+    void set_key(const std::size_t index, const key_slice_type key_slice,
+                 const key_length_type key_length) {
+        set_key_slice_at(index, key_slice);
+        set_key_length_at(index, key_length);
+    }
+
+    void set_key_length_at(const std::size_t index,
+                           const key_length_type length) {
+        storeReleaseN(key_length_.at(index), length);
+    }
+
+    void set_key_slice_at(const std::size_t index,
+                          const key_slice_type key_slice) {
+        storeReleaseN(key_slice_.at(index), key_slice);
+    }
+
+    void shift_left_base_member(const std::size_t start_pos,
+                                const std::size_t shift_size) {
+        memmove(&key_slice_.at(start_pos - shift_size),
+                &key_slice_.at(start_pos),
+                sizeof(key_slice_type) * (Width - start_pos));
+        memmove(&key_length_.at(start_pos - shift_size),
+                &key_length_.at(start_pos),
+                sizeof(key_length_type) * (Width - start_pos));
+    }
+
+    void shift_right_base_member(const std::size_t start,
+                                 const std::size_t shift_size) {
+        memmove(&key_slice_.at(start + shift_size), &key_slice_.at(start),
+                sizeof(key_slice_type) * (Width - start - shift_size));
+        memmove(&key_length_.at(start + shift_size), &key_length_.at(start),
+                sizeof(key_length_type) * (Width - start - shift_size));
+    }
+
+protected:
+    /**
+     * The lengths come first since they are smaller, so they share the first line
+     * with the version of the node.
+     */
+
+    /**
+     * @attention This variable is read/written concurrently.
+     * @details This is used for distinguishing the identity of link or value and same
+     * slices. For example, key 1 : \0, key 2 : \0\0, ... , key 8 : \0\0\0\0\0\0\0\0. These
+     * keys have same key_slices (0) but different key_length. If the length is more than 8,
+     * the lv points out to next layer.
+     */
+    std::array<key_length_type, Width> key_length_{};
+    /**
+     * @attention This variable is read/written concurrently.
+     */
+    std::array<key_slice_type, Width> key_slice_{};
+};
+
+} // namespace yakushima
@@ -0,0 +1,156 @@
+/**
+ * @file node_pool.h
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "config.h"
+#include "huge_page_arena.h"
+
+namespace yakushima {
+
+/**
+ * @brief The free lists of the nodes of type @a Node.
+ * @details A thread allocates nodes from its own list without synchronization. The list
+ * is refilled in bulk, by taking all the nodes which were released, or by carving a chunk
+ * of YAKUSHIMA_NODE_POOL_CHUNK nodes, which keeps the nodes of a thread close in memory.
+ * The garbage collection releases the nodes whose epoch expired to the shared list. The
+ * threads only push to it and take all of it at once, so it is free from ABA. The chunks
+ * are kept until the process exits, and the released nodes are reused by the next init.
+ * The node splits don't know the session, so the lists belong to threads rather than
+ * sessions. While the huge page arena is enabled, the chunks are carved from the part
+ * of the arena for the NUMA node of the thread, and the shared list is kept for each
+ * NUMA node, so the released nodes are reused on the node where they are placed.
+ */
+template<class Node>
+class node_pool {
+public:
+    static void* allocate() {
+        if constexpr (YAKUSHIMA_NODE_POOL_CHUNK == 0) {
+            return ::operator new(sizeof(Node), std::align_val_t{alignof(Node)});
+        } else {
+            local_list& local = get_local_list();
+            if (local.head_ == nullptr) {
+                const std::size_t node = huge_page_arena::local_node();
+                local.head_ = released_.at(node).exchange(nullptr,
+                                                          std::memory_order_acquire);
+                if (local.head_ == nullptr && node != 0) {
+                    // the nodes of the heap and the nodes released while the arena was
+                    // disabled are in the list of node 0.
+                    local.head_ = released_.at(0).exchange(nullptr,
+                                                           std::memory_order_acquire);
+                }
+                if (local.head_ == nullptr) { local.head_ = carve_chunk(node); }
+            }
+            free_node* fn = local.head_;
+            local.head_ = fn->next_;
+            return fn;
+        }
+    }
+
+    /**
+     * @brief Release a node to the shared list. Any thread may call this.
+     */
+    static void deallocate(void* const node) {
+        if constexpr (YAKUSHIMA_NODE_POOL_CHUNK == 0) {
+            ::operator delete(node, sizeof(Node), std::align_val_t{alignof(Node)});
+        } else {
+            auto* fn = static_cast<free_node*>(node);
+            push_released(fn, fn);
+        }
+    }
+
+private:
+    struct free_node {
+        free_node* next_;
+    };
+
+    /**
+     * @brief The list of a thread, which returns its nodes to the shared list when the
+     * thread exits.
+     */
+    struct local_list {
+        local_list() = default;
+        local_list(const local_list&) = delete;
+        local_list& operator=(const local_list&) = delete;
+        ~local_list() {
+            if (head_ == nullptr) { return; }
+            free_node* tail = head_;
+            while (tail->next_ != nullptr) { tail = tail->next_; }
+            push_released(head_, tail);
+        }
+
+        free_node* head_{nullptr};
+    };
+
+    /**
+     * @brief The chunks of the heap, which are released when the process exits.
+     */
+    struct chunk_list {
+        chunk_list() = default;
+        chunk_list(const chunk_list&) = delete;
+        chunk_list& operator=(const chunk_list&) = delete;
+        ~chunk_list() {
+            for (auto* chunk : chunks_) {
+                ::operator delete(chunk, sizeof(Node) * YAKUSHIMA_NODE_POOL_CHUNK,
+                                  std::align_val_t{alignof(Node)});
+            }
+        }
+
+        std::mutex mtx_;
+        std::vector<void*> chunks_;
+    };
+
+    static local_list& get_local_list() {
+        thread_local local_list local{};
+        return local;
+    }
+
+    /**
+     * @pre The nodes from @a head to @a tail are placed on the same NUMA node.
+     */
+    static void push_released(free_node* const head, free_node* const tail) {
+        auto& released = released_.at(huge_page_arena::list_of(head));
+        tail->next_ = released.load(std::memory_order_relaxed);
+        while (!released.compare_exchange_weak(tail->next_, head,
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * @return The list of the nodes of a new chunk.
+     */
+    static free_node* carve_chunk(const std::size_t node) {
+        auto* chunk = static_cast<std::byte*>(huge_page_arena::allocate(
+                sizeof(Node) * YAKUSHIMA_NODE_POOL_CHUNK, alignof(Node), node));
+        if (chunk == nullptr) {
+            chunk = static_cast<std::byte*>(
+                    ::operator new(sizeof(Node) * YAKUSHIMA_NODE_POOL_CHUNK,
+                                   std::align_val_t{alignof(Node)}));
+            std::lock_guard<std::mutex> lk{chunks_.mtx_};
+            chunks_.chunks_.emplace_back(chunk);
+        }
+        free_node* head{nullptr};
+        for (std::size_t i = YAKUSHIMA_NODE_POOL_CHUNK; i > 0; --i) {
+            auto* fn = reinterpret_cast<free_node*>(chunk + (i - 1) * sizeof(Node)); // NOLINT
+            fn->next_ = head;
+            head = fn;
+        }
+        return head;
+    }
+
+    static inline std::array<std::atomic<free_node*>, // NOLINT
+                             YAKUSHIMA_MAX_NUMA_NODES>
+            released_{};
+    static inline chunk_list chunks_{};                       // NOLINT
+};
+
+} // namespace yakushima
@@ -0,0 +1,207 @@
+/**
+ * @file numa.h
+ */
+
+#pragma once
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#ifdef YAKUSHIMA_LINUX
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <linux/mempolicy.h>
+#endif
+
+#include "config.h"
+#include "log.h"
+
+#include "glog/logging.h"
+
+namespace yakushima {
+
+/**
+ * @brief The placement of the huge page arena on the NUMA nodes.
+ */
+enum class numa_policy : std::uint8_t {
+    /**
+     * @brief It leaves the placement to the kernel.
+     */
+    NONE,
+    /**
+     * @brief A thread allocates from the part of the arena which is placed on its NUMA
+     * node, and the released blocks go back to the part, so they are reused on the node.
+     */
+    LOCAL,
+    /**
+     * @brief The pages of the arena are interleaved over the NUMA nodes, which spreads
+     * the accesses from all the nodes evenly.
+     */
+    INTERLEAVE,
+};
+
+/**
+ * @brief The NUMA nodes which are online. The ids of the kernel may have gaps, e.g.
+ * "0,2", so the huge page arena and the pools number the nodes by their order in ids_,
+ * which is the index of the node.
+ */
+struct numa_nodes {
+    /**
+     * @brief The bits of the node mask of mbind, which is MAX_NUMNODES of the kernel.
+     */
+    static constexpr std::size_t kMaskBits = 1024;
+    static constexpr std::size_t kWordBits = sizeof(unsigned long) * 8; // NOLINT
+    using mask_type = std::array<unsigned long, kMaskBits / kWordBits>; // NOLINT
+
+    /**
+     * @brief The ids of the kernel of the nodes, which are at most
+     * YAKUSHIMA_MAX_NUMA_NODES.
+     */
+    std::array<std::size_t, YAKUSHIMA_MAX_NUMA_NODES> ids_{};
+    std::size_t num_{0};
+    /**
+     * @brief The node mask of ids_.
+     */
+    mask_type mask_{};
+};
+
+/**
+ * @param[in] online The list of the online nodes, e.g. "0", "0-3" or "0,2-3,5".
+ * @return The nodes of @a online, or node 0 if it has none.
+ */
+[[maybe_unused]] static numa_nodes parse_numa_nodes(std::string_view online) {
+    numa_nodes nodes{};
+    std::size_t pos{0};
+    auto read = [&online, &pos](std::size_t& n) {
+        const std::size_t begin = pos;
+        n = 0;
+        while (pos < online.size() && '0' <= online[pos] && online[pos] <= '9') {
+            n = n * 10 + static_cast<std::size_t>(online[pos] - '0');
+            ++pos;
+        }
+        return pos != begin;
+    };
+    for (;;) {
+        std::size_t first{0};
+        if (!read(first)) { break; }
+        std::size_t last{first};
+        if (pos < online.size() && online[pos] == '-') {
+            ++pos;
+            if (!read(last)) { break; }
+        }
+        for (std::size_t id = first; id <= last && id < numa_nodes::kMaskBits &&
+                                     nodes.num_ < YAKUSHIMA_MAX_NUMA_NODES;
+             ++id) {
+            nodes.ids_.at(nodes.num_++) = id;
+            nodes.mask_.at(id / numa_nodes::kWordBits) |=
+                    1UL << (id % numa_nodes::kWordBits);
+        }
+        if (pos >= online.size() || online[pos] != ',') { break; }
+        ++pos;
+    }
+    if (nodes.num_ == 0) {
+        nodes.num_ = 1;
+        nodes.mask_.at(0) = 1;
+    }
+    return nodes;
+}
+
+/**
+ * @return The NUMA nodes of the machine which are online.
+ */
+[[maybe_unused]] static const numa_nodes& online_numa_nodes() {
+    static const numa_nodes nodes = [] {
+        std::string online{};
+#ifdef YAKUSHIMA_LINUX
+        std::ifstream ifs{"/sys/devices/system/node/online"};
+        std::getline(ifs, online);
+#endif
+        return parse_numa_nodes(online);
+    }();
+    return nodes;
+}
+
+/**
+ * @return The number of the NUMA nodes of the machine, which is at most
+ * YAKUSHIMA_MAX_NUMA_NODES.
+ */
+[[maybe_unused]] static std::size_t numa_node_num() {
+    return online_numa_nodes().num_;
+}
+
+/**
+ * @return The id of the kernel of the NUMA node of @a index.
+ */
+[[maybe_unused]] static std::size_t numa_node_id(const std::size_t index) {
+    return online_numa_nodes().ids_.at(index < numa_node_num() ? index : 0);
+}
+
+/**
+ * @return The index of the NUMA node of the id @a id of the kernel, or 0 if the node is
+ * not counted.
+ */
+[[maybe_unused]] static std::size_t numa_node_index(const std::size_t id) {
+    const numa_nodes& nodes = online_numa_nodes();
+    for (std::size_t i = 0; i < nodes.num_; ++i) {
+        if (nodes.ids_.at(i) == id) { return i; }
+    }
+    return 0;
+}
+
+/**
+ * @return The index of the NUMA node of the cpu on which the caller runs.
+ * @details getcpu of glibc reads it through the vDSO without entering the kernel.
+ */
+[[maybe_unused]] static std::size_t current_numa_node() {
+    unsigned int node{0};
+#ifdef YAKUSHIMA_LINUX
+    unsigned int cpu{0};
+#if defined(__GLIBC__) && __GLIBC_PREREQ(2, 29)
+    if (getcpu(&cpu, &node) != 0) { return 0; }
+#else
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) { return 0; }
+#endif
+#endif
+    return numa_node_index(node);
+}
+
+/**
+ * @brief Set the policy of the pages of [addr, addr + len) for the NUMA nodes.
+ * @param[in] node The index of the NUMA node on which the pages are placed if @a policy
+ * is LOCAL.
+ */
+[[maybe_unused]] static void bind_numa([[maybe_unused]] void* const addr,
+                                       [[maybe_unused]] const std::size_t len,
+                                       [[maybe_unused]] const numa_policy policy,
+                                       [[maybe_unused]] const std::size_t node) {
+#ifdef YAKUSHIMA_LINUX
+    numa_nodes::mask_type mask{};
+    int mode{MPOL_DEFAULT};
+    if (policy == numa_policy::LOCAL) {
+        // it falls back to the other nodes if the node is short of memory.
+        mode = MPOL_PREFERRED;
+        const std::size_t id = numa_node_id(node);
+        mask.at(id / numa_nodes::kWordBits) |= 1UL << (id % numa_nodes::kWordBits);
+    } else if (policy == numa_policy::INTERLEAVE) {
+        mode = MPOL_INTERLEAVE;
+        mask = online_numa_nodes().mask_;
+    }
+    // the kernel reads maxnode - 1 bits of the mask.
+    if (syscall(SYS_mbind, addr, len, mode,
+                mode == MPOL_DEFAULT ? nullptr : mask.data(), numa_nodes::kMaskBits + 1,
+                0) != 0) {
+        // it is only a hint, so the pages are left to the kernel.
+        LOG(WARNING) << log_location_prefix << "mbind failed: " << std::strerror(errno);
+    }
+#endif
+}
+
+} // namespace yakushima
@@ -34,6 +34,12 @@ public:
     static constexpr std::size_t cnk_bit_size = 4; // bits
     static constexpr std::size_t pkey_bit_size =
             4; // bits, permutation key size.
+    /**
+     * the number of indexes which the body can hold, regardless of the node width.
+     */
+    static constexpr std::size_t slot_capacity =
+            (sizeof(std::uint64_t) * 8 - cnk_bit_size) / pkey_bit_size;
+    static_assert(key_slice_length <= slot_capacity);
 
     permutation() : body_{} {}
 
@@ -47,7 +53,7 @@ public:
         // layout : left delete_target right cnk
         std::uint64_t left{};
         std::uint64_t cnk = per_body & cnk_mask;
-        if (rank == cnk - 1 || rank == key_slice_length - 1) {
+        if (rank == cnk - 1 || rank == slot_capacity - 1) {
             left = 0;
         } else {
             left = (per_body >> (pkey_bit_size * (rank + 2)))
@@ -57,8 +63,8 @@ public:
         if (rank == 0) {
             right = 0;
         } else {
-            right = (per_body << (pkey_bit_size * (key_slice_length - rank))) >>
-                    (pkey_bit_size * (key_slice_length - rank));
+            right = (per_body << (pkey_bit_size * (slot_capacity - rank))) >>
+                    (pkey_bit_size * (slot_capacity - rank));
         }
         std::uint64_t final = left | right;
         final &= ~cnk_mask;
@@ -76,13 +82,13 @@ public:
         std::uint64_t per_body(body_.load(std::memory_order_acquire));
         std::size_t cnk = per_body & cnk_mask;
         if (cnk == 0) { return 0; }
-        std::bitset<15> bs{};
+        std::bitset<key_slice_length> bs{};
         bs.reset();
         for (std::size_t i = 0; i < cnk; ++i) {
             per_body = per_body >> cnk_bit_size;
             bs.set(per_body & cnk_mask);
         }
-        for (std::size_t i = 0; i < 15; ++i) {
+        for (std::size_t i = 0; i < key_slice_length; ++i) {
             if (!bs.test(i)) { return i; }
         }
         LOG(ERROR) << log_location_prefix << "programming error";
@@ -111,6 +117,20 @@ public:
         return per & cnk_mask;
     }
 
+    /**
+     * @return bit mask whose i-th bit is set iff index i is live in this permutation.
+     */
+    [[nodiscard]] std::uint32_t get_live_index_mask() const {
+        std::uint64_t per = get_body();
+        std::size_t cnk = per & cnk_mask;
+        std::uint32_t mask{0};
+        for (std::size_t i = 0; i < cnk; ++i) {
+            per = per >> pkey_bit_size;
+            mask |= 1U << (per & cnk_mask);
+        }
+        return mask;
+    }
+
     void init() { body_.store(0, std::memory_order_release); }
 
     /**
@@ -138,8 +158,8 @@ public:
         if (rank == 0) {
             right = 0;
         } else {
-            right = (per_body << (pkey_bit_size * (key_slice_length - rank))) >>
-                    (pkey_bit_size * (key_slice_length - rank));
+            right = (per_body << (pkey_bit_size * (slot_capacity - rank))) >>
+                    (pkey_bit_size * (slot_capacity - rank));
         }
         std::uint64_t final = left | target | right;
         final &= ~cnk_mask;
@@ -0,0 +1,37 @@
+/**
+ * @file retry_stats.h
+ * @brief counters of the retries of tree traversals.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace yakushima {
+
+/**
+ * @brief The counters of the calling thread. They are thread local, so counting doesn't
+ * contend, and they are never reset by yakushima.
+ */
+struct retry_stats {
+    /**
+     * @brief traversals which restarted from the root of the tree.
+     */
+    std::uint64_t from_root{};
+    /**
+     * @brief traversals which restarted from the root of the current layer.
+     */
+    std::uint64_t from_layer_root{};
+    /**
+     * @brief traversals which recovered at the border level, from the split node or by
+     * moving right to its siblings.
+     */
+    std::uint64_t move_right{};
+};
+
+inline retry_stats& get_retry_stats() {
+    thread_local retry_stats stats{};
+    return stats;
+}
+
+} // namespace yakushima
@@ -25,16 +25,26 @@ scan_border(border_node** target, std::string_view l_key, scan_endpoint l_end,
             const std::string& key_prefix, std::size_t max_size, bool);
 
 inline status scan_check_retry(border_node* const bn,
-                               node_version64_body& v_at_fb) {
+                               node_version64_body& v_at_fb,
+                               const bool right_to_left) {
     node_version64_body check = bn->get_stable_version();
     if (check != v_at_fb) {
         // fail optimistic verify
-        if (check.get_vsplit() != v_at_fb.get_vsplit() || check.get_deleted()) {
+        if (check.get_deleted() ||
+            (check.get_vsplit() != v_at_fb.get_vsplit() && right_to_left)) {
             /**
-             * The node at find border was changed by split or deleted.
+             * The node at find border was deleted, or it was split and the keys
+             * at the right end moved to the new sibling.
              */
             return status::OK_RETRY_FROM_ROOT;
         }
+        if (check.get_vsplit() != v_at_fb.get_vsplit()) {
+            /**
+             * The node was split. The keys which moved are in the new right sibling,
+             * which the scan reaches through next_ after reading this node again.
+             */
+            ++get_retry_stats().move_right;
+        }
         /**
          * The structure of the border node was not changed.
          * So reading border node can retry from that.
@@ -99,13 +109,8 @@ retry:
     constexpr std::size_t tuple_node_index = 0;
     constexpr std::size_t tuple_v_index = 1;
     status check_status{};
-    key_slice_type ks{0};
+    key_slice_type ks = make_key_slice(l_key);
     key_length_type kl = l_key.size(); // NOLINT
-    if (l_key.size() > sizeof(key_slice_type)) {
-        memcpy(&ks, l_key.data(), sizeof(key_slice_type));
-    } else {
-        if (!l_key.empty()) { memcpy(&ks, l_key.data(), l_key.size()); }
-    }
     if (right_to_left) {
         // assuming r_end == scan_endpoint::INF
         // put maximum value of key_slice
@@ -158,6 +163,7 @@ retry:
         } else if (check_status == status::OK_RETRY_FROM_ROOT) {
             clean_up_tuple_list_nvc(initial_size_of_tuple_list,
                                     initial_size_of_node_version_vec);
+            ++get_retry_stats().from_layer_root;
             goto retry; // NOLINT
         }
     }
@@ -239,9 +245,7 @@ retry:
         std::string full_key{key_prefix};
         if (kl > 0) {
             // gen full key from log and this key slice
-            full_key.append(
-                    reinterpret_cast<char*>(&ks), // NOLINT
-                    kl < sizeof(key_slice_type) ? kl : sizeof(key_slice_type));
+            append_key_slice(full_key, ks, kl);
             /**
              * If the key is complete (kl < sizeof(key_slice_type)), the key
              * slice must be copied by the size of key length.
@@ -251,12 +255,19 @@ retry:
         link_or_value* lv = bn->get_lv_at(index);
         value* vp = lv->get_value();
         base_node* next_layer = lv->get_next_layer();
+        bool has_suffix{false};
+        if (kl > sizeof(key_slice_type) && next_layer == nullptr) {
+            // the value has a key suffix, which completes the key.
+            key_suffix* suffix = lv->get_key_suffix();
+            if (suffix != nullptr) { full_key.append(suffix->get_view()); }
+            has_suffix = true;
+        }
         node_version64* node_version_ptr = bn->get_version_ptr();
         /**
          * This verification may seem verbose, but it can also be considered
          * an early abort.
          */
-        status check_status = scan_check_retry(bn, v_at_fb);
+        status check_status = scan_check_retry(bn, v_at_fb, right_to_left);
         if (check_status != status::OK) {
             // failed. clean up tuple list and node vesion vec.
             clean_up_tuple_list_nvc();
@@ -267,24 +278,24 @@ retry:
         if (check_status == status::OK_RETRY_AFTER_FB) {
             goto retry; // NOLINT
         }
-        if (kl > sizeof(key_slice_type)) {
+        if (has_suffix && (vp == nullptr || full_key.size() == key_prefix.size() +
+                                                   sizeof(key_slice_type))) {
+            // it was removed concurrently.
+            continue;
+        }
+        if (kl > sizeof(key_slice_type) && !has_suffix) {
             std::string_view arg_l_key;
             scan_endpoint arg_l_end{};
             if (l_end == scan_endpoint::INF) {
                 arg_l_key = "";
                 arg_l_end = scan_endpoint::INF;
             } else {
-                key_slice_type l_key_slice{0};
-                memcpy(&l_key_slice, l_key.data(),
-                       l_key.size() < sizeof(key_slice_type)
-                               ? l_key.size()
-                               : sizeof(key_slice_type));
+                key_slice_type l_key_slice = make_key_slice(l_key);
                 // check left point
-                int ret_cmp = memcmp(&l_key_slice, &ks, sizeof(key_slice_type));
-                if (ret_cmp < 0) {
+                if (l_key_slice < ks) {
                     arg_l_key = "";
                     arg_l_end = scan_endpoint::INF;
-                } else if (ret_cmp == 0) {
+                } else if (l_key_slice == ks) {
                     arg_l_key = l_key;
                     if (arg_l_key.size() > sizeof(key_slice_type)) {
                         arg_l_key.remove_prefix(sizeof(key_slice_type));
@@ -366,19 +377,24 @@ retry:
             }
             // not all range
             if (l_end != scan_endpoint::INF) {
-                key_slice_type l_key_slice{0};
-                if (!l_key.empty()) {
-                    memcpy(&l_key_slice, l_key.data(),
-                           l_key.size() < sizeof(key_slice_type)
-                                   ? l_key.size()
-                                   : sizeof(key_slice_type));
-                }
-                int l_cmp = memcmp(&l_key_slice, &ks, sizeof(key_slice_type));
-                if (l_cmp > 0 ||
-                    (l_cmp == 0 && (l_key.size() > kl ||
-                                    (l_key.size() == kl &&
-                                     l_end == scan_endpoint::EXCLUSIVE)))) {
-                    continue;
+                if (has_suffix) {
+                    // compare the rest of the key in this layer with the left end.
+                    int l_cmp = std::string_view{full_key}
+                                        .substr(key_prefix.size())
+                                        .compare(l_key);
+                    if (l_cmp < 0 ||
+                        (l_cmp == 0 && l_end == scan_endpoint::EXCLUSIVE)) {
+                        continue;
+                    }
+                } else {
+                    key_slice_type l_key_slice = make_key_slice(l_key);
+                    if (l_key_slice > ks ||
+                        (l_key_slice == ks &&
+                         (l_key.size() > kl ||
+                          (l_key.size() == kl &&
+                           l_end == scan_endpoint::EXCLUSIVE)))) {
+                        continue;
+                    }
                 }
             }
             // pass left endpoint.
@@ -428,7 +444,7 @@ retry:
     if (next != nullptr) { next_version = next->get_stable_version(); }
 
     // final check for atomicity
-    status check_status = scan_check_retry(bn, v_at_fb);
+    status check_status = scan_check_retry(bn, v_at_fb, right_to_left);
     if (check_status != status::OK) {
         // failed. clean up tuple list and node vesion vec.
         clean_up_tuple_list_nvc();
@@ -4,12 +4,16 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <string>
 #include <string_view>
 #include <tuple>
 #include <vector>
 
+#include "config.h"
 #include "log.h"
 
 #include "glog/logging.h"
@@ -22,12 +26,57 @@ namespace yakushima {
 using Token = void*;
 
 using key_slice_type = std::uint64_t;
-static constexpr std::size_t key_slice_length = 15;
+/**
+ * @brief the number of keys in a border node.
+ * @details The permutation packs the number of keys and the index of each rank into a
+ * 64-bit word by 4 bits so that it is published atomically, so it is at most 15.
+ */
+static constexpr std::size_t key_slice_length = YAKUSHIMA_BORDER_WIDTH;
+static_assert(3 <= key_slice_length && key_slice_length <= 15);
+/**
+ * @brief the number of keys in an interior node.
+ * @details Interior nodes keep their keys sorted under the lock and have no
+ * permutation, so they can be wider than border nodes.
+ */
+static constexpr std::size_t interior_key_slice_length = YAKUSHIMA_INTERIOR_WIDTH;
+static_assert(3 <= interior_key_slice_length && interior_key_slice_length <= 63);
 /**
  * key_length_type is used at permutation.h, border_node.h.
  * To avoid circular reference at there, declare here.
  */
 using key_length_type = std::uint8_t;
+
+/**
+ * @brief It converts the head (at most 8 bytes) of @a key into a key slice.
+ * @details Key slices are kept in big-endian order, so comparing two slices as unsigned
+ * integers gives the dictionary order of their bytes. Missing bytes of a short key are
+ * filled with 0. Keys are converted once per layer and nodes never look at the bytes.
+ */
+[[nodiscard]] inline key_slice_type make_key_slice(std::string_view key) {
+    key_slice_type key_slice{0};
+    if (!key.empty()) {
+        memcpy(&key_slice, key.data(),
+               std::min(key.size(), sizeof(key_slice_type)));
+    }
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    return __builtin_bswap64(key_slice);
+#else
+    return key_slice;
+#endif
+}
+
+/**
+ * @brief It appends the first @a length bytes (at most 8) of @a key_slice to @a out.
+ * @details This is the inverse of make_key_slice.
+ */
+inline void append_key_slice(std::string& out, key_slice_type key_slice,
+                             std::size_t length) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    key_slice = __builtin_bswap64(key_slice);
+#endif
+    out.append(reinterpret_cast<const char*>(&key_slice), // NOLINT
+               std::min(length, sizeof(key_slice_type)));
+}
 using value_length_type = std::size_t;
 using value_align_type = std::align_val_t;
 
@@ -72,6 +121,11 @@ enum class status : std::int32_t {
      * todo (optional): This constraint is removed.
      */
     WARN_UNIQUE_RESTRICTION,
+    /**
+     * @brief Warning
+     * @details (compare_exchange) The value is not the expected one.
+     */
+    WARN_VALUE_MISMATCH,
     /**
      * @brief success status
      */
@@ -142,6 +196,8 @@ inline constexpr std::string_view to_string_view(const status value) noexcept {
             return "WARN_STORAGE_NOT_EXIST"sv;
         case status::WARN_UNIQUE_RESTRICTION:
             return "WARN_UNIQUE_RESTRICTION"sv;
+        case status::WARN_VALUE_MISMATCH:
+            return "WARN_VALUE_MISMATCH"sv;
         case status::OK:
             return "OK"sv;
         case status::OK_DESTROY_ALL:
@@ -221,6 +277,30 @@ inline std::ostream& operator<<(std::ostream& out, const scan_endpoint value) {
     return out << to_string_view(value);
 }
 
+/**
+ * @brief The kind of a mutation in a batch.
+ */
+enum class batch_op : char {
+    PUT,
+    REMOVE,
+};
+
+inline constexpr std::string_view to_string_view(const batch_op value) noexcept {
+    using namespace std::string_view_literals;
+    switch (value) {
+        case batch_op::PUT:
+            return "PUT"sv;
+        case batch_op::REMOVE:
+            return "REMOVE"sv;
+    }
+    LOG(ERROR) << log_location_prefix;
+    return ""sv;
+}
+
+inline std::ostream& operator<<(std::ostream& out, const batch_op value) {
+    return out << to_string_view(value);
+}
+
 template<class ValueType>
 constexpr bool is_inlinable() {
     // pointer type or uintptr_t, it is inlinable
@@ -240,4 +320,21 @@ struct inserted_node_info {
     node_version64* created_nvp;
 };
 
+/**
+ * @brief A mutation in a batch. See apply_batch.
+ */
+template<class ValueType>
+struct batch_entry {
+    batch_op op{batch_op::PUT};
+    std::string_view key{};
+    /**
+     * @brief The value of batch_op::PUT, which is same to the value of put.
+     * batch_op::REMOVE ignores this.
+     */
+    ValueType* value_ptr{};
+    value_length_type value_length{sizeof(ValueType)};
+    value_align_type value_align{
+            static_cast<value_align_type>(alignof(ValueType))};
+};
+
 } // namespace yakushima
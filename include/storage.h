@@ -13,6 +13,8 @@
 
 namespace yakushima {
 
+class storage_handle;
+
 class storage {
 public:
     static inline status
@@ -24,6 +26,15 @@ public:
     static inline status find_storage(std::string_view storage_name,
                                       tree_instance** found_storage); // NOLINT
 
+    static inline status find_storage(std::string_view storage_name,
+                                      storage_handle& found_storage); // NOLINT
+
+    /**
+     * @brief Reclaim the tree instance whose last reference was released.
+     * @pre The storage was deleted, so the storage table doesn't hold it.
+     */
+    static inline void release_tree_instance(tree_instance* ti); // NOLINT
+
     static inline tree_instance* get_storages() { return &storages_; }
 
     static inline status list_storages(
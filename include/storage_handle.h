@@ -0,0 +1,80 @@
+/**
+ * @file storage_handle.h
+ */
+
+#pragma once
+
+#include <utility>
+
+#include "storage.h"
+#include "tree_instance.h"
+
+namespace yakushima {
+
+/**
+ * @brief A reference to a storage which is obtained once by find_storage.
+ * @details The operations with a storage handle skip the search of the storage table
+ * by the storage name. The handle keeps the tree_instance of the storage even after the
+ * storage is deleted, so it never dangles, and the operations with it return
+ * status::WARN_STORAGE_NOT_EXIST after the deletion. It is copyable, and each copy holds
+ * its own reference.
+ * @attention Release all handles before fin().
+ */
+class storage_handle {
+public:
+    storage_handle() = default;
+
+    /**
+     * @pre @a ti is found in the storage table and the caller is in a session, so that
+     * @a ti is not reclaimed during this.
+     */
+    explicit storage_handle(tree_instance* const ti) : ti_(ti) {
+        if (ti_ != nullptr) { ti_->acquire_ref(); }
+    }
+
+    storage_handle(const storage_handle& other) : ti_(other.ti_) {
+        if (ti_ != nullptr) { ti_->acquire_ref(); }
+    }
+
+    storage_handle(storage_handle&& other) noexcept
+        : ti_(std::exchange(other.ti_, nullptr)) {}
+
+    storage_handle& operator=(const storage_handle& other) {
+        if (this != &other) { storage_handle(other).swap(*this); }
+        return *this;
+    }
+
+    storage_handle& operator=(storage_handle&& other) noexcept {
+        if (this != &other) { storage_handle(std::move(other)).swap(*this); }
+        return *this;
+    }
+
+    ~storage_handle() { reset(); }
+
+    /**
+     * @brief Release the reference of this handle.
+     */
+    void reset() {
+        if (ti_ != nullptr && ti_->release_ref()) {
+            storage::release_tree_instance(ti_);
+        }
+        ti_ = nullptr;
+    }
+
+    void swap(storage_handle& other) noexcept { std::swap(ti_, other.ti_); }
+
+    /**
+     * @return The tree instance of the storage if it is not deleted, otherwise nullptr.
+     */
+    [[nodiscard]] tree_instance* get() const {
+        if (ti_ == nullptr || ti_->is_dropped()) { return nullptr; }
+        return ti_;
+    }
+
+    explicit operator bool() const { return get() != nullptr; }
+
+private:
+    tree_instance* ti_{nullptr};
+};
+
+} // namespace yakushima
@@ -11,6 +11,7 @@
 #include "interface_remove.h"
 #include "log.h"
 #include "storage.h"
+#include "storage_handle.h"
 #include "tree_instance.h"
 
 #include "glog/logging.h"
@@ -21,14 +22,19 @@ namespace yakushima {
 [[maybe_unused]] static status enter(Token& token);                   // NOLINT
 [[maybe_unused]] static status leave(Token token);                    // NOLINT
 [[maybe_unused]] static status remove(Token token, tree_instance* ti, // NOLINT
-                                      std::string_view key_view);
+                                      std::string_view key_view,
+                                      cursor_hint* hint);
 
 status storage::create_storage(std::string_view storage_name) { // NOLINT
     // prepare create storage
-    tree_instance new_instance;
+    /**
+     * The storage table holds the pointer, so that the address of the tree instance
+     * is stable for storage handles.
+     */
+    auto* new_instance = new tree_instance(); // NOLINT
     border_node* new_border = new border_node(); // NOLINT
     new_border->init_border();
-    new_instance.store_root_ptr(new_border);
+    new_instance->store_root_ptr(new_border);
     Token token{};
     while (status::OK != enter(token)) { _mm_pause(); }
 
@@ -42,7 +48,8 @@ status storage::create_storage(std::string_view storage_name) { // NOLINT
         LOG(ERROR) << log_location_prefix << ret_st_token;
     }
     if (ret_st != status::OK) {
-        delete new_border; // NOLINT
+        delete new_border;   // NOLINT
+        delete new_instance; // NOLINT
     }
 
     return ret_st;
@@ -52,8 +59,8 @@ status storage::delete_storage(std::string_view storage_name) { // NOLINT
     Token token{};
     while (status::OK != enter(token)) { _mm_pause(); }
     // search storage
-    std::pair<tree_instance*, std::size_t> ret{};
-    auto rc = get<tree_instance>(get_storages(), storage_name, ret);
+    tree_instance* ti{};
+    auto rc = find_storage(storage_name, &ti);
     if (rc == status::WARN_NOT_EXIST) {
         leave(token);
         return status::WARN_NOT_EXIST;
@@ -61,11 +68,13 @@ status storage::delete_storage(std::string_view storage_name) { // NOLINT
     // try remove the storage.
     status ret_st{remove(token, get_storages(), storage_name)};
     if (ret_st == status::OK) {
-        base_node* tables_root = ret.first->load_root_ptr();
-        if (tables_root != nullptr) {
-            tables_root->destroy();
-            delete tables_root; // NOLINT
-            ret.first->store_root_ptr(nullptr);
+        if (ti->set_dropped()) {
+            /**
+             * Concurrent operations which found the storage before may still work on
+             * the tree, so the gc thread destroys it after their sessions leave.
+             */
+            auto* thin = reinterpret_cast<thread_info*>(token); // NOLINT
+            thin->get_gc_info().push_tree_container({thin->get_begin_epoch(), ti});
         }
         leave(token);
         return status::OK;
@@ -76,24 +85,49 @@ status storage::delete_storage(std::string_view storage_name) { // NOLINT
 
 status storage::find_storage(std::string_view storage_name,
                              tree_instance** found_storage) { // NOLINT
-    std::pair<tree_instance*, std::size_t> ret{};
-    auto rc = get<tree_instance>(get_storages(), storage_name, ret);
+    std::pair<tree_instance**, std::size_t> ret{};
+    auto rc = get<tree_instance*>(get_storages(), storage_name, ret);
     if (rc == status::WARN_NOT_EXIST) { return status::WARN_NOT_EXIST; }
-    if (found_storage != nullptr) *found_storage = ret.first;
+    // the pointer is an inline value, so the returned address is the pointer itself.
+    if (found_storage != nullptr) {
+        *found_storage = reinterpret_cast<tree_instance*>(ret.first); // NOLINT
+    }
     return status::OK;
 }
 
+status storage::find_storage(std::string_view storage_name,
+                             storage_handle& found_storage) { // NOLINT
+    Token token{};
+    while (status::OK != enter(token)) { _mm_pause(); }
+    // the session prevents the reclamation until the handle refers the tree instance.
+    tree_instance* ti{};
+    auto rc = find_storage(storage_name, &ti);
+    if (rc == status::OK) { found_storage = storage_handle{ti}; }
+    leave(token);
+    return rc;
+}
+
+void storage::release_tree_instance(tree_instance* ti) { // NOLINT
+    /**
+     * The gc thread released the reference of the storage table after the sessions
+     * which found this left, so no one else refers this.
+     */
+    delete ti; // NOLINT
+}
+
 status storage::list_storages(
         std::vector<std::pair<std::string, tree_instance*>>& out) { // NOLINT
     out.clear();
-    std::vector<std::tuple<std::string, tree_instance*, std::size_t>>
+    std::vector<std::tuple<std::string, tree_instance**, std::size_t>>
             tuple_list;
     scan(get_storages(), "", scan_endpoint::INF, "", scan_endpoint::INF,
          tuple_list, nullptr, 0);
     if (tuple_list.empty()) { return status::WARN_NOT_EXIST; }
     out.reserve(tuple_list.size());
     for (auto&& elem : tuple_list) {
-        out.emplace_back(std::get<0>(elem), std::get<1>(elem));
+        out.emplace_back(std::get<0>(elem),
+                         reinterpret_cast<tree_instance*>( // NOLINT
+                                 std::get<1>(elem)));
     }
     return status::OK;
 }
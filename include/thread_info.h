@@ -5,11 +5,13 @@
 #pragma once
 
 #include <atomic>
+#include <cstddef>
 
 #include "clock.h"
 #include "cpu.h"
 #include "epoch.h"
 #include "garbage_collection.h"
+#include "numa.h"
 
 namespace yakushima {
 
@@ -38,6 +40,8 @@ public:
 
     [[nodiscard]] garbage_collection& get_gc_info() { return gc_info_; }
 
+    [[nodiscard]] std::size_t get_numa_node() const { return numa_node_; }
+
     [[nodiscard]] bool get_running() const {
         return running_.load(std::memory_order_acquire);
     }
@@ -46,8 +50,20 @@ public:
         begin_epoch_.store(epoch, std::memory_order_relaxed);
     }
 
+    /**
+     * @details The store releases the value pool to the session which gains the right
+     * next, so the lists of the pool are handed over with it.
+     */
     void set_running(const bool tf) {
-        running_.store(tf, std::memory_order_relaxed);
+        running_.store(tf, std::memory_order_release);
+    }
+
+    /**
+     * @pre The session of this calls this.
+     */
+    void set_numa_node(const std::size_t node) {
+        numa_node_ = node;
+        gc_info_.get_value_pool().set_numa_node(node);
     }
 
 private:
@@ -57,6 +73,10 @@ private:
      */
     std::atomic<Epoch> begin_epoch_{0};
     std::atomic<bool> running_{false};
+    /**
+     * @brief The NUMA node on which the session entered.
+     */
+    std::size_t numa_node_{0};
     garbage_collection gc_info_;
 };
 
@@ -25,6 +25,7 @@ public:
         for (auto&& elem : thread_info_table_) {
             if (elem.gain_the_right()) {
                 elem.set_begin_epoch(epoch_management::get_epoch());
+                elem.set_numa_node(huge_page_arena::local_node());
                 token = &(elem);
                 return status::OK;
             }
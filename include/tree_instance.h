@@ -54,10 +54,45 @@ public:
         root_lock_.store(false, std::memory_order_release);
     }
 
+    /**
+     * @brief It is called by the owner of a new reference, i.e. a storage handle.
+     */
+    void acquire_ref() { refs_.fetch_add(1, std::memory_order_acq_rel); }
+
+    /**
+     * @retval true if the caller released the last reference, so it must reclaim this.
+     * @retval false otherwise.
+     */
+    bool release_ref() {
+        return refs_.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
+    /**
+     * @return Whether this storage was deleted. Operations through a storage handle
+     * check this, since the handle keeps this object after the deletion.
+     */
+    bool is_dropped() { return dropped_.load(std::memory_order_acquire); }
+
+    /**
+     * @retval true if the caller dropped this.
+     * @retval false if this was already dropped.
+     */
+    bool set_dropped() {
+        return !dropped_.exchange(true, std::memory_order_acq_rel);
+    }
+
 private:
     base_node* root_{nullptr};
 
     std::atomic_bool root_lock_{false};
+
+    std::atomic_bool dropped_{false};
+
+    /**
+     * @brief The number of references. The entry of the storage table holds one until
+     * the storage is deleted, and each storage handle holds one.
+     */
+    std::atomic<std::size_t> refs_{1};
 };
 
 } // namespace yakushima
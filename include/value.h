@@ -3,52 +3,82 @@
  */
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstring>
+
 #include "atomic_wrapper.h"
 #include "scheme.h"
+#include "value_pool.h"
 
 namespace yakushima {
 
 class value {
 public:
+    /**
+     * @brief The size of the area of a slot which keeps a value whose body is at most
+     * YAKUSHIMA_INLINE_VALUE_SIZE bytes: the header and the body.
+     */
+    static constexpr std::size_t kInNodeAreaSize =
+            8 + (YAKUSHIMA_INLINE_VALUE_SIZE + 7) / 8 * 8;
+
+    /**
+     * @return Whether the value of @a v_len and @a v_align is kept in the slot of the
+     * border node instead of the heap.
+     */
+    static constexpr bool fits_in_node(const std::size_t v_len,
+                                       const value_align_type v_align) {
+        return YAKUSHIMA_INLINE_VALUE_SIZE > 0 &&
+               v_len <= YAKUSHIMA_INLINE_VALUE_SIZE &&
+               v_align <= static_cast<value_align_type>(8);
+    }
+
     /**
      * @brief Create a new value instance with dynamic memory allocation.
      *
      * @param[in] in_ptr The source address of a new value.
      * @param[in] v_len The length of a new value.
      * @param[in] v_align The alignment size of a new value.
-     * @return The pointer to the new value.
+     * @param[in] pool The pool of the session which allocates the memory. If this is
+     * nullptr, it is allocated from the heap.
+     * @return The pointer to the new value. If the value fits in the node, it is made in
+     * the staging area of the thread, and link_or_value::set_value copies it to the slot,
+     * so the thread must set it before it creates another value. If the area of the slot
+     * may still be read, set_value makes a copy on the heap instead.
      */
     template<bool kIsInlineValue>
     [[nodiscard]] static value* create_value(const void* in_ptr,
                                              value_length_type v_len,
-                                             value_align_type v_align) {
+                                             value_align_type v_align,
+                                             value_pool* pool = nullptr) {
         value* v{};
         if constexpr (kIsInlineValue) {
             // inline value
             memcpy(&v, in_ptr, sizeof(uintptr_t)); // NOLINT
-        } else {
-            // compute the size/alignment to be reserved
-            constexpr auto kMinAlignment = static_cast<value_align_type>(8);
-            if (v_align < kMinAlignment) { v_align = kMinAlignment; } // NOLINT(*-min-max)
-            const auto total_len =
-                    v_len + static_cast<value_length_type>(v_align);
-
-            // allocate memory and copy the given value
-            // NOTE: it use copy assign, so ValueType must be copy-assignable.
-            try {
-                auto* page = ::operator new(total_len, v_align);
-                v = new (page) value{v_len, v_align}; // NOLINT
-            } catch (std::bad_alloc& e) {
-                LOG(ERROR) << log_location_prefix << e.what();
-            }
+        } else if (fits_in_node(v_len, v_align)) {
+            alignas(8) static thread_local std::array<std::byte, kInNodeAreaSize>
+                    staging{};
+            v = new (staging.data()) value{v_len, static_cast<value_align_type>(8)}; // NOLINT
+            v->need_delete_ = false;
+            v->in_node_ = true;
             auto ptr = reinterpret_cast<uintptr_t>(v) | kValPtrFlag; // NOLINT
             v = reinterpret_cast<value*>(ptr);                       // NOLINT
-
             memcpy(value::get_body(v), in_ptr, v_len);
+        } else {
+            v = create_on_heap(in_ptr, v_len, v_align, pool);
         }
         return v;
     }
 
+    /**
+     * @pre is_in_node(@a val)
+     * @return A copy of @a val on the heap, which the garbage collection releases.
+     */
+    [[nodiscard]] static value* copy_to_heap(value* val) {
+        return create_on_heap(get_body(val), get_len(val),
+                              static_cast<value_align_type>(8), nullptr);
+    }
+
     /**
      * @brief Release the given value pointer.
      *
@@ -59,9 +89,10 @@ public:
      */
     static void delete_value(value* val) {
         auto* v = remove_ptr_flag(val);
-        if (v != val) {
+        // a value in the slot of a border node is released with the node.
+        if (v != val && !v->in_node_) {
             const auto v_align = static_cast<value_align_type>(v->align_);
-            ::operator delete(v, v->len_ + v->align_, v_align);
+            value_pool::release_block(v, v->len_ + v->align_, v_align);
         }
     }
 
@@ -74,6 +105,18 @@ public:
         return (reinterpret_cast<uintptr_t>(val) & kValPtrFlag) > 0; // NOLINT
     }
 
+    /**
+     * @param[in] val The target value pointer.
+     * @retval true if the value is kept in the slot of a border node.
+     * @retval false otherwise.
+     */
+    static bool is_in_node(const value* val) {
+        if constexpr (YAKUSHIMA_INLINE_VALUE_SIZE == 0) { return false; }
+        auto* v = remove_ptr_flag(val);
+        if (v == val) { return false; }
+        return v->in_node_;
+    }
+
     /**
      * @param[in] val The target value pointer.
      * @retval true if the contained value should be deleted.
@@ -115,7 +158,9 @@ public:
     static std::tuple<void*, value_length_type, value_align_type>
     get_gc_info(const value* val) {
         auto* v = remove_ptr_flag(val);
-        if (v == val) { return {nullptr, 0, static_cast<value_align_type>(0)}; }
+        if (v == val || v->in_node_) {
+            return {nullptr, 0, static_cast<value_align_type>(0)};
+        }
         return {v, v->len_ + v->align_,
                 static_cast<value_align_type>(v->align_)};
     }
@@ -146,6 +191,31 @@ private:
         : len_(v_len),
           align_(static_cast<std::uint16_t>(v_align)), need_delete_{true} {}
 
+    [[nodiscard]] static value* create_on_heap(const void* in_ptr,
+                                               value_length_type v_len,
+                                               value_align_type v_align,
+                                               value_pool* pool) {
+        value* v{};
+        // compute the size/alignment to be reserved
+        constexpr auto kMinAlignment = static_cast<value_align_type>(8);
+        if (v_align < kMinAlignment) { v_align = kMinAlignment; } // NOLINT(*-min-max)
+        const auto total_len = v_len + static_cast<value_length_type>(v_align);
+
+        // allocate memory and copy the given value
+        // NOTE: it use copy assign, so ValueType must be copy-assignable.
+        try {
+            auto* page = value_pool::allocate_block(total_len, v_align, pool);
+            v = new (page) value{v_len, v_align}; // NOLINT
+        } catch (std::bad_alloc& e) {
+            LOG(ERROR) << log_location_prefix << e.what();
+        }
+        auto ptr = reinterpret_cast<uintptr_t>(v) | kValPtrFlag; // NOLINT
+        v = reinterpret_cast<value*>(ptr);                       // NOLINT
+
+        memcpy(value::get_body(v), in_ptr, v_len);
+        return v;
+    }
+
     /**
      * @param[in] val The target value pointer.
      * @return The actual pointer without a flag.
@@ -171,6 +241,12 @@ private:
      * @brief A flag for indicating this value is active.
      */
     bool need_delete_{false};
+
+    /**
+     * @brief A flag for indicating this value is kept in the slot of a border node,
+     * which releases it with the node.
+     */
+    bool in_node_{false};
 };
 
 } // namespace yakushima
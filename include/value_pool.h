@@ -0,0 +1,272 @@
+/**
+ * @file value_pool.h
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "config.h"
+#include "huge_page_arena.h"
+#include "scheme.h"
+
+namespace yakushima {
+
+/**
+ * @brief The free lists of the memory blocks of values and key suffixes, which a session
+ * owns.
+ * @details A block of at most YAKUSHIMA_VALUE_POOL_MAX_SIZE bytes whose alignment is at
+ * most kAlign is rounded up to its size class and aligned to kAlign, so the blocks of a
+ * class are interchangeable wherever they were allocated. The session allocates blocks
+ * from its lists, and the garbage collection returns the blocks which the session retired
+ * to the lists after their epoch expires, instead of releasing them to the heap. Only the
+ * owner takes blocks, and it takes all the returned blocks of a class at once, so the
+ * lists are free from ABA. When the lists of a class are empty, the session splits a slab
+ * of YAKUSHIMA_VALUE_POOL_SLAB_SIZE bytes into the blocks of the class, so a new block
+ * costs no call to the heap and the blocks of a session are close in memory. The blocks
+ * are never released to the heap; the released blocks go to the shared lists, from which
+ * the sessions take them, and the slabs are kept until the process exits, as the chunks
+ * of node_pool are. While the huge page arena is enabled, the slabs are carved from the
+ * part of the arena for the NUMA node of the session, and the shared lists are kept for
+ * each NUMA node, so the released blocks are reused on the node where they are placed.
+ */
+class value_pool {
+public:
+    static constexpr auto kAlign =
+            static_cast<value_align_type>(alignof(std::max_align_t));
+
+    /**
+     * @brief The difference between the sizes of the neighboring classes.
+     */
+    static constexpr std::size_t kGranularity = 16;
+
+    static constexpr std::size_t kClassNum =
+            YAKUSHIMA_VALUE_POOL_MAX_SIZE / kGranularity;
+
+    // a slab has a block of each class at least.
+    static_assert(YAKUSHIMA_VALUE_POOL_SLAB_SIZE >= kClassNum * kGranularity);
+
+    /**
+     * @return Whether the block of @a size and @a align is rounded up to a size class.
+     */
+    static constexpr bool is_pooled(const std::size_t size,
+                                    const value_align_type align) {
+        return size <= kClassNum * kGranularity && align <= kAlign;
+    }
+
+    /**
+     * @brief Allocate a block from the lists of @a pool, or from the lists shared by the
+     * callers without a session if @a pool is nullptr.
+     */
+    static void* allocate_block(const std::size_t size, const value_align_type align,
+                                value_pool* const pool) {
+        if (!is_pooled(size, align)) { return ::operator new(size, align); }
+        if (pool != nullptr) { return pool->allocate(class_of(size)); }
+        static std::mutex mtx{};
+        static value_pool shared{};
+        std::lock_guard<std::mutex> lk{mtx};
+        return shared.allocate(class_of(size));
+    }
+
+    /**
+     * @brief Release a block to the shared lists, or to the heap if it is not pooled.
+     */
+    static void release_block(void* const block, const std::size_t size,
+                              const value_align_type align) {
+        if (!is_pooled(size, align)) {
+            ::operator delete(block, size, align);
+            return;
+        }
+        delete_block(block, class_of(size));
+    }
+
+    /**
+     * @brief Return a block to the lists. Any thread may call this.
+     * @details A class keeps at most YAKUSHIMA_VALUE_POOL_CAPACITY returned blocks, and
+     * the others are released to the shared lists.
+     */
+    void recycle(void* const block, const std::size_t size,
+                 const value_align_type align) {
+        if (!is_pooled(size, align)) {
+            ::operator delete(block, size, align);
+            return;
+        }
+        const std::size_t cls = class_of(size);
+        if (returned_num_[cls].load(std::memory_order_relaxed) >=
+            YAKUSHIMA_VALUE_POOL_CAPACITY) {
+            release_block(block, size, align);
+            return;
+        }
+        returned_num_[cls].fetch_add(1, std::memory_order_relaxed);
+        auto* fb = static_cast<free_block*>(block);
+        fb->next_ = returned_[cls].load(std::memory_order_relaxed);
+        while (!returned_[cls].compare_exchange_weak(fb->next_, fb,
+                                                     std::memory_order_release,
+                                                     std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * @brief Set the NUMA node from which this allocates the blocks of the huge page
+     * arena.
+     * @pre Only the owner calls this.
+     */
+    void set_numa_node(const std::size_t node) { numa_node_ = node; }
+
+    /**
+     * @brief Release all the blocks of the lists to the shared lists, which the next init
+     * reuses.
+     * @pre No session uses this.
+     */
+    void fin() {
+        for (std::size_t cls = 0; cls < kClassNum; ++cls) {
+            release_list(local_[cls], cls);
+            local_[cls] = nullptr;
+            release_list(slab_[cls], cls);
+            slab_[cls] = nullptr;
+            release_list(returned_[cls].exchange(nullptr, std::memory_order_acquire),
+                         cls);
+            returned_num_[cls].store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    struct free_block {
+        free_block* next_;
+    };
+
+    static constexpr std::size_t class_of(const std::size_t size) {
+        return size == 0 ? 0 : (size - 1) / kGranularity;
+    }
+
+    static constexpr std::size_t class_size(const std::size_t cls) {
+        return (cls + 1) * kGranularity;
+    }
+
+    static void release_list(free_block* fb, const std::size_t cls) {
+        while (fb != nullptr) {
+            free_block* next = fb->next_;
+            delete_block(fb, cls);
+            fb = next;
+        }
+    }
+
+    /**
+     * @brief The slabs of the heap, which are released when the process exits.
+     */
+    struct slab_list {
+        slab_list() = default;
+        slab_list(const slab_list&) = delete;
+        slab_list& operator=(const slab_list&) = delete;
+        ~slab_list() {
+            for (auto* slab : slabs_) {
+                ::operator delete(slab, YAKUSHIMA_VALUE_POOL_SLAB_SIZE, kAlign);
+            }
+        }
+
+        std::mutex mtx_;
+        std::vector<void*> slabs_;
+    };
+
+    /**
+     * @return The list of the blocks of a new slab.
+     */
+    static free_block* carve_slab(const std::size_t cls, const std::size_t node) {
+        const std::size_t num = YAKUSHIMA_VALUE_POOL_SLAB_SIZE / class_size(cls);
+        auto* slab = static_cast<std::byte*>(huge_page_arena::allocate(
+                class_size(cls) * num, static_cast<std::size_t>(kAlign), node));
+        if (slab == nullptr) {
+            slab = static_cast<std::byte*>(
+                    ::operator new(YAKUSHIMA_VALUE_POOL_SLAB_SIZE, kAlign));
+            std::lock_guard<std::mutex> lk{slabs_.mtx_};
+            slabs_.slabs_.emplace_back(slab);
+        }
+        free_block* head{nullptr};
+        for (std::size_t i = num; i > 0; --i) {
+            auto* fb = reinterpret_cast<free_block*>(slab + (i - 1) * class_size(cls)); // NOLINT
+            fb->next_ = head;
+            head = fb;
+        }
+        return head;
+    }
+
+    static void delete_block(void* const block, const std::size_t cls) {
+        // the blocks of the heap and the blocks released while the arena is disabled go
+        // to the list of node 0.
+        auto& released = released_.at(huge_page_arena::list_of(block))[cls];
+        auto* fb = static_cast<free_block*>(block);
+        fb->next_ = released.load(std::memory_order_relaxed);
+        while (!released.compare_exchange_weak(fb->next_, fb,
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * @pre Only the owner calls this.
+     */
+    void* allocate(const std::size_t cls) {
+        if (local_[cls] == nullptr) {
+            local_[cls] = returned_[cls].exchange(nullptr, std::memory_order_acquire);
+            returned_num_[cls].store(0, std::memory_order_relaxed);
+            if (local_[cls] == nullptr) {
+                local_[cls] = released_.at(numa_node_)[cls].exchange(
+                        nullptr, std::memory_order_acquire);
+            }
+            if (local_[cls] == nullptr && numa_node_ != 0) {
+                local_[cls] = released_.at(0)[cls].exchange(nullptr,
+                                                            std::memory_order_acquire);
+            }
+            if (local_[cls] == nullptr) {
+                // the recycled blocks are taken before the rest of the slab.
+                if (slab_[cls] == nullptr) { slab_[cls] = carve_slab(cls, numa_node_); }
+                free_block* fb = slab_[cls];
+                slab_[cls] = fb->next_;
+                return fb;
+            }
+        }
+        free_block* fb = local_[cls];
+        local_[cls] = fb->next_;
+        return fb;
+    }
+
+    /**
+     * @brief The blocks which the owner took.
+     */
+    std::array<free_block*, kClassNum> local_{};
+
+    /**
+     * @brief The blocks of the slab which the owner split last and hasn't taken yet.
+     */
+    std::array<free_block*, kClassNum> slab_{};
+
+    /**
+     * @brief The blocks which the garbage collection returned.
+     */
+    std::array<std::atomic<free_block*>, kClassNum> returned_{};
+
+    /**
+     * @brief The approximate numbers of the blocks in returned_.
+     */
+    std::array<std::atomic<std::size_t>, kClassNum> returned_num_{};
+
+    /**
+     * @brief The NUMA node of the owner.
+     */
+    std::size_t numa_node_{0};
+
+    /**
+     * @brief The blocks which were released, for each NUMA node.
+     */
+    static inline std::array<std::array<std::atomic<free_block*>, kClassNum>, // NOLINT
+                             YAKUSHIMA_MAX_NUMA_NODES>
+            released_{};
+    static inline slab_list slabs_{}; // NOLINT
+};
+
+} // namespace yakushima
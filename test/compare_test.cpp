@@ -32,10 +32,8 @@ TEST_F(ct, memcmp) { // NOLINT
 
 TEST_F(ct, key_tuple) { // NOLINT
     // regular case
-    char d1[8] = { 0x31, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }; // NOLINT
-    char d2[8] = { 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }; // NOLINT
-    std::uint64_t ud1 = *reinterpret_cast<std::uint64_t*>(d1); // NOLINT
-    std::uint64_t ud2 = *reinterpret_cast<std::uint64_t*>(d2); // NOLINT
+    key_slice_type ud1 = make_key_slice("1");
+    key_slice_type ud2 = make_key_slice("2");
     ASSERT_LT(base_node::key_tuple(ud1, 1), base_node::key_tuple(ud2, 1));
     ASSERT_LT(base_node::key_tuple(ud1, 1), base_node::key_tuple(ud2, 2));
     ASSERT_LT(base_node::key_tuple(ud1, 2), base_node::key_tuple(ud2, 1));
@@ -49,6 +47,25 @@ TEST_F(ct, key_tuple) { // NOLINT
     ASSERT_FALSE(base_node::key_tuple{} < base_node::key_tuple{});
 }
 
+TEST_F(ct, key_slice) { // NOLINT
+    // slices are ordered as unsigned integers in the dictionary order of keys.
+    std::vector<std::string> keys{"", std::string(1, '\0'), "0", "1",
+                                  "10", "12345678", "2", "\xff"};
+    for (std::size_t i = 0; i + 1 < keys.size(); ++i) {
+        ASSERT_LT(base_node::key_tuple(keys.at(i)),
+                  base_node::key_tuple(keys.at(i + 1)));
+        ASSERT_LE(make_key_slice(keys.at(i)), make_key_slice(keys.at(i + 1)));
+    }
+    ASSERT_EQ(make_key_slice("12345678"), make_key_slice("123456789"));
+    ASSERT_EQ(make_key_slice("a"), 0x6100000000000000UL);
+    // and decoded back into the bytes.
+    for (auto&& k : keys) {
+        std::string out{};
+        append_key_slice(out, make_key_slice(k), k.size());
+        ASSERT_EQ(out, k);
+    }
+}
+
 TEST_F(ct, compareData) {  // NOLINT
     std::string s1("aac"); // NOLINT
     std::string s2("b");   // NOLINT
@@ -64,11 +81,13 @@ TEST_F(ct, compareData) {  // NOLINT
                       std::string_view(reinterpret_cast<char*>(&k2), // NOLINT
                                        sizeof(std::uint64_t)));
 
+    // key slices in nodes are big-endian, so they are ordered as integers.
+    ASSERT_EQ(s1 < s2, make_key_slice(s1) < make_key_slice(s2));
     base_node::key_tuple kt1{};
-    kt1.set_key_slice(k1);
+    kt1.set_key_slice(make_key_slice(s1));
     kt1.set_key_length(s1.size());
     base_node::key_tuple kt2{};
-    kt2.set_key_slice(k2);
+    kt2.set_key_slice(make_key_slice(s2));
     kt2.set_key_length(s2.size());
     ASSERT_EQ(kt1 < kt2, true);
     std::vector<base_node::key_tuple> vec; // NOLINT
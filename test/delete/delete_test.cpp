@@ -6,6 +6,8 @@
 #include <array>
 #include <future>
 #include <random>
+#include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -48,7 +50,7 @@ TEST_F(dt, one_border) { // NOLINT
     }
     for (std::size_t i = 0; i < ary_size; ++i) {
         ASSERT_EQ(status::OK, remove(token, test_storage_name, k.at(i)));
-        auto* br = dynamic_cast<border_node*>(ti->load_root_ptr());
+        auto* br = static_cast<border_node*>(ti->load_root_ptr());
         if (i != ary_size - 1) {
             ASSERT_EQ(br->get_permutation_cnk(), ary_size - i - 1);
         }
@@ -84,7 +86,7 @@ TEST_F(dt, one_border_shuffle) { // NOLINT
         for (std::size_t i = 0; i < ary_size; ++i) {
             ASSERT_EQ(status::OK,
                       remove(token, test_storage_name, std::get<0>(kv.at(i))));
-            auto* br = dynamic_cast<border_node*>(ti->load_root_ptr());
+            auto* br = static_cast<border_node*>(ti->load_root_ptr());
             if (i != ary_size - 1) {
                 ASSERT_EQ(br->get_permutation_cnk(), ary_size - i - 1);
             }
@@ -112,7 +114,7 @@ TEST_F(dt, two_border) { // NOLINT
     }
     for (std::size_t i = 0; i < ary_size; ++i) {
         ASSERT_EQ(status::OK, remove(token, test_storage_name, k.at(i)));
-        auto* bn = dynamic_cast<border_node*>(ti->load_root_ptr());
+        auto* bn = static_cast<border_node*>(ti->load_root_ptr());
         /**
          * here, tree has two layer constituted by two border node.
          */
@@ -255,20 +257,20 @@ TEST_F(dt, two_interi) { // NOLINT
              * root is full-border.
              */
             auto* n = ti->load_root_ptr();
-            ASSERT_EQ(typeid(*n), typeid(border_node)); // NOLINT
+            ASSERT_TRUE(n->get_version_border());
         } else if (i == key_slice_length) {
             /**
              * split and insert.
              */
             auto* n = ti->load_root_ptr();
-            ASSERT_EQ(typeid(*n), typeid(interior_node)); // NOLINT
-            ASSERT_EQ(dynamic_cast<border_node*>(
-                              dynamic_cast<interior_node*>(ti->load_root_ptr())
+            ASSERT_FALSE(n->get_version_border());
+            ASSERT_EQ(static_cast<border_node*>(
+                              static_cast<interior_node*>(ti->load_root_ptr())
                                       ->get_child_at(0))
                               ->get_permutation_cnk(),
                       8);
-            ASSERT_EQ(dynamic_cast<border_node*>(
-                              dynamic_cast<interior_node*>(ti->load_root_ptr())
+            ASSERT_EQ(static_cast<border_node*>(
+                              static_cast<interior_node*>(ti->load_root_ptr())
                                       ->get_child_at(1))
                               ->get_permutation_cnk(),
                       8);
@@ -277,16 +279,16 @@ TEST_F(dt, two_interi) { // NOLINT
              * root is interior, root has 2 children, child[0] of root has 8 keys and child[1]
              * of root has 15 keys.
              */
-            ASSERT_EQ(dynamic_cast<interior_node*>(ti->load_root_ptr())
+            ASSERT_EQ(static_cast<interior_node*>(ti->load_root_ptr())
                               ->get_n_keys(),
                       1);
-            ASSERT_EQ(dynamic_cast<border_node*>(
-                              dynamic_cast<interior_node*>(ti->load_root_ptr())
+            ASSERT_EQ(static_cast<border_node*>(
+                              static_cast<interior_node*>(ti->load_root_ptr())
                                       ->get_child_at(0))
                               ->get_permutation_cnk(),
                       8);
-            ASSERT_EQ(dynamic_cast<border_node*>(
-                              dynamic_cast<interior_node*>(ti->load_root_ptr())
+            ASSERT_EQ(static_cast<border_node*>(
+                              static_cast<interior_node*>(ti->load_root_ptr())
                                       ->get_child_at(1))
                               ->get_permutation_cnk(),
                       15);
@@ -294,18 +296,18 @@ TEST_F(dt, two_interi) { // NOLINT
             /**
              * root is interior, root has 3 children, child[0-2] of root has 8 keys.
              */
-            ASSERT_EQ(dynamic_cast<border_node*>(
-                              dynamic_cast<interior_node*>(ti->load_root_ptr())
+            ASSERT_EQ(static_cast<border_node*>(
+                              static_cast<interior_node*>(ti->load_root_ptr())
                                       ->get_child_at(0))
                               ->get_permutation_cnk(),
                       8);
-            ASSERT_EQ(dynamic_cast<border_node*>(
-                              dynamic_cast<interior_node*>(ti->load_root_ptr())
+            ASSERT_EQ(static_cast<border_node*>(
+                              static_cast<interior_node*>(ti->load_root_ptr())
                                       ->get_child_at(1))
                               ->get_permutation_cnk(),
                       8);
-            ASSERT_EQ(dynamic_cast<border_node*>(
-                              dynamic_cast<interior_node*>(ti->load_root_ptr())
+            ASSERT_EQ(static_cast<border_node*>(
+                              static_cast<interior_node*>(ti->load_root_ptr())
                                       ->get_child_at(2))
                               ->get_permutation_cnk(),
                       8);
@@ -317,35 +319,35 @@ TEST_F(dt, two_interi) { // NOLINT
              * When it puts (key_slice_length / 2) keys, the root interior node has
              * (i-base_node::key_slice _length) / (key_slice_length / 2);
              */
-            ASSERT_EQ(dynamic_cast<interior_node*>(ti->load_root_ptr())
+            ASSERT_EQ(static_cast<interior_node*>(ti->load_root_ptr())
                               ->get_n_keys(),
                       (i - key_slice_length) / (key_slice_length / 2 + 1) + 1);
 
         } else if (i == key_slice_length + ((key_slice_length / 2 + 1)) *
                                                    (key_slice_length - 1)) {
-            ASSERT_EQ(dynamic_cast<interior_node*>(ti->load_root_ptr())
+            ASSERT_EQ(static_cast<interior_node*>(ti->load_root_ptr())
                               ->get_n_keys(),
                       key_slice_length);
         }
     }
 
-    auto* in = dynamic_cast<interior_node*>(ti->load_root_ptr());
+    auto* in = static_cast<interior_node*>(ti->load_root_ptr());
     /**
      * root is interior.
      */
     ASSERT_EQ(in->get_version_border(), false);
-    auto* child_of_root = dynamic_cast<interior_node*>(in->get_child_at(0));
+    auto* child_of_root = static_cast<interior_node*>(in->get_child_at(0));
     /**
      * child of root[0] is interior.
      */
     ASSERT_EQ(child_of_root->get_version_border(), false);
-    child_of_root = dynamic_cast<interior_node*>(in->get_child_at(1));
+    child_of_root = static_cast<interior_node*>(in->get_child_at(1));
     /**
      * child of root[1] is interior.
      */
     ASSERT_EQ(child_of_root->get_version_border(), false);
     auto* child_child_of_root =
-            dynamic_cast<border_node*>(child_of_root->get_child_at(0));
+            static_cast<border_node*>(child_of_root->get_child_at(0));
     /**
      * child of child of root[0] is border.
      */
@@ -357,24 +359,24 @@ TEST_F(dt, two_interi) { // NOLINT
     constexpr std::size_t n_in_bn = key_slice_length / 2 + 1;
 
     ASSERT_EQ(n_in_bn - 1,
-              dynamic_cast<interior_node*>(
-                      dynamic_cast<interior_node*>(ti->load_root_ptr())
+              static_cast<interior_node*>(
+                      static_cast<interior_node*>(ti->load_root_ptr())
                               ->get_child_at(0))
                       ->get_n_keys());
     for (std::size_t i = 0; i < n_in_bn; ++i) {
         ASSERT_EQ(status::OK, remove(token, test_storage_name, k.at(i)));
     }
     ASSERT_EQ(n_in_bn - 2,
-              dynamic_cast<interior_node*>(
-                      dynamic_cast<interior_node*>(ti->load_root_ptr())
+              static_cast<interior_node*>(
+                      static_cast<interior_node*>(ti->load_root_ptr())
                               ->get_child_at(0))
                       ->get_n_keys());
     constexpr std::size_t to_sb = (n_in_bn - 2) * n_in_bn;
     for (std::size_t i = n_in_bn; i < n_in_bn + to_sb; ++i) {
         ASSERT_EQ(status::OK, remove(token, test_storage_name, k.at(i)));
     }
-    ASSERT_EQ(1, dynamic_cast<interior_node*>(
-                         dynamic_cast<interior_node*>(ti->load_root_ptr()))
+    ASSERT_EQ(1, static_cast<interior_node*>(
+                         static_cast<interior_node*>(ti->load_root_ptr()))
                          ->get_n_keys());
     for (std::size_t i = n_in_bn + to_sb; i < ary_size; ++i) {
         ASSERT_EQ(status::OK, remove(token, test_storage_name, k.at(i)));
@@ -419,4 +421,51 @@ TEST_F(dt, many) { // NOLINT
     }
 }
 
+TEST_F(dt, empty_layers) { // NOLINT
+    Token token{};
+    ASSERT_EQ(enter(token), status::OK);
+    /**
+     * The keys share the first key slices, so they are kept in two lower layers. The
+     * layers which become empty are unlinked from the slots of the upper border nodes.
+     */
+    std::vector<std::string> keys{};
+    for (char a = 'A'; a < 'K'; ++a) {
+        for (char b = 'A'; b < 'K'; ++b) {
+            for (char c = '0'; c < '3'; ++c) {
+                keys.emplace_back(std::string(7, 'x') + a + std::string(7, 'y') +
+                                  b + "suffix" + c);
+            }
+        }
+    }
+    std::mt19937 engine{1};
+    for (std::size_t h = 0; h < 2; ++h) {
+        std::shuffle(keys.begin(), keys.end(), engine);
+        for (auto&& k : keys) {
+            ASSERT_EQ(status::OK, put(token, test_storage_name, k, k.data(),
+                                      k.size()));
+        }
+        ASSERT_GT(mem_usage(test_storage_name).size(), 1);
+        std::shuffle(keys.begin(), keys.end(), engine);
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            if (i % 2 == 0) {
+                ASSERT_EQ(status::OK, remove(token, test_storage_name, keys.at(i)));
+            } else {
+                std::pair<char*, std::size_t> out{};
+                ASSERT_EQ(status::OK,
+                          take<char>(token, test_storage_name, keys.at(i), out));
+                ASSERT_EQ(std::string(out.first, out.second), keys.at(i));
+            }
+        }
+        // only the empty root of the top layer remains.
+        memory_usage_stack stat = mem_usage(test_storage_name);
+        ASSERT_EQ(stat.size(), 1);
+        ASSERT_EQ(std::get<0>(stat.at(0)), 1);
+        std::vector<std::tuple<std::string, char*, std::size_t>> tuple_list{};
+        ASSERT_EQ(status::OK, scan<char>(test_storage_name, "", scan_endpoint::INF,
+                                         "", scan_endpoint::INF, tuple_list));
+        ASSERT_EQ(tuple_list.size(), 0);
+    }
+    ASSERT_EQ(leave(token), status::OK);
+}
+
 } // namespace yakushima::testing
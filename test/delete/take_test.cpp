@@ -0,0 +1,97 @@
+/**
+ * @file take_test.cpp
+ * @brief test about take.
+ */
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "kvs.h"
+
+using namespace yakushima;
+
+namespace yakushima::testing {
+
+class take_test : public ::testing::Test {
+protected:
+    void SetUp() override {
+        init();
+        create_storage(st);
+    }
+
+    void TearDown() override { fin(); }
+
+    std::string st{"s"}; // NOLINT
+};
+
+TEST_F(take_test, take) { // NOLINT
+    Token token{};
+    ASSERT_EQ(enter(token), status::OK);
+    std::pair<std::uint32_t*, std::size_t> out{};
+    ASSERT_EQ(status::WARN_STORAGE_NOT_EXIST, take(token, "x", "a", out));
+    ASSERT_EQ(status::OK_NOT_FOUND, take(token, st, "a", out));
+    ASSERT_EQ(out.first, nullptr);
+    // short, long and layered keys.
+    std::vector<std::string> keys{"a", "abcdefgh", "abcdefghi",
+                                  "abcdefghijklmnopqrstu", "abcdefghz"};
+    std::vector<std::uint32_t> values{};
+    for (std::size_t i = 0; i < keys.size(); ++i) { values.emplace_back(i); }
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        ASSERT_EQ(status::OK, put(token, st, keys[i], &values[i]));
+    }
+    // the key suffix is different.
+    ASSERT_EQ(status::OK_NOT_FOUND,
+              take(token, st, "abcdefghijklmnopqrstx", out));
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        ASSERT_EQ(status::OK, take(token, st, keys[i], out));
+        // the removed value stays until leave.
+        ASSERT_EQ(*out.first, i);
+        ASSERT_EQ(out.second, sizeof(std::uint32_t));
+        ASSERT_EQ(status::WARN_NOT_EXIST, get<std::uint32_t>(st, keys[i], out));
+        ASSERT_EQ(status::OK_NOT_FOUND, take(token, st, keys[i], out));
+    }
+    ASSERT_EQ(leave(token), status::OK);
+}
+
+TEST_F(take_test, concurrent_take) { // NOLINT
+    // each value is taken by exactly one session.
+    constexpr std::size_t th_num = 4;
+    constexpr std::size_t n = 10000;
+    {
+        Token token{};
+        ASSERT_EQ(enter(token), status::OK);
+        for (std::size_t i = 0; i < n; ++i) {
+            auto v = static_cast<std::uint32_t>(i);
+            ASSERT_EQ(status::OK, put(token, st, std::to_string(i), &v));
+        }
+        ASSERT_EQ(leave(token), status::OK);
+    }
+    std::atomic<std::size_t> taken_num{0};
+    std::atomic<std::size_t> taken_sum{0};
+    auto work = [this, &taken_num, &taken_sum]() {
+        Token token{};
+        while (enter(token) != status::OK) { _mm_pause(); }
+        for (std::size_t i = 0; i < n; ++i) {
+            std::pair<std::uint32_t*, std::size_t> out{};
+            status ret = take(token, st, std::to_string(i), out);
+            if (ret == status::OK) {
+                ++taken_num;
+                taken_sum += *out.first;
+            } else {
+                ASSERT_EQ(ret, status::OK_NOT_FOUND);
+            }
+        }
+        ASSERT_EQ(leave(token), status::OK);
+    };
+    std::vector<std::thread> threads{};
+    for (std::size_t i = 0; i < th_num; ++i) { threads.emplace_back(work); }
+    for (auto&& th : threads) { th.join(); }
+    ASSERT_EQ(taken_num, n);
+    ASSERT_EQ(taken_sum, n * (n - 1) / 2);
+}
+
+} // namespace yakushima::testing
@@ -6,6 +6,8 @@
 #include <array>
 #include <future>
 #include <random>
+#include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -37,4 +39,108 @@ TEST_F(get_test, simple) { // NOLINT
     ASSERT_EQ(leave(token), status::OK);
 }
 
+TEST_F(get_test, get_many) { // NOLINT
+    Token token{};
+    ASSERT_EQ(enter(token), status::OK);
+    std::vector<std::string> keys{};
+    std::vector<std::string_view> key_views{};
+    constexpr std::size_t n = 2000;
+    for (std::size_t i = 0; i < n; ++i) {
+        // short keys, keys which share the key slice, and long keys.
+        std::string k{std::to_string(i * 7919 % n)};
+        if (i % 3 == 1) { k = "prefix__" + k; }
+        if (i % 3 == 2) { k = "long_key_" + k + "_with_suffix"; }
+        keys.emplace_back(k);
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        if (i % 2 == 0) {
+            auto v = static_cast<std::uint32_t>(i);
+            ASSERT_EQ(status::OK, put(token, st, keys[i], &v));
+        }
+    }
+    // the keys are not sorted, and the half of them doesn't exist.
+    for (auto&& k : keys) { key_views.emplace_back(k); }
+    std::vector<std::pair<std::uint32_t*, std::size_t>> out{};
+    std::vector<status> rets{};
+    ASSERT_EQ(status::OK, get_many<std::uint32_t>(st, key_views, out, rets));
+    ASSERT_EQ(out.size(), n);
+    ASSERT_EQ(rets.size(), n);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (i % 2 == 0) {
+            ASSERT_EQ(rets[i], status::OK);
+            ASSERT_EQ(*out[i].first, i);
+            ASSERT_EQ(out[i].second, sizeof(std::uint32_t));
+        } else {
+            ASSERT_EQ(rets[i], status::WARN_NOT_EXIST);
+            ASSERT_EQ(out[i].first, nullptr);
+        }
+    }
+
+    // a storage handle and a batch which is not a multiple of the group.
+    storage_handle h{};
+    ASSERT_EQ(find_storage(st, h), status::OK);
+    key_views.resize(YAKUSHIMA_GET_MANY_GROUP + 3);
+    ASSERT_EQ(status::OK, get_many<std::uint32_t>(h, key_views, out, rets));
+    ASSERT_EQ(rets.size(), key_views.size());
+    for (std::size_t i = 0; i < key_views.size(); ++i) {
+        ASSERT_EQ(rets[i], i % 2 == 0 ? status::OK : status::WARN_NOT_EXIST);
+    }
+    key_views.clear();
+    ASSERT_EQ(status::OK, get_many<std::uint32_t>(h, key_views, out, rets));
+    ASSERT_EQ(out.size(), 0);
+    ASSERT_EQ(status::WARN_STORAGE_NOT_EXIST,
+              get_many<std::uint32_t>("dm", key_views, out, rets));
+    h.reset();
+    ASSERT_EQ(leave(token), status::OK);
+}
+
+TEST_F(get_test, get_many_concurrent_put) { // NOLINT
+    // the descent meets splits of the other thread.
+    constexpr std::size_t n = 3000;
+    auto make_key = [](std::size_t i) {
+        std::string key(sizeof(std::uint64_t), '\0');
+        for (std::size_t j = 0; j < sizeof(std::uint64_t); ++j) {
+            key[sizeof(std::uint64_t) - 1 - j] =
+                    static_cast<char>((i >> (j * 8)) & 0xff); // NOLINT
+        }
+        return key;
+    };
+    auto writer = std::async(std::launch::async, [&make_key] {
+        Token token{};
+        while (enter(token) != status::OK) { _mm_pause(); }
+        for (std::size_t i = 1; i < n; i += 2) {
+            auto v = static_cast<std::uint32_t>(i);
+            if (put(token, st, make_key(i), &v) != status::OK) { return false; }
+        }
+        return leave(token) == status::OK;
+    });
+    Token token{};
+    ASSERT_EQ(enter(token), status::OK);
+    for (std::size_t i = 0; i < n; i += 2) {
+        auto v = static_cast<std::uint32_t>(i);
+        ASSERT_EQ(status::OK, put(token, st, make_key(i), &v));
+    }
+    std::vector<std::string> keys{};
+    for (std::size_t i = 0; i < n; ++i) { keys.emplace_back(make_key(i)); }
+    std::vector<std::string_view> key_views(keys.begin(), keys.end());
+    std::vector<std::pair<std::uint32_t*, std::size_t>> out{};
+    std::vector<status> rets{};
+    for (std::size_t round = 0; round < 20; ++round) {
+        ASSERT_EQ(status::OK, get_many<std::uint32_t>(st, key_views, out, rets));
+        for (std::size_t i = 0; i < n; ++i) {
+            if (rets[i] == status::OK) {
+                ASSERT_EQ(*out[i].first, i);
+            } else {
+                // only the keys of the writer may not exist yet.
+                ASSERT_EQ(i % 2, 1);
+                ASSERT_EQ(rets[i], status::WARN_NOT_EXIST);
+            }
+        }
+    }
+    ASSERT_TRUE(writer.get());
+    ASSERT_EQ(status::OK, get_many<std::uint32_t>(st, key_views, out, rets));
+    for (std::size_t i = 0; i < n; ++i) { ASSERT_EQ(rets[i], status::OK); }
+    ASSERT_EQ(leave(token), status::OK);
+}
+
 } // namespace yakushima::testing
@@ -0,0 +1,136 @@
+/**
+ * @file huge_page_arena_test.cpp
+ */
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "kvs.h"
+
+using namespace yakushima;
+
+namespace yakushima::testing {
+
+class huge_page_arena_test : public ::testing::Test {
+protected:
+    void TearDown() override {
+        fin();
+        huge_page_arena::disable();
+    }
+
+    std::string st{"s"}; // NOLINT
+};
+
+TEST_F(huge_page_arena_test, allocate) { // NOLINT
+    init(true);
+    if (!huge_page_arena::is_enabled()) {
+        GTEST_SKIP() << "the region can't be reserved.";
+    }
+    void* a = huge_page_arena::allocate(24, 16);
+    void* b = huge_page_arena::allocate(100, 64);
+    ASSERT_TRUE(huge_page_arena::contains(a));
+    ASSERT_TRUE(huge_page_arena::contains(b));
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(b) % 64, 0); // NOLINT
+    ASSERT_GE(static_cast<std::byte*>(b), static_cast<std::byte*>(a) + 24);
+    // it is exhausted.
+    ASSERT_EQ(huge_page_arena::allocate(YAKUSHIMA_HUGE_PAGE_ARENA_SIZE, 8), nullptr);
+    int on_stack{};
+    ASSERT_FALSE(huge_page_arena::contains(&on_stack));
+    huge_page_arena::disable();
+    ASSERT_EQ(huge_page_arena::allocate(8, 8), nullptr);
+}
+
+TEST_F(huge_page_arena_test, put_get) { // NOLINT
+    init(true);
+    if (!huge_page_arena::is_enabled()) {
+        GTEST_SKIP() << "the region can't be reserved.";
+    }
+    create_storage(st);
+    Token token{};
+    ASSERT_EQ(enter(token), status::OK);
+    constexpr std::size_t n = 2000;
+    for (std::size_t i = 0; i < n; ++i) {
+        std::string v(i % 64, 'v'); // NOLINT
+        ASSERT_EQ(status::OK, put(token, st, std::to_string(i), v.data(), v.size()));
+    }
+    for (std::size_t i = 0; i < n; i += 2) {
+        ASSERT_EQ(status::OK, remove(token, st, std::to_string(i)));
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        std::pair<char*, std::size_t> out{};
+        if (i % 2 == 0) {
+            ASSERT_EQ(status::WARN_NOT_EXIST, get<char>(st, std::to_string(i), out));
+            continue;
+        }
+        ASSERT_EQ(status::OK, get<char>(st, std::to_string(i), out));
+        ASSERT_EQ(std::string(out.first, out.second), std::string(i % 64, 'v'));
+        if (out.second > 0) {
+            // the blocks of the small values are in the region.
+            ASSERT_TRUE(huge_page_arena::contains(out.first));
+        }
+    }
+    ASSERT_EQ(leave(token), status::OK);
+    // the blocks of the region go back to the lists of the arena, not to the heap.
+    fin();
+    init();
+    ASSERT_FALSE(huge_page_arena::is_enabled());
+}
+
+TEST_F(huge_page_arena_test, numa) { // NOLINT
+    // the ids of the nodes may have gaps.
+    numa_nodes nodes = parse_numa_nodes("0,2-3,5\n");
+    ASSERT_EQ(nodes.num_, std::min<std::size_t>(4, YAKUSHIMA_MAX_NUMA_NODES));
+    ASSERT_EQ(nodes.ids_.at(0), 0);
+    ASSERT_EQ(nodes.ids_.at(1), 2);
+    ASSERT_EQ(nodes.mask_.at(0) & 0b101101UL, nodes.mask_.at(0));
+    nodes = parse_numa_nodes("1");
+    ASSERT_EQ(nodes.num_, 1);
+    ASSERT_EQ(nodes.ids_.at(0), 1);
+    ASSERT_EQ(nodes.mask_.at(0), 0b10UL);
+    // a list which can't be read is node 0.
+    nodes = parse_numa_nodes("");
+    ASSERT_EQ(nodes.num_, 1);
+    ASSERT_EQ(nodes.ids_.at(0), 0);
+    ASSERT_GE(numa_node_num(), 1);
+    ASSERT_LT(current_numa_node(), numa_node_num());
+    init(true, numa_policy::LOCAL);
+    if (!huge_page_arena::is_enabled()) {
+        GTEST_SKIP() << "the region can't be reserved.";
+    }
+    ASSERT_EQ(huge_page_arena::local_node(), current_numa_node());
+    // each NUMA node has its part.
+    std::vector<void*> blocks{};
+    for (std::size_t node = 0; node < numa_node_num(); ++node) {
+        void* block = huge_page_arena::allocate(64, 64, node);
+        ASSERT_TRUE(huge_page_arena::contains(block));
+        ASSERT_EQ(huge_page_arena::node_of(block), node);
+        ASSERT_EQ(numa_node_index(numa_node_id(node)), node);
+        ASSERT_EQ(huge_page_arena::list_of(block), node);
+        blocks.emplace_back(block);
+    }
+    // the pools use the lists of node 0 while the arena is disabled.
+    huge_page_arena::disable();
+    ASSERT_EQ(huge_page_arena::local_node(), 0);
+    for (auto* block : blocks) { ASSERT_EQ(huge_page_arena::list_of(block), 0); }
+    huge_page_arena::enable(numa_policy::LOCAL);
+    create_storage(st);
+    Token token{};
+    ASSERT_EQ(enter(token), status::OK);
+    ASSERT_EQ(get_numa_node(token), numa_node_id(huge_page_arena::local_node()));
+    std::string v(32, 'v'); // NOLINT
+    ASSERT_EQ(status::OK, put(token, st, "k", v.data(), v.size()));
+    std::pair<char*, std::size_t> out{};
+    ASSERT_EQ(status::OK, get<char>(st, "k", out));
+    // the value is in the part of the node where the session entered.
+    ASSERT_TRUE(huge_page_arena::contains(out.first));
+    ASSERT_EQ(numa_node_id(huge_page_arena::node_of(out.first)), get_numa_node(token));
+    ASSERT_EQ(leave(token), status::OK);
+    fin();
+    init(true, numa_policy::INTERLEAVE);
+    ASSERT_TRUE(huge_page_arena::is_enabled());
+}
+
+} // namespace yakushima::testing
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace yakushima::testing {
+
+/**
+ * @return The key of @a i following @a prefix_len bytes of a prefix. The keys are
+ * big-endian, so that the order of keys is the order of numbers.
+ */
+[[maybe_unused]] static std::string make_key(std::size_t i, std::size_t prefix_len = 0) {
+    std::string key(prefix_len, 'p');
+    for (std::size_t j = sizeof(std::size_t); j > 0; --j) {
+        key.push_back(static_cast<char>((i >> ((j - 1) * 8)) & 0xff)); // NOLINT
+    }
+    return key;
+}
+
+} // namespace yakushima::testing
@@ -3,6 +3,7 @@
  */
 
 #include <array>
+#include <string>
 
 #include "gtest/gtest.h"
 
@@ -53,4 +54,64 @@ TEST_F(interface_helper_test, init) { // NOLINT
     ASSERT_EQ(leave(token), status::OK);
 }
 
+TEST_F(interface_helper_test, recover_border) { // NOLINT
+    tree_instance* ti{};
+    find_storage(test_storage_name, &ti);
+    Token token{};
+    ASSERT_EQ(enter(token), status::OK);
+    auto make_key = [](std::size_t i) {
+        std::string key{};
+        for (std::size_t j = sizeof(std::size_t); j > 0; --j) {
+            key.push_back(static_cast<char>((i >> ((j - 1) * 8)) & 0xff)); // NOLINT
+        }
+        return key;
+    };
+    std::uint32_t v{1};
+    ASSERT_EQ(status::OK, put(token, test_storage_name, make_key(0), &v));
+    status special_status{};
+    auto node_and_v = find_border(ti->load_root_ptr(),
+                                  make_key_slice(make_key(0)),
+                                  sizeof(key_slice_type), special_status);
+    border_node* bn = std::get<0>(node_and_v);
+    node_version64_body v_at_fb = std::get<1>(node_and_v);
+    ASSERT_EQ(special_status, status::OK);
+
+    // split the node which find_border returned.
+    constexpr std::size_t n = key_slice_length * 3;
+    for (std::size_t i = 1; i < n; ++i) {
+        ASSERT_EQ(status::OK, put(token, test_storage_name, make_key(i), &v));
+    }
+    ASSERT_NE(bn->get_next(), nullptr);
+    border_node* const first = bn;
+    node_version64_body const first_v = v_at_fb;
+
+    // the last key is reached by moving right.
+    retry_stats before = get_retry_stats();
+    key_slice_type ks = make_key_slice(make_key(n - 1));
+    ASSERT_EQ(recover_border(bn, v_at_fb, ti->load_root_ptr(), ks,
+                             sizeof(key_slice_type)),
+              status::OK_RETRY_FETCH_LV);
+    ASSERT_NE(bn, first);
+    ASSERT_TRUE(bn->covers(ks, sizeof(key_slice_type)));
+    ASSERT_EQ(v_at_fb, bn->get_stable_version());
+    ASSERT_EQ(get_retry_stats().move_right, before.move_right + 1);
+
+    /**
+     * The lowest key of the second node is removed, so it is not sure which node covers
+     * it, and it needs to find border from the root of the layer.
+     */
+    border_node* second = first->get_next();
+    permutation perm{second->get_permutation().get_body()};
+    key_slice_type gap = second->get_key_slice_at(perm.get_index_of_rank(0));
+    std::string gap_key = make_key(static_cast<std::size_t>(gap));
+    ASSERT_EQ(status::OK, remove(token, test_storage_name, gap_key));
+    bn = first;
+    v_at_fb = first_v;
+    ASSERT_EQ(recover_border(bn, v_at_fb, ti->load_root_ptr(), gap,
+                             sizeof(key_slice_type)),
+              status::OK_RETRY_AFTER_FB);
+    ASSERT_EQ(get_retry_stats().from_layer_root, before.from_layer_root + 1);
+    ASSERT_EQ(leave(token), status::OK);
+}
+
 } // namespace yakushima::testing
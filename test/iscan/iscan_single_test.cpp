@@ -135,6 +135,16 @@ std::vector<std::variant<B, void*>> rev_expected(const std::vector<std::variant<
     return ret;
 }
 
+/**
+ * A key longer than a key slice is kept with its key suffix until another key shares the
+ * key slice. This puts and removes such a key, so that the next layer is made.
+ */
+void make_layer(Token token, std::string_view k) {
+    void* v = reinterpret_cast<void*>(uintptr_t(0x00000000ff808080));
+    ASSERT_OK(put<void*>(token, st, k, &v, sizeof(v)));
+    ASSERT_OK(remove(token, st, k));
+}
+
 void tc(std::string_view l_key, scan_endpoint l_end, std::string_view r_key, scan_endpoint r_end,
         bool right_to_left,
         std::vector<std::variant<B, void*>>&& expected) {
@@ -392,6 +402,66 @@ TEST_F(iscan_single_test, l0b2_lowkey) {
     ASSERT_OK(leave(token));
 }
 
+TEST_F(iscan_single_test, l0b1_suffix) {
+    // L0 (b) --- k1, k2 with key suffix
+    std::string k1("k123456789");
+    std::string k2("k23456789");
+    void* v1 = reinterpret_cast<void*>(uintptr_t(0x0000000081808080));
+    void* v2 = reinterpret_cast<void*>(uintptr_t(0x0000000082808080));
+    Token token{};
+    ASSERT_OK(enter(token));
+    ASSERT_OK(put<void*>(token, st, std::string_view(k1), &v1, sizeof(v1)));
+    ASSERT_OK(put<void*>(token, st, std::string_view(k2), &v2, sizeof(v2)));
+
+    border_node* b;
+    {
+        tree_instance* ti{};
+        find_storage(st, &ti);
+        base_node* root = ti->load_root_ptr();
+        ASSERT_EQ(root->get_version_border(), true);
+        b = static_cast<border_node*>(root);
+        ASSERT_EQ(b->get_lv_at(0)->get_next_layer(), nullptr);
+        ASSERT_EQ(b->get_lv_at(0)->get_key_suffix()->get_view(), "89");
+        ASSERT_EQ(b->get_lv_at(1)->get_next_layer(), nullptr);
+    }
+
+    // (-inf, +inf)  full-scan
+    tc("", scan_endpoint::INF, "", scan_endpoint::INF,
+       {B{b}, v1, B{b}, v2, B{b}});
+    // [k1, k1]
+    tc(k1, scan_endpoint::INCLUSIVE, k1, scan_endpoint::INCLUSIVE,
+       {B{}, v1, B{}});
+    // (-inf, "k123456781"]  ("k123456781" is less than k1 by the key suffix)
+    tc("", scan_endpoint::INF, "k123456781", scan_endpoint::INCLUSIVE,
+       {B{b}});
+    // (-inf, k1)
+    tc("", scan_endpoint::INF, k1, scan_endpoint::EXCLUSIVE,
+       {B{b}});
+    // (-inf, k1]
+    tc("", scan_endpoint::INF, k1, scan_endpoint::INCLUSIVE,
+       {B{b}, v1, B{}});
+    // ("k1234567", +inf)  ("k1234567" is less than k1 by the key length)
+    tc("k1234567", scan_endpoint::EXCLUSIVE, "", scan_endpoint::INF,
+       {B{b}, v1, B{b}, v2, B{b}});
+    // ["k123456789a", +inf)  ("k123456789a" is greater than k1 by the key suffix)
+    tc("k123456789a", scan_endpoint::INCLUSIVE, "", scan_endpoint::INF,
+       {B{b}, v2, B{b}});
+    // ("k123456788", "k2345678a")
+    tc("k123456788", scan_endpoint::EXCLUSIVE, "k2345678a", scan_endpoint::EXCLUSIVE,
+       {B{b}, v1, B{b}, v2, B{b}});
+
+    // the key suffix completes the full key
+    iscan_context* ctx{nullptr};
+    ctx_cleaner<iscan_context> cleaner{ctx};
+    void* val;
+    ASSERT_OK(iscan_open(st, "", scan_endpoint::INF, "", scan_endpoint::INF, false, false, ctx, val));
+    ASSERT_EQ(ctx->full_key(), k1);
+    ASSERT_OK(iscan_next(ctx, val));
+    ASSERT_EQ(ctx->full_key(), k2);
+    ASSERT_OK(iscan_close(ctx));
+    ASSERT_OK(leave(token));
+}
+
 TEST_F(iscan_single_test, l1b1b1) {
     // L0 (b)
     //     +-- L11 (b) --- k1
@@ -404,6 +474,9 @@ TEST_F(iscan_single_test, l1b1b1) {
     ASSERT_OK(enter(token));
     ASSERT_OK(put<void*>(token, st, std::string_view(k1), &v1, sizeof(v1)));
     ASSERT_OK(put<void*>(token, st, std::string_view(k2), &v2, sizeof(v2)));
+    // a key which shares the key slice makes the layer, which remains after removing it.
+    ASSERT_NO_FATAL_FAILURE(make_layer(token, "k12345670"));
+    ASSERT_NO_FATAL_FAILURE(make_layer(token, "k23456780"));
 
     border_node* b0;
     border_node* b11;
@@ -690,6 +763,8 @@ TEST_F(iscan_single_test, l2b2v2) {
     ASSERT_OK(enter(token));
     ASSERT_OK(put<void*>(token, st, std::string_view(k1), &v1, sizeof(v1)));
     ASSERT_OK(put<void*>(token, st, std::string_view(k2), &v2, sizeof(v2)));
+    ASSERT_NO_FATAL_FAILURE(make_layer(token, "01234567" "abcdefgh" "0"));
+    ASSERT_NO_FATAL_FAILURE(make_layer(token, "01234567" "ijklmnop" "0"));
 
     border_node* b0;
     border_node* b1;
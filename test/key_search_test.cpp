@@ -0,0 +1,143 @@
+/**
+ * @file key_search_test.cpp
+ */
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "border_node.h"
+#include "key_search.h"
+
+using namespace yakushima;
+
+namespace yakushima::testing {
+
+class key_search_test : public ::testing::Test {};
+
+TEST_F(key_search_test, match_key_slice) { // NOLINT
+    std::array<key_slice_type, key_slice_length> slices{};
+    std::mt19937_64 mt{0};
+    for (std::size_t i = 0; i < key_slice_length; ++i) { slices.at(i) = mt() % 4; }
+    for (key_slice_type probe = 0; probe < 5; ++probe) {
+        std::uint32_t expected{0};
+        for (std::size_t i = 0; i < key_slice_length; ++i) {
+            if (slices.at(i) == probe) { expected |= 1U << i; }
+        }
+        ASSERT_EQ(match_key_slice(slices, probe), expected);
+    }
+    // every slot including the last one is compared.
+    slices.fill(0);
+    slices.at(key_slice_length - 1) = ~0UL;
+    ASSERT_EQ(match_key_slice(slices, ~0UL), 1U << (key_slice_length - 1));
+    ASSERT_EQ(match_key_slice(slices, 0),
+              (1U << (key_slice_length - 1)) - 1);
+}
+
+TEST_F(key_search_test, less_key_slice) { // NOLINT
+    std::array<key_slice_type, key_slice_length> slices{};
+    std::mt19937_64 mt{1};
+    for (auto&& s : slices) { s = mt(); }
+    slices.at(3) = 0;
+    slices.at(4) = ~0UL;
+    for (std::size_t n = 0; n < 100; ++n) {
+        key_slice_type probe = n < key_slice_length ? slices.at(n) : mt();
+        std::uint32_t expected{0};
+        for (std::size_t i = 0; i < key_slice_length; ++i) {
+            if (slices.at(i) < probe) { expected |= 1U << i; }
+        }
+        ASSERT_EQ(less_key_slice(slices, probe), expected);
+    }
+}
+
+template<std::size_t Width>
+static void check_search_child_index(std::uint64_t seed) {
+    // reference: the linear scan which get_child_of used before.
+    auto linear = [](const auto& slices, const auto& lengths, std::size_t n_keys,
+                     key_slice_type ks, key_length_type kl) {
+        for (std::size_t i = 0; i < n_keys; ++i) {
+            if (ks < slices.at(i) ||
+                (ks == slices.at(i) && kl < lengths.at(i))) {
+                return i;
+            }
+        }
+        return n_keys;
+    };
+    std::mt19937_64 mt{seed};
+    for (std::size_t round = 0; round < 1000; ++round) {
+        std::size_t n_keys = mt() % (Width + 1);
+        // sorted separators with many equal slices
+        std::vector<base_node::key_tuple> seps{};
+        for (std::size_t i = 0; i < n_keys; ++i) {
+            seps.emplace_back(mt() % 4, 1 + mt() % (sizeof(key_slice_type) + 1));
+        }
+        std::sort(seps.begin(), seps.end());
+        std::array<key_slice_type, Width> slices{};
+        std::array<key_length_type, Width> lengths{};
+        for (std::size_t i = 0; i < Width; ++i) {
+            // garbage beyond n_keys must be ignored.
+            slices.at(i) = i < n_keys ? seps.at(i).get_key_slice() : mt() % 4;
+            lengths.at(i) = i < n_keys ? seps.at(i).get_key_length() : 0;
+        }
+        key_slice_type ks = mt() % 5;
+        auto kl = static_cast<key_length_type>(mt() % (sizeof(key_slice_type) + 2));
+        ASSERT_EQ(search_child_index(slices, lengths, n_keys, ks, kl),
+                  linear(slices, lengths, n_keys, ks, kl));
+    }
+}
+
+TEST_F(key_search_test, search_child_index) { // NOLINT
+    check_search_child_index<interior_key_slice_length>(2);
+    // other widths which YAKUSHIMA_INTERIOR_WIDTH allows.
+    check_search_child_index<3>(3);
+    check_search_child_index<31>(4);
+    check_search_child_index<63>(5);
+}
+
+TEST_F(key_search_test, live_index_mask) { // NOLINT
+    permutation per{};
+    ASSERT_EQ(per.get_live_index_mask(), 0U);
+    per.insert_rank(0, 3);
+    per.insert_rank(0, 7);
+    per.insert_rank(2, 14);
+    ASSERT_EQ(per.get_live_index_mask(), (1U << 3) | (1U << 7) | (1U << 14));
+    per.delete_rank(0);
+    ASSERT_EQ(per.get_live_index_mask(), (1U << 3) | (1U << 14));
+}
+
+TEST_F(key_search_test, get_lv_of_same_slice) { // NOLINT
+    // key \0, key \0\0 and a long key beginning with \0 share the same slice.
+    border_node bn;
+    bn.init_border();
+    std::array<value*, 3> vals{};
+    std::string zeros(3, '\0');
+    for (std::size_t i = 0; i < vals.size(); ++i) {
+        std::size_t v = i;
+        vals.at(i) = value::create_value<false>(
+                &v, sizeof(v), static_cast<value_align_type>(alignof(std::size_t)));
+        bn.insert_lv_at(i, std::string_view{zeros.data(), 1 + i}, vals.at(i),
+                        nullptr, i, nullptr);
+    }
+    // mark the third slot as a long key so that only lengths tell them apart.
+    bn.set_key_length_at(2, sizeof(key_slice_type) + 1);
+    node_version64_body v{};
+    std::size_t lv_pos{};
+    ASSERT_EQ(bn.get_lv_of(0, 1, v, lv_pos), bn.get_lv_at(0));
+    ASSERT_EQ(lv_pos, 0);
+    ASSERT_EQ(bn.get_lv_of(0, 2, v, lv_pos), bn.get_lv_at(1));
+    ASSERT_EQ(lv_pos, 1);
+    ASSERT_EQ(bn.get_lv_of_without_lock(0, sizeof(key_slice_type) + 1),
+              bn.get_lv_at(2));
+    ASSERT_EQ(bn.get_lv_of_without_lock(0, 3), nullptr);
+    ASSERT_EQ(bn.get_lv_of_without_lock(1, 1), nullptr);
+    // deleted slot is not found even if its slice remains.
+    bn.get_permutation().delete_rank(0);
+    ASSERT_EQ(bn.get_lv_of(0, 1, v, lv_pos), nullptr);
+    value::delete_value(vals.at(0));
+    bn.destroy();
+}
+
+} // namespace yakushima::testing
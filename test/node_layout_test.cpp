@@ -0,0 +1,133 @@
+/**
+ * @file node_layout_test.cpp
+ * @brief It checks the cache line occupancy of nodes and the lines which a search
+ * reads.
+ */
+
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "border_node.h"
+#include "interior_node.h"
+
+using namespace yakushima;
+
+namespace yakushima::testing {
+
+class node_layout_test : public ::testing::Test {
+public:
+    struct member {
+        std::string name;
+        std::size_t offset;
+        std::size_t size;
+        bool search;
+    };
+
+    static std::size_t first_line(const member& m) {
+        return m.offset / CACHE_LINE_SIZE;
+    }
+
+    static std::size_t last_line(const member& m) {
+        return (m.offset + m.size - 1) / CACHE_LINE_SIZE;
+    }
+
+    /**
+     * @return the cache line occupancy of the members, which is shown when a check fails.
+     */
+    static std::string layout(const std::string& node, std::size_t node_size,
+                              const std::vector<member>& members) {
+        std::ostringstream os;
+        os << node << " : " << node_size << " bytes, "
+           << (node_size + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE << " lines\n";
+        for (const auto& m : members) {
+            os << "  " << (m.search ? "* " : "  ") << m.name << " : offset " << m.offset
+               << ", size " << m.size << ", line " << first_line(m);
+            if (last_line(m) != first_line(m)) { os << "-" << last_line(m); }
+            os << "\n";
+        }
+        return os.str();
+    }
+
+    /**
+     * @brief the members lie in the node without overlapping each other.
+     */
+    static void check_members(std::size_t node_size, const std::vector<member>& members) {
+        for (const auto& m : members) {
+            EXPECT_LE(m.offset + m.size, node_size) << m.name;
+            for (const auto& o : members) {
+                if (&o == &m) { continue; }
+                EXPECT_TRUE(m.offset + m.size <= o.offset || o.offset + o.size <= m.offset)
+                        << m.name << " overlaps " << o.name;
+            }
+        }
+    }
+
+    /**
+     * @return the lines which the members marked as search occupy.
+     */
+    static std::set<std::size_t> search_lines(const std::vector<member>& members) {
+        std::set<std::size_t> lines{};
+        for (const auto& m : members) {
+            if (!m.search) { continue; }
+            for (auto l = first_line(m); l <= last_line(m); ++l) { lines.insert(l); }
+        }
+        return lines;
+    }
+
+    template<class Node, std::size_t Width>
+    static std::vector<member> head_members() {
+        return {
+                {"version_", base_node::version_offset(), sizeof(node_version64), true},
+                {"parent_", base_node::parent_offset(), sizeof(base_node*), false},
+                {"key_length_", Node::key_length_offset(),
+                 sizeof(key_length_type) * Width, true},
+                {"key_slice_", Node::key_slice_offset(),
+                 sizeof(key_slice_type) * Width, true},
+        };
+    }
+
+    /**
+     * @brief the lines which a search reads are the leading lines without a gap.
+     */
+    static void check_search_lines(const std::vector<member>& members) {
+        auto lines = search_lines(members);
+        ASSERT_EQ(*lines.begin(), 0);
+        ASSERT_EQ(*lines.rbegin() + 1, lines.size());
+    }
+};
+
+TEST_F(node_layout_test, border_node) { // NOLINT
+    auto members = head_members<border_node, key_slice_length>();
+    members.push_back({"permutation_", border_node::permutation_offset(),
+                       sizeof(permutation), true});
+    members.push_back({"lv_", border_node::lv_offset(),
+                       sizeof(link_or_value) * key_slice_length, false});
+    members.push_back({"prev_", border_node::prev_offset(), sizeof(border_node*),
+                       false});
+    members.push_back({"next_", border_node::next_offset(), sizeof(border_node*),
+                       false});
+    SCOPED_TRACE(layout("border_node", sizeof(border_node), members));
+    check_members(sizeof(border_node), members);
+    check_search_lines(members);
+    if (key_slice_length == 15) { ASSERT_EQ(search_lines(members).size(), 3); }
+}
+
+TEST_F(node_layout_test, interior_node) { // NOLINT
+    auto members = head_members<interior_node, interior_key_slice_length>();
+    members.push_back({"n_keys_", interior_node::n_keys_offset(),
+                       sizeof(interior_node::n_keys_type), true});
+    members.push_back({"children", interior_node::children_offset(),
+                       sizeof(base_node*) * interior_node::child_length, false});
+    SCOPED_TRACE(layout("interior_node", sizeof(interior_node), members));
+    check_members(sizeof(interior_node), members);
+    check_search_lines(members);
+    if (interior_key_slice_length == 15) {
+        ASSERT_EQ(search_lines(members).size(), 3);
+    }
+}
+
+} // namespace yakushima::testing
@@ -0,0 +1,76 @@
+/**
+ * @file node_pool_test.cpp
+ */
+
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "kvs.h"
+
+using namespace yakushima;
+
+namespace yakushima::testing {
+
+class node_pool_test : public ::testing::Test {};
+
+TEST_F(node_pool_test, reuse) { // NOLINT
+    auto* n = new border_node(); // NOLINT
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(n) % alignof(border_node), // NOLINT
+              0);
+    delete n; // NOLINT
+    // a released node is reused after the list of this thread runs out.
+    std::set<void*> allocated{};
+    std::vector<interior_node*> interiors{};
+    for (std::size_t i = 0; i < YAKUSHIMA_NODE_POOL_CHUNK * 3; ++i) {
+        auto* b = new border_node(); // NOLINT
+        allocated.insert(b);
+        interiors.emplace_back(new interior_node()); // NOLINT
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(interiors.back()) % // NOLINT
+                          alignof(interior_node),
+                  0);
+        delete b; // NOLINT
+    }
+    if (YAKUSHIMA_NODE_POOL_CHUNK > 0) {
+        ASSERT_LE(allocated.size(), YAKUSHIMA_NODE_POOL_CHUNK);
+    }
+    for (auto* in : interiors) { delete in; } // NOLINT
+}
+
+TEST_F(node_pool_test, concurrent) { // NOLINT
+    // nodes allocated by a thread are released by another one.
+    constexpr std::size_t th_num = 4;
+    constexpr std::size_t n = 10000;
+    std::vector<std::vector<border_node*>> nodes(th_num);
+    std::vector<std::thread> threads{};
+    for (std::size_t i = 0; i < th_num; ++i) {
+        threads.emplace_back([&nodes, i]() {
+            std::vector<border_node*> mine{};
+            for (std::size_t j = 0; j < n; ++j) {
+                auto* b = new border_node(); // NOLINT
+                b->init_border();
+                mine.emplace_back(b);
+                if (j % 2 == 0) {
+                    delete mine.front(); // NOLINT
+                    mine.erase(mine.begin());
+                }
+            }
+            nodes[i] = mine;
+        });
+    }
+    for (auto&& th : threads) { th.join(); }
+    std::set<border_node*> unique{};
+    for (auto&& mine : nodes) { unique.insert(mine.begin(), mine.end()); }
+    ASSERT_EQ(unique.size(), th_num * n / 2);
+    threads.clear();
+    for (std::size_t i = 0; i < th_num; ++i) {
+        threads.emplace_back([&nodes, i]() {
+            for (auto* b : nodes[(i + 1) % th_num]) { delete b; } // NOLINT
+        });
+    }
+    for (auto&& th : threads) { th.join(); }
+}
+
+} // namespace yakushima::testing
@@ -63,14 +63,14 @@ TEST_F(put_test, put_to_root_border_split) { // NOLINT
 
     // check root is interior
     auto* n = ti->load_root_ptr();
-    ASSERT_EQ(typeid(*n), typeid(interior_node)); // NOLINT
-    auto* in = dynamic_cast<interior_node*>(ti->load_root_ptr());
+    ASSERT_FALSE(n->get_version_border());
+    auto* in = static_cast<interior_node*>(ti->load_root_ptr());
     // check child is border node which has 8 elements
-    auto* bn = dynamic_cast<border_node*>(in->get_child_at(0));
+    auto* bn = static_cast<border_node*>(in->get_child_at(0));
     ASSERT_EQ(bn->get_permutation_cnk(), 8);
     // check that it is not root node
     ASSERT_EQ(bn->get_stable_version().get_root(), false);
-    bn = dynamic_cast<border_node*>(in->get_child_at(1));
+    bn = static_cast<border_node*>(in->get_child_at(1));
     ASSERT_EQ(bn->get_permutation_cnk(), 8);
     // check that it is not root node
     ASSERT_EQ(bn->get_stable_version().get_root(), false);
@@ -105,7 +105,7 @@ TEST_F(put_test, put_to_root_interior_split_layer0) { // NOLINT
     // check root is interior with 16 (key_slice_length+1) children
     auto* n = ti->load_root_ptr();
     ASSERT_FALSE(n->get_version_border());
-    auto* rn = dynamic_cast<interior_node*>(n);
+    auto* rn = static_cast<interior_node*>(n);
     ASSERT_EQ(rn->get_n_keys(), key_slice_length);
     // children are all border node
     for (std::size_t i = 0; i <= rn->get_n_keys(); ++i) {
@@ -121,15 +121,15 @@ TEST_F(put_test, put_to_root_interior_split_layer0) { // NOLINT
     // check root is interior with 2 children
     n = ti->load_root_ptr();
     ASSERT_FALSE(n->get_version_border());
-    rn = dynamic_cast<interior_node*>(n);
+    rn = static_cast<interior_node*>(n);
     ASSERT_EQ(rn->get_n_keys(), 1);
     // check child 0 is interior node, not root
     ASSERT_FALSE(rn->get_child_at(0)->get_version_border());
-    auto* in0 = dynamic_cast<interior_node*>(rn->get_child_at(0));
+    auto* in0 = static_cast<interior_node*>(rn->get_child_at(0));
     ASSERT_FALSE(in0->get_version_root());
     // check child 1 is interior node, not root
     ASSERT_FALSE(rn->get_child_at(1)->get_version_border());
-    auto* in1 = dynamic_cast<interior_node*>(rn->get_child_at(1));
+    auto* in1 = static_cast<interior_node*>(rn->get_child_at(1));
     ASSERT_FALSE(in1->get_version_root());
     // sum of num children is key_slice_length+2
     ASSERT_EQ(in0->get_n_keys() + in1->get_n_keys(), key_slice_length); // (key_slice_length+2-N0)-1 + (N0)-1
@@ -166,12 +166,12 @@ TEST_F(put_test, put_to_root_interior_split_layer1) { // NOLINT
     // check root is border node with 1 child
     auto* n = ti->load_root_ptr();
     ASSERT_TRUE(n->get_version_border());
-    auto* bn = dynamic_cast<border_node*>(n);
+    auto* bn = static_cast<border_node*>(n);
     ASSERT_EQ(bn->get_permutation_cnk(), 1);
     // check L1 root is interior with 16 (key_slice_length+1) children
     auto *l1r = bn->get_lv_at(0)->get_next_layer();
     ASSERT_FALSE(l1r->get_version_border());
-    auto* rn = dynamic_cast<interior_node*>(l1r);
+    auto* rn = static_cast<interior_node*>(l1r);
     ASSERT_EQ(rn->get_n_keys(), key_slice_length);
     // children are all border node
     for (std::size_t i = 0; i <= rn->get_n_keys(); ++i) {
@@ -187,20 +187,20 @@ TEST_F(put_test, put_to_root_interior_split_layer1) { // NOLINT
     // check root is border node with 1 child
     n = ti->load_root_ptr();
     ASSERT_TRUE(n->get_version_border());
-    bn = dynamic_cast<border_node*>(n);
+    bn = static_cast<border_node*>(n);
     ASSERT_EQ(bn->get_permutation_cnk(), 1);
     // check L1 root is interior with 2 children
     l1r = bn->get_lv_at(0)->get_next_layer();
     ASSERT_FALSE(l1r->get_version_border());
-    rn = dynamic_cast<interior_node*>(l1r);
+    rn = static_cast<interior_node*>(l1r);
     ASSERT_EQ(rn->get_n_keys(), 1);
     // check child 0 is interior node, not root
     ASSERT_FALSE(rn->get_child_at(0)->get_version_border());
-    auto* in0 = dynamic_cast<interior_node*>(rn->get_child_at(0));
+    auto* in0 = static_cast<interior_node*>(rn->get_child_at(0));
     ASSERT_FALSE(in0->get_version_root());
     // check child 1 is interior node, not root
     ASSERT_FALSE(rn->get_child_at(1)->get_version_border());
-    auto* in1 = dynamic_cast<interior_node*>(rn->get_child_at(1));
+    auto* in1 = static_cast<interior_node*>(rn->get_child_at(1));
     ASSERT_FALSE(in1->get_version_root());
     // sum of num children is key_slice_length+2
     ASSERT_EQ(in0->get_n_keys() + in1->get_n_keys(), key_slice_length); // (key_slice_length+2-N0)-1 + (N0)-1
@@ -239,11 +239,11 @@ TEST_F(put_test, one_key_len9) { // NOLINT
 
     // verify
     auto* n = ti->load_root_ptr();
-    ASSERT_EQ(typeid(*n), typeid(border_node)); // NOLINT
+    ASSERT_TRUE(n->get_version_border());
     auto* nvp_first_border_node = n->get_version_ptr();
     ASSERT_EQ(nvp, nvp_first_border_node);
     auto* n_second_border_node =
-            dynamic_cast<border_node*>(n)->get_lv_at(0)->get_next_layer();
+            static_cast<border_node*>(n)->get_lv_at(0)->get_next_layer();
     ASSERT_NE(nvp, n_second_border_node->get_version_ptr());
 
     ASSERT_EQ(leave(token), status::OK);
@@ -0,0 +1,213 @@
+/**
+ * @file put_get_batch_test.cpp
+ * @brief test about apply_batch.
+ */
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "kvs.h"
+#include "test_key.h"
+
+using namespace yakushima;
+
+namespace yakushima::testing {
+
+class put_get_batch_test : public ::testing::Test {
+protected:
+    void SetUp() override {
+        init();
+        create_storage(st);
+    }
+
+    void TearDown() override { fin(); }
+
+    std::string st{"s"}; // NOLINT
+};
+
+TEST_F(put_get_batch_test, sorted) { // NOLINT
+    constexpr std::size_t n = 2000;
+    for (std::size_t prefix_len : {0, 3, 8, 20}) { // NOLINT
+        Token token{};
+        ASSERT_EQ(enter(token), status::OK);
+        std::vector<std::string> keys{};
+        std::vector<std::uint32_t> values{};
+        for (std::size_t i = 0; i < n; ++i) {
+            keys.emplace_back(make_key(i, prefix_len));
+            values.emplace_back(i);
+        }
+        std::vector<batch_entry<std::uint32_t>> batch{};
+        std::vector<status> rets{};
+        for (std::size_t i = 0; i < n; ++i) {
+            batch.push_back({batch_op::PUT, keys[i], &values[i]});
+        }
+        ASSERT_EQ(status::OK, apply_batch(token, st, batch, rets));
+        ASSERT_EQ(rets.size(), n);
+        for (std::size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(rets[i], status::OK);
+            std::pair<std::uint32_t*, std::size_t> out{};
+            ASSERT_EQ(status::OK, get<std::uint32_t>(st, keys[i], out));
+            ASSERT_EQ(*out.first, i);
+        }
+
+        // update the even keys and remove the odd keys.
+        batch.clear();
+        std::vector<std::uint32_t> new_values(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            new_values[i] = i + n;
+            if (i % 2 == 0) {
+                batch.push_back({batch_op::PUT, keys[i], &new_values[i]});
+            } else {
+                batch.push_back({batch_op::REMOVE, keys[i]});
+            }
+        }
+        std::string absent{make_key(n, prefix_len)};
+        batch.push_back({batch_op::REMOVE, absent});
+        ASSERT_EQ(status::OK, apply_batch(token, st, batch, rets));
+        ASSERT_EQ(rets.back(), status::OK_NOT_FOUND);
+        for (std::size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(rets[i], status::OK);
+            std::pair<std::uint32_t*, std::size_t> out{};
+            if (i % 2 == 0) {
+                ASSERT_EQ(status::OK, get<std::uint32_t>(st, keys[i], out));
+                ASSERT_EQ(*out.first, i + n);
+            } else {
+                ASSERT_EQ(status::WARN_NOT_EXIST,
+                          get<std::uint32_t>(st, keys[i], out));
+            }
+        }
+
+        // remove all, which removes the nodes.
+        batch.clear();
+        for (std::size_t i = 0; i < n; ++i) {
+            batch.push_back({batch_op::REMOVE, keys[i]});
+        }
+        ASSERT_EQ(status::OK, apply_batch(token, st, batch, rets));
+        for (std::size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(rets[i],
+                      i % 2 == 0 ? status::OK : status::OK_NOT_FOUND);
+        }
+        std::vector<std::tuple<std::string, std::uint32_t*, std::size_t>>
+                tuple_list{};
+        ASSERT_EQ(status::OK, scan<std::uint32_t>(st, "", scan_endpoint::INF,
+                                                  "", scan_endpoint::INF,
+                                                  tuple_list));
+        ASSERT_EQ(tuple_list.size(), 0);
+        ASSERT_EQ(leave(token), status::OK);
+    }
+}
+
+TEST_F(put_get_batch_test, random) { // NOLINT
+    // random keys of random lengths, which share key slices and make layers.
+    constexpr std::size_t n = 3000;
+    std::mt19937 engine{1};
+    std::vector<std::string> pool{};
+    for (std::size_t i = 0; i < 300; ++i) { // NOLINT
+        std::string key(engine() % 24, 'a'); // NOLINT
+        for (auto&& c : key) { c = static_cast<char>('a' + engine() % 3); }
+        pool.emplace_back(key);
+    }
+    std::vector<std::uint32_t> values(n * 2);
+    std::map<std::string, std::uint32_t> expected{};
+    Token token{};
+    ASSERT_EQ(enter(token), status::OK);
+    for (std::size_t round = 0; round < 2; ++round) {
+        std::vector<batch_entry<std::uint32_t>> batch{};
+        for (std::size_t i = 0; i < n; ++i) {
+            values[round * n + i] = round * n + i;
+            const std::string& key = pool[engine() % pool.size()];
+            if (engine() % 3 == 0) {
+                batch.push_back({batch_op::REMOVE, key});
+            } else {
+                batch.push_back({batch_op::PUT, key, &values[round * n + i]});
+            }
+        }
+        if (round == 1) {
+            // sorted. The order of the entries of the same key is kept.
+            std::stable_sort(batch.begin(), batch.end(),
+                             [](const auto& a, const auto& b) {
+                                 return a.key < b.key;
+                             });
+        }
+        std::vector<status> expected_rets{};
+        for (auto&& entry : batch) {
+            std::string key{entry.key};
+            if (entry.op == batch_op::REMOVE) {
+                expected_rets.emplace_back(expected.erase(key) == 1
+                                                   ? status::OK
+                                                   : status::OK_NOT_FOUND);
+            } else {
+                expected[key] = *entry.value_ptr;
+                expected_rets.emplace_back(status::OK);
+            }
+        }
+        std::vector<status> rets{};
+        ASSERT_EQ(status::OK, apply_batch(token, st, batch, rets));
+        ASSERT_EQ(rets, expected_rets);
+        for (auto&& key : pool) {
+            std::pair<std::uint32_t*, std::size_t> out{};
+            auto it = expected.find(key);
+            if (it == expected.end()) {
+                ASSERT_EQ(status::WARN_NOT_EXIST,
+                          get<std::uint32_t>(st, key, out));
+            } else {
+                ASSERT_EQ(status::OK, get<std::uint32_t>(st, key, out));
+                ASSERT_EQ(*out.first, it->second);
+            }
+        }
+    }
+    ASSERT_EQ(leave(token), status::OK);
+}
+
+TEST_F(put_get_batch_test, concurrent) { // NOLINT
+    constexpr std::size_t th_num = 4;
+    constexpr std::size_t n = 5000;
+    constexpr std::size_t batch_size = 100;
+    auto work = [this](std::size_t th_id) {
+        Token token{};
+        while (enter(token) != status::OK) { _mm_pause(); }
+        std::vector<std::string> keys{};
+        std::vector<std::uint32_t> values{};
+        for (std::size_t i = th_id; i < n; i += th_num) {
+            keys.emplace_back(make_key(i));
+            values.emplace_back(i);
+        }
+        std::vector<status> rets{};
+        for (std::size_t round = 0; round < 3; ++round) {
+            for (auto op : {batch_op::PUT, batch_op::REMOVE}) {
+                for (std::size_t b = 0; b < keys.size(); b += batch_size) {
+                    std::vector<batch_entry<std::uint32_t>> batch{};
+                    for (std::size_t i = b;
+                         i < std::min(b + batch_size, keys.size()); ++i) {
+                        batch.push_back({op, keys[i], &values[i]});
+                    }
+                    ASSERT_EQ(status::OK, apply_batch(token, st, batch, rets));
+                    for (auto ret : rets) { ASSERT_EQ(ret, status::OK); }
+                    for (std::size_t i = b;
+                         i < std::min(b + batch_size, keys.size()); ++i) {
+                        std::pair<std::uint32_t*, std::size_t> out{};
+                        ASSERT_EQ(get<std::uint32_t>(st, keys[i], out),
+                                  op == batch_op::PUT ? status::OK
+                                                      : status::WARN_NOT_EXIST);
+                    }
+                }
+            }
+        }
+        ASSERT_EQ(leave(token), status::OK);
+    };
+    std::vector<std::thread> threads{};
+    for (std::size_t i = 0; i < th_num; ++i) { threads.emplace_back(work, i); }
+    for (auto&& th : threads) { th.join(); }
+    for (std::size_t i = 0; i < n; ++i) {
+        std::pair<std::uint32_t*, std::size_t> out{};
+        ASSERT_EQ(status::WARN_NOT_EXIST, get<std::uint32_t>(st, make_key(i), out));
+    }
+}
+
+} // namespace yakushima::testing
@@ -0,0 +1,204 @@
+/**
+ * @file put_get_bulk_load_test.cpp
+ * @brief test about bulk_load.
+ */
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "kvs.h"
+#include "test_key.h"
+
+using namespace yakushima;
+
+namespace yakushima::testing {
+
+class put_get_bulk_load_test : public ::testing::Test {
+protected:
+    void SetUp() override {
+        init();
+        create_storage(st);
+        ASSERT_EQ(enter(token), status::OK);
+    }
+
+    void TearDown() override {
+        ASSERT_EQ(leave(token), status::OK);
+        fin();
+    }
+
+    /**
+     * @brief It checks that the storage has exactly @a keys, whose values are their
+     * positions.
+     */
+    void verify(const std::vector<std::string>& keys) {
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            std::pair<std::uint32_t*, std::size_t> out{};
+            ASSERT_EQ(status::OK, get<std::uint32_t>(st, keys[i], out));
+            ASSERT_EQ(*out.first, i);
+        }
+        std::vector<std::tuple<std::string, std::uint32_t*, std::size_t>>
+                tuple_list{};
+        ASSERT_EQ(status::OK, scan<std::uint32_t>(st, "", scan_endpoint::INF, "",
+                                                  scan_endpoint::INF,
+                                                  tuple_list));
+        ASSERT_EQ(tuple_list.size(), keys.size());
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            ASSERT_EQ(std::get<0>(tuple_list[i]), keys[i]);
+        }
+    }
+
+    static std::vector<std::tuple<std::string_view, std::uint32_t*, std::size_t>>
+    make_entries(const std::vector<std::string>& keys,
+                 std::vector<std::uint32_t>& values) {
+        values.resize(keys.size());
+        std::vector<std::tuple<std::string_view, std::uint32_t*, std::size_t>>
+                entries{};
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            values[i] = static_cast<std::uint32_t>(i);
+            entries.emplace_back(keys[i], &values[i], sizeof(std::uint32_t));
+        }
+        return entries;
+    }
+
+    std::string st{"s"}; // NOLINT
+    Token token{};       // NOLINT
+};
+
+TEST_F(put_get_bulk_load_test, sequential) { // NOLINT
+    constexpr std::size_t n = 5000;
+    for (std::size_t prefix_len : {0, 3, 8, 20}) {  // NOLINT
+        for (double fill_factor : {1.0, 0.5, 0.01}) { // NOLINT
+            ASSERT_EQ(status::OK, delete_storage(st));
+            ASSERT_EQ(status::OK, create_storage(st));
+            std::vector<std::string> keys{};
+            for (std::size_t i = 0; i < n; ++i) {
+                keys.emplace_back(make_key(i * 2, prefix_len));
+            }
+            std::vector<std::uint32_t> values{};
+            ASSERT_EQ(status::OK, bulk_load(token, st, make_entries(keys, values),
+                                            fill_factor));
+            verify(keys);
+
+            // the tree takes the usual operations.
+            for (std::size_t i = 0; i < n; ++i) {
+                std::uint32_t v{0};
+                ASSERT_EQ(status::OK,
+                          put(token, st, make_key(i * 2 + 1, prefix_len), &v));
+                ASSERT_EQ(status::OK, remove(token, st, keys[i]));
+            }
+            for (std::size_t i = 0; i < n; ++i) {
+                std::pair<std::uint32_t*, std::size_t> out{};
+                ASSERT_EQ(status::WARN_NOT_EXIST,
+                          get<std::uint32_t>(st, keys[i], out));
+                ASSERT_EQ(status::OK,
+                          get<std::uint32_t>(st, make_key(i * 2 + 1, prefix_len),
+                                             out));
+            }
+        }
+    }
+}
+
+TEST_F(put_get_bulk_load_test, layers) { // NOLINT
+    // keys of random lengths, which share key slices and make layers.
+    std::mt19937 engine{1};
+    std::set<std::string> key_set{};
+    for (std::size_t i = 0; i < 20000; ++i) { // NOLINT
+        std::string key(engine() % 30, 'a'); // NOLINT
+        for (auto&& c : key) { c = static_cast<char>('a' + engine() % 3); }
+        key_set.insert(key);
+    }
+    std::vector<std::string> keys{key_set.begin(), key_set.end()};
+    std::vector<std::uint32_t> values{};
+    ASSERT_EQ(status::OK, bulk_load(token, st, make_entries(keys, values)));
+    verify(keys);
+    // a key which shares the key slice and the key suffix with the loaded keys.
+    std::uint32_t v{0};
+    for (auto&& key : keys) {
+        ASSERT_EQ(status::OK, put(token, st, key + "z", &v));
+    }
+    for (auto&& key : keys) {
+        std::pair<std::uint32_t*, std::size_t> out{};
+        ASSERT_EQ(status::OK, get<std::uint32_t>(st, key + "z", out));
+        ASSERT_EQ(status::OK, remove(token, st, key));
+    }
+}
+
+TEST_F(put_get_bulk_load_test, parallel) { // NOLINT
+    constexpr std::size_t n = 200000;
+    std::vector<std::string> keys{};
+    for (std::size_t i = 0; i < n; ++i) {
+        // every 10 keys share the first key slice.
+        keys.emplace_back(make_key(i / 10) + make_key(i % 10));
+    }
+    std::vector<std::uint32_t> values{};
+    storage_handle handle{};
+    ASSERT_EQ(status::OK, find_storage(st, handle));
+    ASSERT_EQ(status::OK,
+              bulk_load(token, handle, make_entries(keys, values), 0.8, 4));
+    handle.reset();
+    verify(keys);
+}
+
+TEST_F(put_get_bulk_load_test, parallel_without_free_sessions) { // NOLINT
+    // the other threads of parallelism don't wait for the sessions held here.
+    std::vector<Token> held{};
+    for (;;) {
+        Token t{};
+        if (enter(t) != status::OK) { break; }
+        held.emplace_back(t);
+    }
+    constexpr std::size_t n = 10000;
+    std::vector<std::string> keys{};
+    for (std::size_t i = 0; i < n; ++i) { keys.emplace_back(make_key(i)); }
+    std::vector<std::uint32_t> values{};
+    ASSERT_EQ(status::OK, bulk_load(token, st, make_entries(keys, values), 1.0, 4));
+    for (auto&& t : held) { ASSERT_EQ(status::OK, leave(t)); }
+    verify(keys);
+}
+
+TEST_F(put_get_bulk_load_test, bad_usage) { // NOLINT
+    std::vector<std::uint32_t> values{};
+    std::vector<std::string> unsorted{"b", "a"};
+    ASSERT_EQ(status::ERR_BAD_USAGE,
+              bulk_load(token, st, make_entries(unsorted, values)));
+    std::vector<std::string> duplicate{"a", "a"};
+    ASSERT_EQ(status::ERR_BAD_USAGE,
+              bulk_load(token, st, make_entries(duplicate, values)));
+    std::vector<std::string> keys{"a", "b"};
+    ASSERT_EQ(status::ERR_BAD_USAGE,
+              bulk_load(token, st, make_entries(keys, values), 0));
+    ASSERT_EQ(status::ERR_BAD_USAGE,
+              bulk_load(token, st, make_entries(keys, values), 1.0, 0));
+    ASSERT_EQ(status::WARN_STORAGE_NOT_EXIST,
+              bulk_load(token, "x", make_entries(keys, values)));
+    ASSERT_EQ(status::OK, bulk_load(token, st, make_entries(keys, values)));
+    // not empty
+    ASSERT_EQ(status::WARN_EXIST,
+              bulk_load(token, st, make_entries(keys, values)));
+    verify(keys);
+}
+
+TEST_F(put_get_bulk_load_test, value_align) { // NOLINT
+    constexpr std::size_t n = 1000;
+    constexpr std::size_t align = 64;
+    std::vector<std::string> keys{};
+    for (std::size_t i = 0; i < n; ++i) { keys.emplace_back(make_key(i)); }
+    std::vector<std::uint32_t> values{};
+    ASSERT_EQ(status::OK,
+              bulk_load(token, st, make_entries(keys, values), 1.0, 1,
+                        static_cast<value_align_type>(align)));
+    verify(keys);
+    for (auto&& key : keys) {
+        std::pair<std::uint32_t*, std::size_t> out{};
+        ASSERT_EQ(status::OK, get<std::uint32_t>(st, key, out));
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(out.first) % align, 0); // NOLINT
+    }
+}
+
+} // namespace yakushima::testing
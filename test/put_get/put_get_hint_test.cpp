@@ -0,0 +1,172 @@
+/**
+ * @file put_get_hint_test.cpp
+ * @brief test about the operations with a cursor hint.
+ */
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "kvs.h"
+#include "test_key.h"
+
+using namespace yakushima;
+
+namespace yakushima::testing {
+
+class put_get_hint_test : public ::testing::Test {
+protected:
+    void SetUp() override {
+        init();
+        create_storage(st);
+    }
+
+    void TearDown() override { fin(); }
+
+    std::string st{"s"}; // NOLINT
+};
+
+TEST_F(put_get_hint_test, sequential) { // NOLINT
+    constexpr std::size_t n = 2000;
+    for (std::size_t prefix_len : {0, 3, 8, 20}) { // NOLINT
+        Token token{};
+        ASSERT_EQ(enter(token), status::OK);
+        cursor_hint hint{};
+        for (std::size_t i = 0; i < n; ++i) {
+            auto v = static_cast<std::uint32_t>(i);
+            ASSERT_EQ(status::OK, put(token, hint, st, make_key(i, prefix_len), &v));
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            std::pair<std::uint32_t*, std::size_t> out{};
+            ASSERT_EQ(status::OK, get<std::uint32_t>(token, hint, st,
+                                                   make_key(i, prefix_len),
+                                                   out));
+            ASSERT_EQ(*out.first, i);
+        }
+        // a key which the hint doesn't cover.
+        std::pair<std::uint32_t*, std::size_t> out{};
+        ASSERT_EQ(status::WARN_NOT_EXIST,
+                  get<std::uint32_t>(token, hint, st, make_key(n, prefix_len),
+                                   out));
+        for (std::size_t i = 0; i < n; i += 2) {
+            ASSERT_EQ(status::OK,
+                      remove(token, hint, st, make_key(i, prefix_len)));
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            status ret = get<std::uint32_t>(token, hint, st,
+                                          make_key(i, prefix_len), out);
+            ASSERT_EQ(ret, i % 2 == 0 ? status::WARN_NOT_EXIST : status::OK);
+            // the plain get agrees.
+            ASSERT_EQ(ret, get<std::uint32_t>(st, make_key(i, prefix_len), out));
+        }
+        for (std::size_t i = 1; i < n; i += 2) {
+            ASSERT_EQ(status::OK,
+                      remove(token, hint, st, make_key(i, prefix_len)));
+        }
+        ASSERT_EQ(status::WARN_NOT_EXIST,
+                  get<std::uint32_t>(token, hint, st, make_key(1, prefix_len),
+                                   out));
+        ASSERT_EQ(leave(token), status::OK);
+    }
+}
+
+TEST_F(put_get_hint_test, validation) { // NOLINT
+    Token token{};
+    ASSERT_EQ(enter(token), status::OK);
+    tree_instance* ti{};
+    ASSERT_EQ(find_storage(st, &ti), status::OK);
+    cursor_hint hint{};
+    std::uint32_t v{1};
+    ASSERT_EQ(status::OK, put(token, hint, st, make_key(10), &v));
+    ASSERT_EQ(status::OK, put(token, hint, st, make_key(20), &v));
+    std::string_view rest{};
+    node_version64_body nv{};
+    // the only node is leftmost and rightmost, so it covers any key.
+    ASSERT_NE(hint.find_border(ti, make_key(0), rest, nv), nullptr);
+    std::string k30{make_key(30)};
+    ASSERT_NE(hint.find_border(ti, k30, rest, nv), nullptr);
+    ASSERT_EQ(rest, k30);
+    // another tree
+    ASSERT_EQ(hint.find_border(nullptr, make_key(10), rest, nv), nullptr);
+
+    // the hint can't be used after the session leaves and the epoch advances.
+    ASSERT_EQ(leave(token), status::OK);
+    Epoch e{epoch_management::get_epoch()};
+    while (e == epoch_management::get_epoch()) { _mm_pause(); }
+    ASSERT_EQ(enter(token), status::OK);
+    hint.attach(token);
+    ASSERT_EQ(hint.find_border(ti, make_key(10), rest, nv), nullptr);
+    std::pair<std::uint32_t*, std::size_t> out{};
+    ASSERT_EQ(status::OK, get<std::uint32_t>(token, hint, st, make_key(10), out));
+    ASSERT_NE(hint.find_border(ti, make_key(10), rest, nv), nullptr);
+
+    // a split makes the hint invalid.
+    for (std::size_t i = 21; i < 21 + key_slice_length; ++i) {
+        ASSERT_EQ(status::OK, put(token, st, make_key(i), &v));
+    }
+    ASSERT_EQ(hint.find_border(ti, make_key(10), rest, nv), nullptr);
+    ASSERT_EQ(status::OK, get<std::uint32_t>(token, hint, st, make_key(10), out));
+    // the left node after the split doesn't cover the last key.
+    ASSERT_NE(hint.find_border(ti, make_key(10), rest, nv), nullptr);
+    ASSERT_EQ(hint.find_border(ti, make_key(20 + key_slice_length), rest, nv),
+              nullptr);
+
+    // the hint is for the layer under the slice of the key 10.
+    ASSERT_EQ(status::OK, put(token, hint, st, make_key(10) + "a", &v));
+    /**
+     * The rest of the first key is the key suffix, the layer is created by the second
+     * key, and the next put reaches it.
+     */
+    ASSERT_EQ(status::OK, put(token, hint, st, make_key(10) + "c", &v));
+    ASSERT_EQ(status::OK, put(token, hint, st, make_key(10) + "d", &v));
+    std::string k10b{make_key(10) + "b"};
+    ASSERT_NE(hint.find_border(ti, k10b, rest, nv), nullptr);
+    ASSERT_EQ(rest, "b");
+    ASSERT_EQ(hint.find_border(ti, make_key(10), rest, nv), nullptr);
+    ASSERT_EQ(hint.find_border(ti, make_key(11) + "a", rest, nv), nullptr);
+    ASSERT_EQ(leave(token), status::OK);
+}
+
+TEST_F(put_get_hint_test, concurrent) { // NOLINT
+    constexpr std::size_t th_num = 4;
+    constexpr std::size_t n = 5000;
+    auto work = [this](std::size_t th_id) {
+        Token token{};
+        while (enter(token) != status::OK) { _mm_pause(); }
+        cursor_hint hint{};
+        std::vector<std::size_t> keys{};
+        for (std::size_t i = th_id; i < n; i += th_num) { keys.emplace_back(i); }
+        std::mt19937 engine{static_cast<std::mt19937::result_type>(th_id)};
+        for (std::size_t round = 0; round < 3; ++round) {
+            for (auto i : keys) {
+                auto v = static_cast<std::uint32_t>(i);
+                ASSERT_EQ(status::OK, put(token, hint, st, make_key(i), &v));
+            }
+            std::shuffle(keys.begin(), keys.end(), engine);
+            for (auto i : keys) {
+                std::pair<std::uint32_t*, std::size_t> out{};
+                ASSERT_EQ(status::OK,
+                          get<std::uint32_t>(token, hint, st, make_key(i), out));
+                ASSERT_EQ(*out.first, i);
+            }
+            std::sort(keys.begin(), keys.end());
+            for (auto i : keys) {
+                ASSERT_EQ(status::OK, remove(token, hint, st, make_key(i)));
+            }
+        }
+        ASSERT_EQ(leave(token), status::OK);
+    };
+    std::vector<std::thread> threads{};
+    for (std::size_t i = 0; i < th_num; ++i) { threads.emplace_back(work, i); }
+    for (auto&& th : threads) { th.join(); }
+    for (std::size_t i = 0; i < n; ++i) {
+        std::pair<std::uint32_t*, std::size_t> out{};
+        ASSERT_EQ(status::WARN_NOT_EXIST, get<std::uint32_t>(st, make_key(i), out));
+    }
+}
+
+} // namespace yakushima::testing
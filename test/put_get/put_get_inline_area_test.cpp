@@ -0,0 +1,200 @@
+/**
+ * @file put_get_inline_area_test.cpp
+ * @brief test about the values which are kept in the slots of border nodes. Build with
+ * YAKUSHIMA_INLINE_VALUE_SIZE to enable them; otherwise the same operations use the heap.
+ */
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "kvs.h"
+
+using namespace yakushima;
+
+namespace yakushima::testing {
+
+class put_get_inline_area_test : public ::testing::Test {
+protected:
+    void SetUp() override {
+        init();
+        create_storage(st);
+    }
+
+    void TearDown() override { fin(); }
+
+    std::string st{"s"}; // NOLINT
+};
+
+using pair_type = std::array<std::uint32_t, 4>;
+
+TEST_F(put_get_inline_area_test, fits_in_node) { // NOLINT
+    constexpr auto align8 = static_cast<value_align_type>(8);
+    ASSERT_EQ(value::fits_in_node(sizeof(pair_type), align8),
+              YAKUSHIMA_INLINE_VALUE_SIZE >= sizeof(pair_type));
+    ASSERT_FALSE(value::fits_in_node(YAKUSHIMA_INLINE_VALUE_SIZE + 1, align8));
+    // the body of a value in the slot is aligned to 8 bytes at most.
+    ASSERT_FALSE(value::fits_in_node(1, static_cast<value_align_type>(16)));
+}
+
+TEST_F(put_get_inline_area_test, split_and_layer) { // NOLINT
+    Token token{};
+    ASSERT_EQ(enter(token), status::OK);
+    // the keys share the key slice, so the values move to the next layers and the splits.
+    constexpr std::size_t n = 500;
+    auto key_of = [](std::size_t i) {
+        return "prefix__" + std::to_string(i * 7919 % n); // NOLINT
+    };
+    auto value_of = [](std::size_t i, std::uint32_t round) {
+        auto u = static_cast<std::uint32_t>(i);
+        return pair_type{u, u + 1, u + 2, round};
+    };
+    for (std::size_t i = 0; i < n; ++i) {
+        pair_type v = value_of(i, 0);
+        ASSERT_EQ(status::OK, put(token, st, key_of(i), &v));
+    }
+    // put on the existing keys writes the slots again.
+    for (std::size_t i = 0; i < n; i += 2) {
+        pair_type v = value_of(i, 1);
+        ASSERT_EQ(status::OK, put(token, st, key_of(i), &v));
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        std::pair<pair_type*, std::size_t> out{};
+        ASSERT_EQ(status::OK, get<pair_type>(st, key_of(i), out));
+        ASSERT_EQ(out.second, sizeof(pair_type));
+        ASSERT_EQ(*out.first, value_of(i, i % 2 == 0 ? 1 : 0));
+    }
+    std::vector<std::tuple<std::string, pair_type*, std::size_t>> tuple_list{};
+    ASSERT_EQ(status::OK, scan<pair_type>(st, "", scan_endpoint::INF, "",
+                                          scan_endpoint::INF, tuple_list));
+    ASSERT_EQ(tuple_list.size(), n);
+    for (std::size_t i = 0; i < n; i += 3) {
+        ASSERT_EQ(status::OK, remove(token, st, key_of(i)));
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        std::pair<pair_type*, std::size_t> out{};
+        if (i % 3 == 0) {
+            ASSERT_EQ(status::WARN_NOT_EXIST, get<pair_type>(st, key_of(i), out));
+            continue;
+        }
+        ASSERT_EQ(status::OK, get<pair_type>(st, key_of(i), out));
+        ASSERT_EQ(*out.first, value_of(i, i % 2 == 0 ? 1 : 0));
+    }
+    ASSERT_EQ(leave(token), status::OK);
+}
+
+TEST_F(put_get_inline_area_test, mixed_size) { // NOLINT
+    Token token{};
+    ASSERT_EQ(enter(token), status::OK);
+    // a value moves between the slot and the heap as its size changes.
+    std::array<char, 100> large{};
+    large.fill('l');
+    std::array<char, 8> small{};
+    small.fill('s');
+    for (std::size_t i = 0; i < 4; ++i) {
+        char* ptr = i % 2 == 0 ? large.data() : small.data();
+        std::size_t len = i % 2 == 0 ? large.size() : small.size();
+        ASSERT_EQ(status::OK, put(token, st, "k", ptr, len));
+        std::string copy{};
+        ASSERT_EQ(status::OK, get_copy<char>(st, "k", copy));
+        ASSERT_EQ(copy, std::string(ptr, len));
+    }
+    ASSERT_EQ(leave(token), status::OK);
+}
+
+TEST_F(put_get_inline_area_test, stable_address) { // NOLINT
+    Token token{};
+    ASSERT_EQ(enter(token), status::OK);
+    // the addresses which get and take returned keep the values until the session leaves.
+    pair_type v1{1, 1, 1, 1};
+    pair_type v2{2, 2, 2, 2};
+    ASSERT_EQ(status::OK, put(token, st, "a", &v1));
+    ASSERT_EQ(status::OK, put(token, st, "b", &v1));
+    std::pair<pair_type*, std::size_t> got{};
+    ASSERT_EQ(status::OK, get<pair_type>(st, "a", got));
+    std::pair<pair_type*, std::size_t> taken{};
+    ASSERT_EQ(status::OK, take<pair_type>(token, st, "b", taken));
+    // a put to the key, and an insert into the slot which the taken key left.
+    ASSERT_EQ(status::OK, put(token, st, "a", &v2));
+    ASSERT_EQ(status::OK, put(token, st, "c", &v2));
+    ASSERT_EQ(*got.first, v1);
+    ASSERT_EQ(*taken.first, v1);
+    // the splits move the values to other nodes.
+    std::vector<std::pair<pair_type*, std::size_t>> outs{};
+    for (std::uint32_t i = 0; i < 100; ++i) { // NOLINT
+        pair_type v{i, i, i, i};
+        ASSERT_EQ(status::OK, put(token, st, "k" + std::to_string(i), &v));
+        outs.emplace_back();
+        ASSERT_EQ(status::OK,
+                  get<pair_type>(st, "k" + std::to_string(i), outs.back()));
+    }
+    for (std::uint32_t i = 0; i < 100; ++i) { // NOLINT
+        ASSERT_EQ(status::OK, remove(token, st, "k" + std::to_string(i)));
+        pair_type v{i + 1, i + 1, i + 1, i + 1};
+        ASSERT_EQ(status::OK, put(token, st, "n" + std::to_string(i), &v));
+    }
+    for (std::uint32_t i = 0; i < 100; ++i) { // NOLINT
+        ASSERT_EQ(*outs.at(i).first, (pair_type{i, i, i, i}));
+    }
+    // a stale copy and a stale address don't match.
+    std::pair<pair_type*, std::size_t> expected{&v1, sizeof(v1)};
+    ASSERT_EQ(status::WARN_VALUE_MISMATCH,
+              compare_exchange(token, st, "a", expected, &v1));
+    ASSERT_EQ(status::OK, get<pair_type>(st, "a", got));
+    ASSERT_EQ(status::OK, put(token, st, "a", &v1));
+    expected = got;
+    ASSERT_EQ(status::WARN_VALUE_MISMATCH,
+              compare_exchange(token, st, "a", expected, &v2));
+    std::string copy{};
+    ASSERT_EQ(status::OK, get_copy<pair_type>(st, "a", copy));
+    ASSERT_EQ(memcmp(copy.data(), v1.data(), sizeof(pair_type)), 0);
+    ASSERT_EQ(leave(token), status::OK);
+}
+
+TEST_F(put_get_inline_area_test, concurrent_put_get_copy) { // NOLINT
+    constexpr std::size_t n = 5000;
+    constexpr std::size_t key_num = 64;
+    std::atomic<bool> stop{false};
+    auto writer = [this] {
+        Token token{};
+        ASSERT_EQ(enter(token), status::OK);
+        for (std::uint32_t i = 0; i < n; ++i) {
+            pair_type v{i, i, i, i};
+            // the new keys split the node of the existing keys.
+            ASSERT_EQ(status::OK,
+                      put(token, st, std::to_string(i % key_num), &v));
+            ASSERT_EQ(status::OK, put(token, st, "n" + std::to_string(i), &v));
+        }
+        ASSERT_EQ(leave(token), status::OK);
+    };
+    auto reader = [this, &stop] {
+        Token token{};
+        ASSERT_EQ(enter(token), status::OK);
+        std::string copy{};
+        std::size_t i{0};
+        while (!stop.load(std::memory_order_acquire)) {
+            if (get_copy<pair_type>(st, std::to_string(i++ % key_num), copy) !=
+                status::OK) {
+                continue;
+            }
+            pair_type v{};
+            ASSERT_EQ(copy.size(), sizeof(pair_type));
+            memcpy(v.data(), copy.data(), sizeof(pair_type));
+            for (auto e : v) { ASSERT_EQ(e, v[0]); }
+        }
+        ASSERT_EQ(leave(token), status::OK);
+    };
+    std::thread r1{reader};
+    std::thread w1{writer};
+    w1.join();
+    stop.store(true, std::memory_order_release);
+    r1.join();
+}
+
+} // namespace yakushima::testing
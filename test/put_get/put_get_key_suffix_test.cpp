@@ -0,0 +1,161 @@
+/**
+ * @file put_get_key_suffix_test.cpp
+ * @brief test about the keys which are longer than a key slice and are held with their
+ * key suffix.
+ */
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "kvs.h"
+
+using namespace yakushima;
+
+namespace yakushima::testing {
+
+class put_get_key_suffix_test : public ::testing::Test {
+protected:
+    void SetUp() override {
+        init();
+        create_storage(st);
+    }
+
+    void TearDown() override { fin(); }
+
+    /**
+     * @return The number of levels of the nodes, which is the number of layers while a
+     * layer has only one node.
+     */
+    std::size_t layers(std::string_view storage = "s") {
+        return mem_usage(storage).size();
+    }
+
+    std::string st{"s"}; // NOLINT
+};
+
+TEST_F(put_get_key_suffix_test, one_key) { // NOLINT
+    Token token{};
+    ASSERT_EQ(enter(token), status::OK);
+    std::string k{"12345678abcdefghij"};
+    std::uint32_t v{1};
+    ASSERT_EQ(status::OK, put(token, st, k, &v));
+    // the rest of the key is held as the key suffix without a next layer.
+    ASSERT_EQ(layers(), 1);
+    std::pair<std::uint32_t*, std::size_t> out{};
+    ASSERT_EQ(status::OK, get<std::uint32_t>(st, k, out));
+    ASSERT_EQ(*out.first, 1);
+    // keys which differ only in the key suffix or the length.
+    for (std::string_view o : {"12345678", "12345678abcdefgh", "12345678abcdefghi",
+                               "12345678abcdefghik", "12345678abcdefghijk"}) {
+        ASSERT_EQ(status::WARN_NOT_EXIST, get<std::uint32_t>(st, o, out));
+        ASSERT_EQ(status::OK_NOT_FOUND, remove(token, st, o));
+    }
+
+    // update
+    std::uint32_t v2{2};
+    ASSERT_EQ(status::OK, put(token, st, k, &v2));
+    ASSERT_EQ(status::WARN_UNIQUE_RESTRICTION,
+              put(token, st, k, &v, sizeof(v), static_cast<std::uint32_t**>(nullptr),
+                  static_cast<value_align_type>(alignof(std::uint32_t)), true));
+    ASSERT_EQ(status::OK, get<std::uint32_t>(st, k, out));
+    ASSERT_EQ(*out.first, 2);
+    ASSERT_EQ(layers(), 1);
+
+    ASSERT_EQ(status::OK, remove(token, st, k));
+    ASSERT_EQ(status::WARN_NOT_EXIST, get<std::uint32_t>(st, k, out));
+    ASSERT_EQ(leave(token), status::OK);
+}
+
+TEST_F(put_get_key_suffix_test, shared_slice) { // NOLINT
+    Token token{};
+    ASSERT_EQ(enter(token), status::OK);
+    std::vector<std::string> keys{"12345678abcdefghij", "12345678abcdefghik",
+                                  "12345678abcdefgh", "12345678a", "12345678"};
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        auto v = static_cast<std::uint32_t>(i);
+        ASSERT_EQ(status::OK, put(token, st, keys.at(i), &v));
+        if (i == 0) { ASSERT_EQ(layers(), 1); }
+        if (i == 1) {
+            // the two keys share two key slices.
+            ASSERT_EQ(layers(), 3);
+        }
+    }
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        std::pair<std::uint32_t*, std::size_t> out{};
+        ASSERT_EQ(status::OK, get<std::uint32_t>(st, keys.at(i), out));
+        ASSERT_EQ(*out.first, i);
+    }
+
+    // scan returns the full keys in order.
+    std::vector<std::tuple<std::string, std::uint32_t*, std::size_t>> tuple_list{};
+    ASSERT_EQ(status::OK, scan<std::uint32_t>(st, "", scan_endpoint::INF, "",
+                                              scan_endpoint::INF, tuple_list));
+    ASSERT_EQ(tuple_list.size(), keys.size());
+    std::vector<std::string> sorted{keys};
+    std::sort(sorted.begin(), sorted.end());
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        ASSERT_EQ(std::get<0>(tuple_list.at(i)), sorted.at(i));
+    }
+    // the end point is in the middle of the key suffixes.
+    ASSERT_EQ(status::OK,
+              scan<std::uint32_t>(st, "12345678a", scan_endpoint::EXCLUSIVE,
+                                  "12345678abcdefghija", scan_endpoint::EXCLUSIVE,
+                                  tuple_list));
+    ASSERT_EQ(tuple_list.size(), 2);
+    ASSERT_EQ(std::get<0>(tuple_list.at(0)), keys.at(2));
+    ASSERT_EQ(std::get<0>(tuple_list.at(1)), keys.at(0));
+
+    for (auto&& k : keys) { ASSERT_EQ(status::OK, remove(token, st, k)); }
+    for (auto&& k : keys) {
+        std::pair<std::uint32_t*, std::size_t> out{};
+        ASSERT_EQ(status::WARN_NOT_EXIST, get<std::uint32_t>(st, k, out));
+    }
+    ASSERT_EQ(leave(token), status::OK);
+}
+
+TEST_F(put_get_key_suffix_test, many_keys) { // NOLINT
+    Token token{};
+    ASSERT_EQ(enter(token), status::OK);
+    // the key slices are unique, so the keys don't make any layer.
+    constexpr std::size_t n = 1000;
+    auto make_slice = [](std::size_t i) {
+        std::string key(8, '\0');
+        for (std::size_t j = 0; j < 8; ++j) {
+            key[7 - j] = static_cast<char>((i >> (j * 8)) & 0xff); // NOLINT
+        }
+        return key;
+    };
+    auto make_key = [&make_slice](std::size_t i) {
+        return make_slice(i) + "-suffix-" + std::to_string(i);
+    };
+    std::string st_slice{"slice"};
+    ASSERT_EQ(status::OK, create_storage(st_slice));
+    for (std::size_t i = 0; i < n; ++i) {
+        auto v = static_cast<std::uint32_t>(i);
+        ASSERT_EQ(status::OK, put(token, st, make_key(i), &v));
+        ASSERT_EQ(status::OK, put(token, st_slice, make_slice(i), &v));
+    }
+    // the tree is as high as the tree of only the key slices.
+    ASSERT_EQ(layers(), layers(st_slice));
+    for (std::size_t i = 0; i < n; ++i) {
+        std::pair<std::uint32_t*, std::size_t> out{};
+        ASSERT_EQ(status::OK, get<std::uint32_t>(st, make_key(i), out));
+        ASSERT_EQ(*out.first, i);
+    }
+    std::vector<std::tuple<std::string, std::uint32_t*, std::size_t>> tuple_list{};
+    ASSERT_EQ(status::OK, scan<std::uint32_t>(st, "", scan_endpoint::INF, "",
+                                              scan_endpoint::INF, tuple_list));
+    ASSERT_EQ(tuple_list.size(), n);
+    for (std::size_t i = 0; i < n; ++i) {
+        ASSERT_EQ(std::get<0>(tuple_list.at(i)), make_key(i));
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        ASSERT_EQ(status::OK, remove(token, st, make_key(i)));
+    }
+    ASSERT_EQ(leave(token), status::OK);
+}
+
+} // namespace yakushima::testing
@@ -80,9 +80,9 @@ TEST_F(kt, one_key) { // NOLINT
     find_storage(test_storage_name, &ti);
     base_node* root = ti->load_root_ptr(); // this is border node.
     ASSERT_NE(root, nullptr);
-    key_slice_type lvalue_key_slice = root->get_key_slice_at(0);
-    ASSERT_EQ(memcmp(&lvalue_key_slice, k.data(), k.size()), 0);
-    ASSERT_EQ(root->get_key_length_at(0), k.size());
+    key_slice_type lvalue_key_slice = static_cast<border_node*>(root)->get_key_slice_at(0);
+    ASSERT_EQ(lvalue_key_slice, make_key_slice(k));
+    ASSERT_EQ(static_cast<border_node*>(root)->get_key_length_at(0), k.size());
     std::pair<char*, std::size_t> tuple{};
     ASSERT_EQ(status::OK, get<char>(test_storage_name, k, tuple));
     ASSERT_NE(std::get<0>(tuple), nullptr);
@@ -200,9 +200,9 @@ TEST_F(kt, one_key_long_value) { // NOLINT
                               v.data(), v.size()));
     base_node* root = ti->load_root_ptr(); // this is border node.
     ASSERT_NE(root, nullptr);
-    key_slice_type lvalue_key_slice = root->get_key_slice_at(0);
-    ASSERT_EQ(memcmp(&lvalue_key_slice, k.data(), k.size()), 0);
-    ASSERT_EQ(root->get_key_length_at(0), k.size());
+    key_slice_type lvalue_key_slice = static_cast<border_node*>(root)->get_key_slice_at(0);
+    ASSERT_EQ(lvalue_key_slice, make_key_slice(k));
+    ASSERT_EQ(static_cast<border_node*>(root)->get_key_length_at(0), k.size());
     std::pair<char*, std::size_t> tuple{};
     ASSERT_EQ(status::OK,
               get<char>(test_storage_name, std::string_view(k), tuple));
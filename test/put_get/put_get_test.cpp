@@ -47,7 +47,7 @@ TEST_F(kt, test3) { // NOLINT
                       v.at(i).data(), v.at(i).size(), (char**) nullptr,
                       (value_align_type) sizeof(char), true, &nvp));
         ASSERT_EQ(nvp->get_vinsert_delete(), i + 1);
-        auto* br = dynamic_cast<border_node*>(ti->load_root_ptr());
+        auto* br = static_cast<border_node*>(ti->load_root_ptr());
         /**
          * There are 9 key which has the same slice and the different length.
          * key length == 0, same_slice and length is 1, 2, ..., 8.
@@ -154,7 +154,7 @@ TEST_F(kt, test5) { // NOLINT
         v.at(i) = std::to_string(i);
         ASSERT_EQ(status::OK, put(token, test_storage_name, k.at(i),
                                   v.at(i).data(), v.at(i).size()));
-        auto* br = dynamic_cast<border_node*>(ti->load_root_ptr());
+        auto* br = static_cast<border_node*>(ti->load_root_ptr());
         if (i <= 8) {
             /**
              * There are 9 key which has the same slice and the different length.
@@ -183,9 +183,9 @@ TEST_F(kt, test5) { // NOLINT
     /**
      * check next layer is border.
      */
-    auto* br = dynamic_cast<border_node*>(ti->load_root_ptr());
+    auto* br = static_cast<border_node*>(ti->load_root_ptr());
     auto* n = br->get_lv_at(9)->get_next_layer();
-    ASSERT_EQ(typeid(*n), typeid(border_node)); // NOLINT
+    ASSERT_TRUE(n->get_version_border());
     ASSERT_EQ(destroy(), status::OK_DESTROY_ALL);
     ASSERT_EQ(leave(token), status::OK);
 }
@@ -262,12 +262,12 @@ TEST_F(kt, test7) { // NOLINT
         ASSERT_EQ(status::OK, put(token, test_storage_name, k.at(i),
                                   v.at(i).data(), v.at(i).size()));
     }
-    auto* in = dynamic_cast<interior_node*>(ti->load_root_ptr());
+    auto* in = static_cast<interior_node*>(ti->load_root_ptr());
     auto* n = ti->load_root_ptr();
-    ASSERT_EQ(typeid(*n), typeid(interior_node)); // NOLINT
-    auto* bn = dynamic_cast<border_node*>(in->get_child_at(0));
+    ASSERT_FALSE(n->get_version_border());
+    auto* bn = static_cast<border_node*>(in->get_child_at(0));
     ASSERT_EQ(bn->get_permutation_cnk(), 8);
-    bn = dynamic_cast<border_node*>(in->get_child_at(1));
+    bn = static_cast<border_node*>(in->get_child_at(1));
     ASSERT_EQ(bn->get_permutation_cnk(), 8);
 
     ASSERT_EQ(destroy(), status::OK_DESTROY_ALL);
@@ -298,7 +298,7 @@ TEST_F(kt, test8) { // NOLINT
                           std::get<1>(kv[i]).size()));
         }
         auto* n = ti->load_root_ptr();
-        ASSERT_EQ(typeid(*n), typeid(interior_node)); // NOLINT
+        ASSERT_FALSE(n->get_version_border());
         ASSERT_EQ(destroy(), status::OK_DESTROY_ALL);
         ASSERT_EQ(leave(token), status::OK);
         destroy();
@@ -333,20 +333,20 @@ TEST_F(kt, test9) { // NOLINT
              * root is full-border.
              */
             auto* n = ti->load_root_ptr();
-            ASSERT_EQ(typeid(*n), typeid(border_node)); // NOLINT
+            ASSERT_TRUE(n->get_version_border());
         } else if (i == key_slice_length) {
             /**
              * split and insert.
              */
             auto* n = ti->load_root_ptr();
-            ASSERT_EQ(typeid(*n), typeid(interior_node)); // NOLINT
-            ASSERT_EQ(dynamic_cast<border_node*>(
-                              dynamic_cast<interior_node*>(ti->load_root_ptr())
+            ASSERT_FALSE(n->get_version_border());
+            ASSERT_EQ(static_cast<border_node*>(
+                              static_cast<interior_node*>(ti->load_root_ptr())
                                       ->get_child_at(0))
                               ->get_permutation_cnk(),
                       8);
-            ASSERT_EQ(dynamic_cast<border_node*>(
-                              dynamic_cast<interior_node*>(ti->load_root_ptr())
+            ASSERT_EQ(static_cast<border_node*>(
+                              static_cast<interior_node*>(ti->load_root_ptr())
                                       ->get_child_at(1))
                               ->get_permutation_cnk(),
                       8);
@@ -355,16 +355,16 @@ TEST_F(kt, test9) { // NOLINT
              * root is interior, root has 2 children, child[0] of root has 8 keys and child[1]
              * of root has 15 keys.
              */
-            ASSERT_EQ(dynamic_cast<interior_node*>(ti->load_root_ptr())
+            ASSERT_EQ(static_cast<interior_node*>(ti->load_root_ptr())
                               ->get_n_keys(),
                       1);
-            ASSERT_EQ(dynamic_cast<border_node*>(
-                              dynamic_cast<interior_node*>(ti->load_root_ptr())
+            ASSERT_EQ(static_cast<border_node*>(
+                              static_cast<interior_node*>(ti->load_root_ptr())
                                       ->get_child_at(0))
                               ->get_permutation_cnk(),
                       8);
-            ASSERT_EQ(dynamic_cast<border_node*>(
-                              dynamic_cast<interior_node*>(ti->load_root_ptr())
+            ASSERT_EQ(static_cast<border_node*>(
+                              static_cast<interior_node*>(ti->load_root_ptr())
                                       ->get_child_at(1))
                               ->get_permutation_cnk(),
                       15);
@@ -372,18 +372,18 @@ TEST_F(kt, test9) { // NOLINT
             /**
              * root is interior, root has 3 children, child[0-2] of root has 8 keys.
              */
-            ASSERT_EQ(dynamic_cast<border_node*>(
-                              dynamic_cast<interior_node*>(ti->load_root_ptr())
+            ASSERT_EQ(static_cast<border_node*>(
+                              static_cast<interior_node*>(ti->load_root_ptr())
                                       ->get_child_at(0))
                               ->get_permutation_cnk(),
                       8);
-            ASSERT_EQ(dynamic_cast<border_node*>(
-                              dynamic_cast<interior_node*>(ti->load_root_ptr())
+            ASSERT_EQ(static_cast<border_node*>(
+                              static_cast<interior_node*>(ti->load_root_ptr())
                                       ->get_child_at(1))
                               ->get_permutation_cnk(),
                       8);
-            ASSERT_EQ(dynamic_cast<border_node*>(
-                              dynamic_cast<interior_node*>(ti->load_root_ptr())
+            ASSERT_EQ(static_cast<border_node*>(
+                              static_cast<interior_node*>(ti->load_root_ptr())
                                       ->get_child_at(2))
                               ->get_permutation_cnk(),
                       8);
@@ -395,35 +395,35 @@ TEST_F(kt, test9) { // NOLINT
              * When it puts (key_slice_length / 2) keys, the root interior node has
              * (i-base_node::key_slice _length) / (key_slice_length / 2);
              */
-            ASSERT_EQ(dynamic_cast<interior_node*>(ti->load_root_ptr())
+            ASSERT_EQ(static_cast<interior_node*>(ti->load_root_ptr())
                               ->get_n_keys(),
                       (i - key_slice_length) / (key_slice_length / 2 + 1) + 1);
 
         } else if (i == key_slice_length + ((key_slice_length / 2 + 1)) *
                                                    (key_slice_length - 1)) {
-            ASSERT_EQ(dynamic_cast<interior_node*>(ti->load_root_ptr())
+            ASSERT_EQ(static_cast<interior_node*>(ti->load_root_ptr())
                               ->get_n_keys(),
                       key_slice_length);
         }
     }
 
-    auto* in = dynamic_cast<interior_node*>(ti->load_root_ptr());
+    auto* in = static_cast<interior_node*>(ti->load_root_ptr());
     /**
      * root is interior.
      */
     ASSERT_EQ(in->get_version_border(), false);
-    auto* child_of_root = dynamic_cast<interior_node*>(in->get_child_at(0));
+    auto* child_of_root = static_cast<interior_node*>(in->get_child_at(0));
     /**
      * child of root[0] is interior.
      */
     ASSERT_EQ(child_of_root->get_version_border(), false);
-    child_of_root = dynamic_cast<interior_node*>(in->get_child_at(1));
+    child_of_root = static_cast<interior_node*>(in->get_child_at(1));
     /**
      * child of root[1] is interior.
      */
     ASSERT_EQ(child_of_root->get_version_border(), false);
     auto* child_child_of_root =
-            dynamic_cast<border_node*>(child_of_root->get_child_at(0));
+            static_cast<border_node*>(child_of_root->get_child_at(0));
     /**
      * child of child of root[0] is border.
      */
@@ -461,7 +461,7 @@ TEST_F(kt, test10) { // NOLINT
                             interior_node::child_length) { // about minimum
                 base_node* bn = ti->load_root_ptr();
                 if (!bn->get_version_border()) {
-                    auto* in = dynamic_cast<interior_node*>(bn);
+                    auto* in = static_cast<interior_node*>(bn);
                     if (in->get_n_keys() == 2) {
                         base_node* child = in->get_child_at(0);
                         if (!child->get_version_border()) {
@@ -0,0 +1,323 @@
+/**
+ * @file put_get_update_test.cpp
+ * @brief test about update, upsert, compare_exchange and overwrite.
+ */
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "kvs.h"
+
+using namespace yakushima;
+
+namespace yakushima::testing {
+
+class put_get_update_test : public ::testing::Test {
+protected:
+    void SetUp() override {
+        init();
+        create_storage(st);
+    }
+
+    void TearDown() override { fin(); }
+
+    std::string st{"s"}; // NOLINT
+};
+
+TEST_F(put_get_update_test, update) { // NOLINT
+    Token token{};
+    ASSERT_EQ(enter(token), status::OK);
+    auto increment = [](std::uint32_t* v, std::size_t len) {
+        ASSERT_EQ(len, sizeof(std::uint32_t));
+        ++*v;
+    };
+    ASSERT_EQ(status::WARN_NOT_EXIST,
+              update<std::uint32_t>(token, st, "a", increment));
+    // short, long and layered keys.
+    std::vector<std::string> keys{"a", "abcdefgh", "abcdefghi",
+                                  "abcdefghijklmnopqrstu", "abcdefghz"};
+    std::uint32_t v{0};
+    for (auto&& key : keys) { ASSERT_EQ(status::OK, put(token, st, key, &v)); }
+    for (std::size_t i = 0; i < 3; ++i) {
+        for (auto&& key : keys) {
+            ASSERT_EQ(status::OK, update<std::uint32_t>(token, st, key, increment));
+        }
+    }
+    for (auto&& key : keys) {
+        std::pair<std::uint32_t*, std::size_t> out{};
+        ASSERT_EQ(status::OK, get<std::uint32_t>(st, key, out));
+        ASSERT_EQ(*out.first, 3);
+    }
+    // the key suffix is different.
+    ASSERT_EQ(status::WARN_NOT_EXIST,
+              update<std::uint32_t>(token, st, "abcdefghijklmnopqrstx", increment));
+    ASSERT_EQ(status::WARN_STORAGE_NOT_EXIST,
+              update<std::uint32_t>(token, "x", "a", increment));
+    ASSERT_EQ(leave(token), status::OK);
+}
+
+TEST_F(put_get_update_test, inline_value) { // NOLINT
+    Token token{};
+    ASSERT_EQ(enter(token), status::OK);
+    std::uint64_t v{1};
+    ASSERT_EQ(status::OK, put(token, st, "a", &v));
+    ASSERT_EQ(status::OK,
+              update<std::uint64_t>(token, st, "a",
+                                    [](std::uint64_t* body, std::size_t) {
+                                        *body += 10; // NOLINT
+                                    }));
+    std::pair<std::uint64_t*, std::size_t> out{};
+    ASSERT_EQ(status::OK, get<std::uint64_t>(st, "a", out));
+    // an inline value is got as the pointer itself.
+    ASSERT_EQ(reinterpret_cast<std::uint64_t>(out.first), 11); // NOLINT
+    ASSERT_EQ(leave(token), status::OK);
+}
+
+TEST_F(put_get_update_test, upsert) { // NOLINT
+    Token token{};
+    ASSERT_EQ(enter(token), status::OK);
+    using value_type = std::array<std::uint32_t, 4>;
+    value_type init{1, 2, 3, 4};
+    auto add_ten = [](value_type* body, std::size_t) {
+        for (auto&& e : *body) { e += 10; } // NOLINT
+    };
+    ASSERT_EQ(status::OK, upsert(token, st, "k", add_ten, &init));
+    std::pair<value_type*, std::size_t> out{};
+    ASSERT_EQ(status::OK, get<value_type>(st, "k", out));
+    ASSERT_EQ(*out.first, init);
+    ASSERT_EQ(status::OK, upsert(token, st, "k", add_ten, &init));
+    ASSERT_EQ(status::OK, get<value_type>(st, "k", out));
+    ASSERT_EQ((*out.first)[0], 11);
+    ASSERT_EQ((*out.first)[3], 14);
+    ASSERT_EQ(leave(token), status::OK);
+}
+
+TEST_F(put_get_update_test, concurrent_counter) { // NOLINT
+    constexpr std::size_t th_num = 4;
+    constexpr std::size_t key_num = 10;
+    constexpr std::size_t n = 10000;
+    storage_handle handle{};
+    {
+        Token token{};
+        ASSERT_EQ(enter(token), status::OK);
+        ASSERT_EQ(status::OK, find_storage(st, handle));
+        ASSERT_EQ(leave(token), status::OK);
+    }
+    auto work = [&handle](std::size_t th_id) {
+        Token token{};
+        while (enter(token) != status::OK) { _mm_pause(); }
+        std::uint32_t one{1};
+        for (std::size_t i = 0; i < n; ++i) {
+            std::string key{std::to_string((i + th_id) % key_num)};
+            ASSERT_EQ(status::OK,
+                      upsert(token, handle, key,
+                             [](std::uint32_t* v, std::size_t) { ++*v; }, &one));
+        }
+        ASSERT_EQ(leave(token), status::OK);
+    };
+    std::vector<std::thread> threads{};
+    for (std::size_t i = 0; i < th_num; ++i) { threads.emplace_back(work, i); }
+    for (auto&& th : threads) { th.join(); }
+    std::size_t sum{0};
+    for (std::size_t i = 0; i < key_num; ++i) {
+        std::pair<std::uint32_t*, std::size_t> out{};
+        ASSERT_EQ(status::OK, get<std::uint32_t>(st, std::to_string(i), out));
+        ASSERT_EQ(*out.first, th_num * n / key_num);
+        sum += *out.first;
+    }
+    ASSERT_EQ(sum, th_num * n);
+    handle.reset();
+}
+
+TEST_F(put_get_update_test, compare_exchange) { // NOLINT
+    Token token{};
+    ASSERT_EQ(enter(token), status::OK);
+    std::uint32_t v1{1};
+    std::uint32_t v2{2};
+    std::uint32_t v3{3};
+    std::pair<std::uint32_t*, std::size_t> expected{&v1, sizeof(v1)};
+    ASSERT_EQ(status::WARN_NOT_EXIST,
+              compare_exchange(token, st, "k", expected, &v2));
+    ASSERT_EQ(expected.first, nullptr);
+    ASSERT_EQ(status::OK, put(token, st, "k", &v1));
+    // match by the bytes.
+    expected = {&v1, sizeof(v1)};
+    ASSERT_EQ(status::OK, compare_exchange(token, st, "k", expected, &v2));
+    // mismatch, which returns the current value.
+    expected = {&v1, sizeof(v1)};
+    ASSERT_EQ(status::WARN_VALUE_MISMATCH,
+              compare_exchange(token, st, "k", expected, &v3));
+    ASSERT_EQ(*expected.first, 2);
+    ASSERT_EQ(expected.second, sizeof(std::uint32_t));
+    // the address which get returned doesn't match, since it is not a copy.
+    std::pair<std::uint32_t*, std::size_t> out{};
+    ASSERT_EQ(status::OK, get<std::uint32_t>(st, "k", out));
+    ASSERT_EQ(status::WARN_VALUE_MISMATCH,
+              compare_exchange(token, st, "k", out, &v3));
+    std::uint32_t copy{*out.first};
+    expected = {&copy, sizeof(copy)};
+    ASSERT_EQ(status::OK, compare_exchange(token, st, "k", expected, &v3));
+    ASSERT_EQ(status::OK, get<std::uint32_t>(st, "k", out));
+    ASSERT_EQ(*out.first, 3);
+    // a different length doesn't match.
+    expected = {&v3, sizeof(v3) - 1};
+    ASSERT_EQ(status::WARN_VALUE_MISMATCH,
+              compare_exchange(token, st, "k", expected, &v1));
+    ASSERT_EQ(leave(token), status::OK);
+}
+
+TEST_F(put_get_update_test, compare_exchange_after_update) { // NOLINT
+    Token token{};
+    ASSERT_EQ(enter(token), status::OK);
+    using value_type = std::array<std::uint64_t, 4>;
+    value_type v{};
+    ASSERT_EQ(status::OK, put(token, st, "k", &v));
+    std::pair<value_type*, std::size_t> old{};
+    ASSERT_EQ(status::OK, get<value_type>(st, "k", old));
+    value_type snapshot{*old.first};
+    auto increment = [](value_type* body, std::size_t) { ++(*body)[0]; };
+    ASSERT_EQ(status::OK, update<value_type>(token, st, "k", increment));
+    // the old address has the updated bytes, which must not match.
+    value_type desired{};
+    desired.fill(9);
+    std::pair<value_type*, std::size_t> expected{old};
+    ASSERT_EQ(status::WARN_VALUE_MISMATCH,
+              compare_exchange(token, st, "k", expected, &desired));
+    // neither does the snapshot before update.
+    expected = {&snapshot, sizeof(snapshot)};
+    ASSERT_EQ(status::WARN_VALUE_MISMATCH,
+              compare_exchange(token, st, "k", expected, &desired));
+    // overwrite also changes the body in place.
+    value_type v2{};
+    v2.fill(2);
+    ASSERT_EQ(status::OK, overwrite(token, st, "k", &v2));
+    expected = {old.first, old.second};
+    ASSERT_EQ(status::WARN_VALUE_MISMATCH,
+              compare_exchange(token, st, "k", expected, &desired));
+    expected = {&v2, sizeof(v2)};
+    ASSERT_EQ(status::OK, compare_exchange(token, st, "k", expected, &desired));
+    std::string copy{};
+    ASSERT_EQ(status::OK, get_copy<value_type>(st, "k", copy));
+    ASSERT_EQ(memcmp(copy.data(), desired.data(), sizeof(value_type)), 0);
+    ASSERT_EQ(leave(token), status::OK);
+}
+
+TEST_F(put_get_update_test, concurrent_compare_exchange) { // NOLINT
+    constexpr std::size_t th_num = 4;
+    constexpr std::size_t n = 5000;
+    {
+        Token token{};
+        ASSERT_EQ(enter(token), status::OK);
+        std::uint32_t zero{0};
+        ASSERT_EQ(status::OK, put(token, st, "k", &zero));
+        ASSERT_EQ(leave(token), status::OK);
+    }
+    auto work = [this]() {
+        Token token{};
+        while (enter(token) != status::OK) { _mm_pause(); }
+        std::pair<std::uint32_t*, std::size_t> expected{};
+        ASSERT_EQ(status::OK, get<std::uint32_t>(st, "k", expected));
+        std::uint32_t current{*expected.first};
+        for (std::size_t i = 0; i < n; ++i) {
+            for (;;) {
+                std::uint32_t desired{current + 1};
+                expected = {&current, sizeof(current)};
+                status ret = compare_exchange(token, st, "k", expected, &desired);
+                if (ret == status::OK) {
+                    current = desired;
+                    break;
+                }
+                ASSERT_EQ(ret, status::WARN_VALUE_MISMATCH);
+                current = *expected.first;
+            }
+        }
+        ASSERT_EQ(leave(token), status::OK);
+    };
+    std::vector<std::thread> threads{};
+    for (std::size_t i = 0; i < th_num; ++i) { threads.emplace_back(work); }
+    for (auto&& th : threads) { th.join(); }
+    std::pair<std::uint32_t*, std::size_t> out{};
+    ASSERT_EQ(status::OK, get<std::uint32_t>(st, "k", out));
+    ASSERT_EQ(*out.first, th_num * n);
+}
+
+TEST_F(put_get_update_test, overwrite) { // NOLINT
+    Token token{};
+    ASSERT_EQ(enter(token), status::OK);
+    using value_type = std::array<std::uint64_t, 8>;
+    value_type v1{};
+    v1.fill(1);
+    value_type v2{};
+    v2.fill(2);
+    // absent, so it puts.
+    ASSERT_EQ(status::OK, overwrite(token, st, "k", &v1));
+    std::pair<value_type*, std::size_t> before{};
+    ASSERT_EQ(status::OK, get<value_type>(st, "k", before));
+    // the same size, so the body is reused.
+    ASSERT_EQ(status::OK, overwrite(token, st, "k", &v2));
+    std::pair<value_type*, std::size_t> after{};
+    ASSERT_EQ(status::OK, get<value_type>(st, "k", after));
+    ASSERT_EQ(before.first, after.first);
+    ASSERT_EQ(*after.first, v2);
+    std::string copy{};
+    ASSERT_EQ(status::OK, get_copy<value_type>(st, "k", copy));
+    ASSERT_EQ(copy.size(), sizeof(value_type));
+    ASSERT_EQ(memcmp(copy.data(), v2.data(), sizeof(value_type)), 0);
+    // another size, so it makes a new value.
+    ASSERT_EQ(status::OK, overwrite(token, st, "k", &v1, sizeof(std::uint64_t)));
+    ASSERT_EQ(status::OK, get<value_type>(st, "k", after));
+    ASSERT_NE(before.first, after.first);
+    ASSERT_EQ(after.second, sizeof(std::uint64_t));
+    ASSERT_EQ(status::WARN_NOT_EXIST, get_copy<value_type>(st, "x", copy));
+    ASSERT_EQ(leave(token), status::OK);
+}
+
+TEST_F(put_get_update_test, concurrent_overwrite) { // NOLINT
+    using value_type = std::array<std::uint64_t, 8>;
+    constexpr std::size_t n = 20000;
+    {
+        Token token{};
+        ASSERT_EQ(enter(token), status::OK);
+        value_type v{};
+        ASSERT_EQ(status::OK, put(token, st, "k", &v));
+        ASSERT_EQ(leave(token), status::OK);
+    }
+    std::atomic<bool> stop{false};
+    auto writer = [this]() {
+        Token token{};
+        while (enter(token) != status::OK) { _mm_pause(); }
+        value_type v{};
+        for (std::size_t i = 0; i < n; ++i) {
+            v.fill(i);
+            ASSERT_EQ(status::OK, overwrite(token, st, "k", &v));
+        }
+        ASSERT_EQ(leave(token), status::OK);
+    };
+    auto reader = [this, &stop]() {
+        Token token{};
+        while (enter(token) != status::OK) { _mm_pause(); }
+        std::string copy{};
+        value_type v{};
+        while (!stop.load(std::memory_order_acquire)) {
+            ASSERT_EQ(status::OK, get_copy<value_type>(st, "k", copy));
+            memcpy(v.data(), copy.data(), sizeof(value_type));
+            for (auto e : v) { ASSERT_EQ(e, v[0]); }
+        }
+        ASSERT_EQ(leave(token), status::OK);
+    };
+    std::thread r1{reader};
+    std::thread r2{reader};
+    std::thread w1{writer};
+    w1.join();
+    stop.store(true, std::memory_order_release);
+    r1.join();
+    r2.join();
+}
+
+} // namespace yakushima::testing
@@ -2,7 +2,10 @@
  * @file storage_test.cpp
  */
 
+#include <atomic>
 #include <cstring>
+#include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -121,4 +124,131 @@ TEST_F(st, simple_operate_some_storage) { // NOLINT
     ASSERT_EQ(status::OK, leave(token));
 }
 
+TEST_F(st, storage_handle) { // NOLINT
+    std::string st1{"st1"};
+    std::string k{"k"};
+    std::string v{"v"};
+    storage_handle h1{};
+    ASSERT_FALSE(h1);
+    ASSERT_EQ(find_storage(st1, h1), status::WARN_NOT_EXIST);
+    ASSERT_EQ(status::OK, create_storage(st1));
+    ASSERT_EQ(find_storage(st1, h1), status::OK);
+    ASSERT_TRUE(h1);
+    tree_instance* ret_ti{};
+    ASSERT_EQ(find_storage(st1, &ret_ti), status::OK);
+    ASSERT_EQ(h1.get(), ret_ti);
+
+    Token token{};
+    ASSERT_EQ(enter(token), status::OK);
+    ASSERT_EQ(put(token, h1, k, v.data(), v.size()), status::OK);
+    std::pair<char*, std::size_t> out{};
+    // the operations with the name and with the handle see the same storage.
+    ASSERT_EQ(get<char>(st1, k, out), status::OK);
+    ASSERT_EQ(get<char>(h1, k, out), status::OK);
+    ASSERT_EQ(std::string(out.first, out.second), v);
+    cursor_hint hint{};
+    ASSERT_EQ(get<char>(token, hint, h1, k, out), status::OK);
+    std::vector<std::tuple<std::string, char*, std::size_t>> tuple_list;
+    ASSERT_EQ(status::OK, scan(h1, "", scan_endpoint::INF, "",
+                               scan_endpoint::INF, tuple_list));
+    ASSERT_EQ(tuple_list.size(), 1);
+    iscan_context* ctx{};
+    void* val{};
+    ASSERT_EQ(status::OK, iscan_open(h1, "", scan_endpoint::INF, "", scan_endpoint::INF,
+                                     false, false, ctx, val));
+    ASSERT_EQ(iscan_close(ctx), status::OK);
+    ASSERT_EQ(remove(token, hint, h1, k), status::OK);
+    ASSERT_EQ(remove(token, h1, k), status::OK_NOT_FOUND);
+
+    // a copy keeps the storage after the deletion, but it can't be operated.
+    storage_handle h2{h1};
+    h1.reset();
+    ASSERT_FALSE(h1);
+    ASSERT_EQ(delete_storage(st1), status::OK);
+    ASSERT_FALSE(h2);
+    ASSERT_EQ(put(token, h2, k, v.data(), v.size()), status::WARN_STORAGE_NOT_EXIST);
+    ASSERT_EQ(get<char>(h2, k, out), status::WARN_STORAGE_NOT_EXIST);
+    ASSERT_EQ(remove(token, h2, k), status::WARN_STORAGE_NOT_EXIST);
+    ASSERT_EQ(status::WARN_STORAGE_NOT_EXIST,
+              scan(h2, "", scan_endpoint::INF, "", scan_endpoint::INF, tuple_list));
+
+    // the storage created with the same name is another one.
+    ASSERT_EQ(status::OK, create_storage(st1));
+    ASSERT_EQ(put(token, st1, k, v.data(), v.size()), status::OK);
+    ASSERT_EQ(get<char>(h2, k, out), status::WARN_STORAGE_NOT_EXIST);
+    ASSERT_EQ(find_storage(st1, h2), status::OK);
+    ASSERT_EQ(get<char>(h2, k, out), status::OK);
+    ASSERT_EQ(status::OK, leave(token));
+}
+
+TEST_F(st, delete_storage_deferred) { // NOLINT
+    std::string st1{"st1"};
+    std::string k{"k"};
+    std::string v{"v"};
+    ASSERT_EQ(status::OK, create_storage(st1));
+    storage_handle h{};
+    ASSERT_EQ(find_storage(st1, h), status::OK);
+    Token token{};
+    ASSERT_EQ(enter(token), status::OK);
+    ASSERT_EQ(put(token, st1, k, v.data(), v.size()), status::OK);
+    tree_instance* ti{};
+    ASSERT_EQ(find_storage(st1, &ti), status::OK);
+    ASSERT_EQ(delete_storage(st1), status::OK);
+    ASSERT_EQ(find_storage(st1), status::WARN_NOT_EXIST);
+
+    // the session found the storage before the deletion, so the tree is still alive.
+    std::this_thread::sleep_for(std::chrono::milliseconds(YAKUSHIMA_EPOCH_TIME * 3));
+    ASSERT_NE(ti->load_root_ptr(), nullptr);
+    std::pair<char*, std::size_t> out{};
+    ASSERT_EQ(get<char>(ti, k, out), status::OK);
+    ASSERT_EQ(std::string(out.first, out.second), v);
+    ASSERT_EQ(status::OK, leave(token));
+
+    // the handle keeps the tree instance, and the gc thread destroys the tree.
+    while (ti->load_root_ptr() != nullptr) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(YAKUSHIMA_EPOCH_TIME));
+    }
+}
+
+TEST_F(st, delete_storage_with_dml) { // NOLINT
+    std::string st1{"st1"};
+    ASSERT_EQ(status::OK, create_storage(st1));
+    std::atomic<bool> quit{false};
+    auto work = [&st1, &quit](std::size_t th_id) {
+        Token token{};
+        while (enter(token) != status::OK) { _mm_pause(); }
+        storage_handle h{};
+        for (std::size_t i = 0; !quit.load(std::memory_order_acquire); ++i) {
+            std::string k{std::to_string(th_id) + "-" + std::to_string(i % 100)};
+            auto v = static_cast<std::uint32_t>(i);
+            if (i % 100 == 0) {
+                // the handle is renewed sometimes, and otherwise it is stale.
+                find_storage(st1, h);
+                leave(token);
+                while (enter(token) != status::OK) { _mm_pause(); }
+            }
+            status rc = i % 2 == 0 ? put(token, st1, k, &v) : put(token, h, k, &v);
+            ASSERT_TRUE(rc == status::OK || rc == status::WARN_STORAGE_NOT_EXIST);
+            std::pair<std::uint32_t*, std::size_t> out{};
+            rc = get<std::uint32_t>(h, k, out);
+            ASSERT_TRUE(rc == status::OK || rc == status::WARN_NOT_EXIST ||
+                        rc == status::WARN_STORAGE_NOT_EXIST);
+            rc = remove(token, st1, k);
+            ASSERT_TRUE(rc == status::OK || rc == status::OK_NOT_FOUND ||
+                        rc == status::WARN_STORAGE_NOT_EXIST);
+        }
+        h.reset();
+        ASSERT_EQ(leave(token), status::OK);
+    };
+    std::vector<std::thread> threads{};
+    for (std::size_t i = 0; i < 4; ++i) { threads.emplace_back(work, i); }
+    for (std::size_t i = 0; i < 200; ++i) {
+        ASSERT_EQ(delete_storage(st1), status::OK);
+        ASSERT_EQ(create_storage(st1), status::OK);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    quit.store(true, std::memory_order_release);
+    for (auto&& th : threads) { th.join(); }
+}
+
 } // namespace yakushima::testing
@@ -68,7 +68,7 @@ TEST_F(tsurugi_issue672_test, simple) { // NOLINT
     auto* nvp_first_border_node = n->get_version_ptr();
     ASSERT_EQ(nvp_for_put, nvp_first_border_node);
     auto* n_second_border_node =
-            dynamic_cast<border_node*>(n)->get_lv_at(0)->get_next_layer();
+            static_cast<border_node*>(n)->get_lv_at(0)->get_next_layer();
     ASSERT_NE(nvp_for_put, n_second_border_node->get_version_ptr());
 
     // cleanup
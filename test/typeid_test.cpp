@@ -3,6 +3,7 @@
  */
 
 #include <memory>
+#include <type_traits>
 
 #include "gtest/gtest.h"
 
@@ -16,27 +17,44 @@ namespace yakushima::testing {
 class tt : public ::testing::Test {};
 
 TEST_F(tt, test1) { // NOLINT
+    // nodes are told apart by the border bit of the version, not by rtti.
+    ASSERT_FALSE(std::is_polymorphic_v<base_node>);
+    ASSERT_FALSE(std::is_polymorphic_v<border_node>);
+    ASSERT_FALSE(std::is_polymorphic_v<interior_node>);
+
     std::unique_ptr<border_node> border_uptr =
             std::make_unique<border_node>(); // NOLINT
     std::unique_ptr<interior_node> interior_uptr =
             std::make_unique<interior_node>(); // NOLINT
+    border_uptr->init_border();
+    interior_uptr->init_interior();
+
+    base_node* base_nptr{}; // n ... normal
+    base_nptr = border_uptr.get();
+    ASSERT_TRUE(base_nptr->get_version_border());
+    ASSERT_EQ(static_cast<border_node*>(base_nptr), border_uptr.get());
+    base_nptr = interior_uptr.get();
+    ASSERT_FALSE(base_nptr->get_version_border());
+    ASSERT_EQ(static_cast<interior_node*>(base_nptr), interior_uptr.get());
+}
 
-    ASSERT_EQ(typeid(border_uptr.get()), typeid(border_node*));
-    ASSERT_EQ(typeid(interior_uptr.get()), typeid(interior_node*));
-
-    base_node* base_nptr{};                                      // n ... normal
-    base_nptr = reinterpret_cast<base_node*>(border_uptr.get()); // NOLINT
-    ASSERT_EQ(typeid(*base_nptr), typeid(border_node));
-    base_nptr = reinterpret_cast<base_node*>(interior_uptr.get()); // NOLINT
-    ASSERT_EQ(typeid(*base_nptr), typeid(interior_node));
-
-    // test real object
-    border_node border{};
-    interior_node interior{};
-    base_nptr = reinterpret_cast<base_node*>(&border); // NOLINT
-    ASSERT_EQ(typeid(*base_nptr), typeid(border_node));
-    base_nptr = reinterpret_cast<base_node*>(&interior); // NOLINT
-    ASSERT_EQ(typeid(*base_nptr), typeid(interior_node));
+TEST_F(tt, delete_node) { // NOLINT
+    // delete_node releases each node as its own class (checked by sanitizers).
+    base_node* n = new border_node(); // NOLINT
+    static_cast<border_node*>(n)->init_border();
+    ASSERT_EQ(n->destroy(), status::OK_DESTROY_BORDER);
+    base_node::delete_node(n);
+    auto* in = new interior_node(); // NOLINT
+    in->init_interior();
+    for (std::size_t i = 0; i < 2; ++i) {
+        auto* bn = new border_node(); // NOLINT
+        bn->init_border();
+        in->set_child_at(i, bn);
+    }
+    in->set_n_keys(1);
+    n = in;
+    ASSERT_EQ(n->destroy(), status::OK_DESTROY_INTERIOR);
+    base_node::delete_node(n);
 }
 
 } // namespace yakushima::testing
@@ -0,0 +1,104 @@
+/**
+ * @file value_pool_test.cpp
+ */
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "key_suffix.h"
+#include "value_pool.h"
+
+using namespace yakushima;
+
+namespace yakushima::testing {
+
+class value_pool_test : public ::testing::Test {};
+
+TEST_F(value_pool_test, is_pooled) { // NOLINT
+    ASSERT_TRUE(value_pool::is_pooled(1, static_cast<value_align_type>(8)));
+    ASSERT_TRUE(value_pool::is_pooled(YAKUSHIMA_VALUE_POOL_MAX_SIZE,
+                                      value_pool::kAlign));
+    ASSERT_FALSE(value_pool::is_pooled(YAKUSHIMA_VALUE_POOL_MAX_SIZE + 1,
+                                       value_pool::kAlign));
+    ASSERT_FALSE(value_pool::is_pooled(8, static_cast<value_align_type>(
+                                                  2 * alignof(std::max_align_t))));
+}
+
+TEST_F(value_pool_test, recycle) { // NOLINT
+    value_pool pool{};
+    constexpr auto align = static_cast<value_align_type>(8);
+    void* block = value_pool::allocate_block(40, align, &pool);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(block) % // NOLINT
+                      static_cast<std::size_t>(value_pool::kAlign),
+              0);
+    // the block of the same class is reused.
+    pool.recycle(block, 40, align);
+    ASSERT_EQ(value_pool::allocate_block(48, align, &pool), block);
+    // the block of another class is not.
+    pool.recycle(block, 48, align);
+    void* other = value_pool::allocate_block(49, align, &pool);
+    ASSERT_NE(other, block);
+    // a block from the heap is compatible with the pool.
+    void* heap_block = value_pool::allocate_block(33, align, nullptr);
+    pool.recycle(heap_block, 33, align);
+    value_pool::release_block(other, 49, align);
+    // a block which is not pooled is released.
+    void* large = value_pool::allocate_block(YAKUSHIMA_VALUE_POOL_MAX_SIZE + 1,
+                                             align, &pool);
+    pool.recycle(large, YAKUSHIMA_VALUE_POOL_MAX_SIZE + 1, align);
+    pool.fin();
+}
+
+TEST_F(value_pool_test, slab) { // NOLINT
+    // the blocks of a class which no other test uses are split from a slab in order.
+    value_pool pool{};
+    constexpr auto align = static_cast<value_align_type>(8);
+    constexpr std::size_t size = YAKUSHIMA_VALUE_POOL_MAX_SIZE;
+    auto* first = static_cast<std::byte*>(value_pool::allocate_block(size, align, &pool));
+    auto* second = static_cast<std::byte*>(value_pool::allocate_block(size, align, &pool));
+    ASSERT_EQ(second - first, size);
+    // the released blocks are reused by another pool.
+    value_pool::release_block(first, size, align);
+    value_pool::release_block(second, size, align);
+    value_pool other{};
+    ASSERT_EQ(value_pool::allocate_block(size, align, &other), second);
+    ASSERT_EQ(value_pool::allocate_block(size, align, &other), first);
+    pool.fin();
+    other.fin();
+}
+
+TEST_F(value_pool_test, key_suffix) { // NOLINT
+    value_pool pool{};
+    key_suffix* ks = key_suffix::create_key_suffix("suffix", &pool);
+    auto [ks_ptr, ks_len, ks_align] = key_suffix::get_gc_info(ks);
+    pool.recycle(ks_ptr, ks_len, ks_align);
+    // a key suffix of the same class takes the block from the pool.
+    ASSERT_EQ(key_suffix::create_key_suffix("suffiz", &pool), ks);
+    key_suffix::delete_key_suffix(ks);
+    pool.fin();
+}
+
+TEST_F(value_pool_test, concurrent_recycle) { // NOLINT
+    // the owner allocates while another thread returns blocks.
+    value_pool pool{};
+    constexpr auto align = static_cast<value_align_type>(8);
+    constexpr std::size_t n = 100000;
+    std::vector<void*> blocks{};
+    for (std::size_t i = 0; i < n; ++i) {
+        blocks.emplace_back(value_pool::allocate_block(64, align, nullptr));
+    }
+    std::thread gc{[&pool, &blocks]() {
+        for (auto* block : blocks) { pool.recycle(block, 64, align); }
+    }};
+    std::vector<void*> allocated{};
+    for (std::size_t i = 0; i < n; ++i) {
+        allocated.emplace_back(value_pool::allocate_block(64, align, &pool));
+    }
+    gc.join();
+    for (auto* block : allocated) { value_pool::release_block(block, 64, align); }
+    pool.fin();
+}
+
+} // namespace yakushima::testing
@@ -109,8 +109,8 @@ TEST_F(vt, vsplit) { // NOLINT
                   put(token, test_storage_name, key.at(i), v.data(), v.size()));
     }
     leave(token);
-    ASSERT_EQ(vid + 1, dynamic_cast<border_node*>(
-                               dynamic_cast<interior_node*>(ti->load_root_ptr())
+    ASSERT_EQ(vid + 1, static_cast<border_node*>(
+                               static_cast<interior_node*>(ti->load_root_ptr())
                                        ->get_child_at(0))
                                ->get_version_vsplit());
     fin();